@@ -0,0 +1,209 @@
+
+/*
+ * Description: Example checking cl_bitset_t operations against a plain array
+ *              of flags, mixing additions with set operations over
+ *              compressed and plain sets.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sun Oct 18 10:12:37 2026
+ * Project: examples
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "collections.h"
+
+/* Members spread over several chunks of a compressed set */
+#define UNIVERSE            (1U << 20)
+
+struct set {
+    cl_bitset_t     *bitset;
+    unsigned char   *flags;
+};
+
+static int create_set(struct set *s, unsigned int flags)
+{
+    s->bitset = cl_bitset_create(0, flags | CL_BITSET_GROWABLE, false);
+    s->flags = calloc(UNIVERSE, sizeof(unsigned char));
+
+    if ((NULL == s->bitset) || (NULL == s->flags))
+        return -1;
+
+    return 0;
+}
+
+static void destroy_set(struct set *s)
+{
+    cl_bitset_destroy(s->bitset);
+    free(s->flags);
+}
+
+/*
+ * Adds members clustered around a few places, so some chunks get shared
+ * by both sets and others exist only in one of them.
+ */
+static void add_members(struct set *s, unsigned int count)
+{
+    unsigned int i, bit, base = rand() % UNIVERSE;
+
+    for (i = 0; i < count; i++) {
+        bit = (base + rand() % (UNIVERSE / 4)) % UNIVERSE;
+        cl_bitset_set(s->bitset, bit);
+        s->flags[bit] = 1;
+    }
+}
+
+static void apply(struct set *s, const struct set *other, int op)
+{
+    unsigned int i;
+    unsigned char a, b;
+
+    switch (op) {
+        case 0:
+            cl_bitset_and(s->bitset, other->bitset);
+            break;
+
+        case 1:
+            cl_bitset_or(s->bitset, other->bitset);
+            break;
+
+        case 2:
+            cl_bitset_xor(s->bitset, other->bitset);
+            break;
+
+        default:
+            cl_bitset_andnot(s->bitset, other->bitset);
+            break;
+    }
+
+    for (i = 0; i < UNIVERSE; i++) {
+        a = s->flags[i];
+        b = other->flags[i];
+        s->flags[i] = (op == 0) ? (a & b) : (op == 1) ? (a | b)
+                                          : (op == 2) ? (a ^ b)
+                                                      : (a & !b);
+    }
+}
+
+static int check(const struct set *s)
+{
+    long long bit, count = 0;
+    unsigned int i;
+
+    bit = cl_bitset_next_set(s->bitset, 0);
+
+    for (i = 0; i < UNIVERSE; i++) {
+        if (s->flags[i] == 0)
+            continue;
+
+        if (bit != i)
+            return -1;
+
+        bit = cl_bitset_next_set(s->bitset, i + 1);
+        count++;
+    }
+
+    if ((bit != -1) || (cl_bitset_count(s->bitset) != count))
+        return -1;
+
+    return 0;
+}
+
+static void usage(void)
+{
+    fprintf(stdout, "Usage: bitset [OPTIONS]\n");
+    fprintf(stdout, "Options:\n\n");
+    fprintf(stdout, "  -r [number]\tNumber of rounds.\n");
+    fprintf(stdout, "  -s [number]\tSeed of the random numbers.\n");
+    fprintf(stdout, "\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *opt = "r:s:h\0";
+    const char *names[] = { "and", "or", "xor", "andnot" };
+    int option, op, k, ret = 0;
+    unsigned int i, rounds = 200, seed = 1;
+    struct set a, b;
+
+    do {
+        option = getopt(argc, argv, opt);
+
+        switch (option) {
+            case 'h':
+                usage();
+                return 1;
+
+            case 'r':
+                rounds = atoi(optarg);
+                break;
+
+            case 's':
+                seed = atoi(optarg);
+                break;
+
+            case '?':
+                return -1;
+        }
+    } while (option != -1);
+
+    cl_init(NULL);
+    srand(seed);
+
+    for (i = 0; (i < rounds) && (ret == 0); i++) {
+        if ((create_set(&a, CL_BITSET_COMPRESSED) < 0) ||
+            (create_set(&b, (i % 2) ? CL_BITSET_COMPRESSED : 0) < 0))
+        {
+            fprintf(stderr, "Could not create the sets\n");
+            return -1;
+        }
+
+        add_members(&a, rand() % 20000);
+        add_members(&b, rand() % 20000);
+
+        /* Operations followed by additions reuse the chunks left by them */
+        for (op = 0; (op < 4) && (ret == 0); op++) {
+            k = rand() % 4;
+            apply(&a, &b, k);
+            add_members(&a, rand() % 5000);
+
+            if (check(&a) < 0) {
+                fprintf(stderr, "Round %u: wrong members after %s\n", i,
+                        names[k]);
+
+                ret = -1;
+            }
+        }
+
+        destroy_set(&a);
+        destroy_set(&b);
+    }
+
+    if (ret == 0)
+        printf("%u rounds ok\n", rounds);
+
+    cl_uninit();
+
+    return ret;
+}
+
@@ -0,0 +1,247 @@
+
+/*
+ * Description: Benchmark showing how cl_chashtable_t lookups scale with the
+ *              number of threads, compared to a cl_hashtable_t guarded by a
+ *              mutex.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 14:02:51 2026
+ * Project: examples
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+
+#include <pthread.h>
+
+#include "collections.h"
+
+#define KEY_SIZE            32
+
+struct bench {
+    cl_chashtable_t     *ch;
+    cl_hashtable_t      *h;
+    pthread_mutex_t     lock;
+    char                **keys;
+    unsigned int        nkeys;
+    unsigned int        operations;
+    unsigned int        write_percent;
+};
+
+struct worker {
+    struct bench        *b;
+    unsigned int        seed;
+    pthread_t           thread;
+};
+
+static void *chashtable_worker(void *arg)
+{
+    struct worker *w = (struct worker *)arg;
+    struct bench *b = w->b;
+    unsigned int i, k;
+    void *data;
+
+    for (i = 0; i < b->operations; i++) {
+        k = rand_r(&w->seed) % b->nkeys;
+
+        if ((unsigned int)(rand_r(&w->seed) % 100) < b->write_percent) {
+            data = cl_chashtable_put(b->ch, b->keys[k], b->keys[k]);
+
+            if (data != NULL && data != b->keys[k])
+                fprintf(stderr, "Wrong value replaced\n");
+        } else {
+            data = cl_chashtable_get(b->ch, b->keys[k]);
+
+            if (data != b->keys[k])
+                fprintf(stderr, "Key '%s' not found\n", b->keys[k]);
+        }
+    }
+
+    return NULL;
+}
+
+static void *hashtable_worker(void *arg)
+{
+    struct worker *w = (struct worker *)arg;
+    struct bench *b = w->b;
+    unsigned int i, k;
+    void *data;
+
+    for (i = 0; i < b->operations; i++) {
+        k = rand_r(&w->seed) % b->nkeys;
+        pthread_mutex_lock(&b->lock);
+
+        if ((unsigned int)(rand_r(&w->seed) % 100) < b->write_percent)
+            cl_hashtable_put(b->h, b->keys[k], b->keys[k]);
+        else {
+            data = cl_hashtable_get(b->h, b->keys[k]);
+
+            if (data != b->keys[k])
+                fprintf(stderr, "Key '%s' not found\n", b->keys[k]);
+        }
+
+        pthread_mutex_unlock(&b->lock);
+    }
+
+    return NULL;
+}
+
+static double run(struct bench *b, unsigned int nthreads,
+    void *(*worker)(void *))
+{
+    struct worker *w;
+    struct timespec start, end;
+    unsigned int i;
+    double elapsed;
+
+    w = calloc(nthreads, sizeof(struct worker));
+
+    if (NULL == w)
+        return 0;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (i = 0; i < nthreads; i++) {
+        w[i].b = b;
+        w[i].seed = i + 1;
+        pthread_create(&w[i].thread, NULL, worker, &w[i]);
+    }
+
+    for (i = 0; i < nthreads; i++)
+        pthread_join(w[i].thread, NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    free(w);
+
+    elapsed = (end.tv_sec - start.tv_sec) +
+              (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    /* Millions of operations per second */
+    return ((double)nthreads * b->operations) / elapsed / 1e6;
+}
+
+static void usage(void)
+{
+    fprintf(stdout, "Usage: chashtable [OPTIONS]\n");
+    fprintf(stdout, "Options:\n\n");
+    fprintf(stdout, "  -t [number]\tMaximum number of threads.\n");
+    fprintf(stdout, "  -k [number]\tNumber of keys inside the tables.\n");
+    fprintf(stdout, "  -o [number]\tOperations made by each thread.\n");
+    fprintf(stdout, "  -w [number]\tPercentage of operations that are "
+                    "writes.\n");
+    fprintf(stdout, "\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *opt = "t:k:o:w:h\0";
+    int option;
+    unsigned int i, nthreads, max_threads;
+    struct bench b;
+    double ch, h;
+
+    max_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    b.nkeys = 100000;
+    b.operations = 1000000;
+    b.write_percent = 0;
+
+    do {
+        option = getopt(argc, argv, opt);
+
+        switch (option) {
+            case 'h':
+                usage();
+                return 1;
+
+            case 't':
+                max_threads = atoi(optarg);
+                break;
+
+            case 'k':
+                b.nkeys = atoi(optarg);
+                break;
+
+            case 'o':
+                b.operations = atoi(optarg);
+                break;
+
+            case 'w':
+                b.write_percent = atoi(optarg);
+                break;
+
+            case '?':
+                return -1;
+        }
+    } while (option != -1);
+
+    if ((max_threads == 0) || (b.nkeys == 0)) {
+        usage();
+        return -1;
+    }
+
+    cl_init(NULL);
+    b.keys = calloc(b.nkeys, sizeof(char *));
+    b.ch = cl_chashtable_init(b.nkeys, 0, true, NULL);
+    b.h = cl_hashtable_init(b.nkeys, true, NULL, NULL);
+    pthread_mutex_init(&b.lock, NULL);
+
+    for (i = 0; i < b.nkeys; i++) {
+        b.keys[i] = calloc(KEY_SIZE, sizeof(char));
+        snprintf(b.keys[i], KEY_SIZE, "key-%u", i);
+        cl_chashtable_put(b.ch, b.keys[i], b.keys[i]);
+        cl_hashtable_put(b.h, b.keys[i], b.keys[i]);
+    }
+
+    printf("%u keys, %u operations per thread, %u%% writes\n\n", b.nkeys,
+           b.operations, b.write_percent);
+
+    printf("threads  cl_chashtable_t (Mops/s)  cl_hashtable_t + mutex "
+           "(Mops/s)\n");
+
+    nthreads = 1;
+
+    while (1) {
+        ch = run(&b, nthreads, chashtable_worker);
+        h = run(&b, nthreads, hashtable_worker);
+        printf("%7u  %24.2f  %31.2f\n", nthreads, ch, h);
+
+        if (nthreads == max_threads)
+            break;
+
+        /* Always ends measuring the maximum number of threads */
+        nthreads = ((nthreads << 1) > max_threads) ? max_threads
+                                                   : nthreads << 1;
+    }
+
+    cl_chashtable_uninit(b.ch);
+    cl_hashtable_uninit(b.h);
+    pthread_mutex_destroy(&b.lock);
+
+    for (i = 0; i < b.nkeys; i++)
+        free(b.keys[i]);
+
+    free(b.keys);
+    cl_uninit();
+
+    return 0;
+}
+
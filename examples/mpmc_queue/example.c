@@ -0,0 +1,314 @@
+
+/*
+ * Description: Benchmark moving elements from several producer threads to
+ *              several consumer threads through a cl_mpmc_queue_t, compared
+ *              to a cl_queue_t guarded by a mutex.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 17:20:06 2026
+ * Project: examples
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <time.h>
+
+#include <pthread.h>
+
+#include "collections.h"
+
+/* Tells a consumer to stop */
+#define END_OF_WORK         ((void *)-1L)
+
+struct bench {
+    cl_mpmc_queue_t     *mpmc;
+    cl_queue_t          *queue;
+    pthread_mutex_t     lock;
+    pthread_cond_t      not_empty;
+    pthread_cond_t      not_full;
+    unsigned int        size;
+    unsigned int        capacity;
+    unsigned int        items;
+    unsigned int        batch;
+};
+
+/*
+ * The queue contents are plain numbers, so there is nothing to be released.
+ */
+static void release_nothing(void *data)
+{
+    (void)data;
+}
+
+static void mutex_enqueue(struct bench *b, void *data)
+{
+    pthread_mutex_lock(&b->lock);
+
+    while (b->size >= b->capacity)
+        pthread_cond_wait(&b->not_full, &b->lock);
+
+    cl_queue_enqueue(b->queue, data, sizeof(void *));
+    b->size++;
+    pthread_cond_signal(&b->not_empty);
+    pthread_mutex_unlock(&b->lock);
+}
+
+static void *mutex_dequeue(struct bench *b)
+{
+    cl_queue_node_t *node;
+    void *data;
+
+    pthread_mutex_lock(&b->lock);
+
+    while (b->size == 0)
+        pthread_cond_wait(&b->not_empty, &b->lock);
+
+    node = cl_queue_dequeue(b->queue);
+    b->size--;
+    pthread_cond_signal(&b->not_full);
+    pthread_mutex_unlock(&b->lock);
+
+    data = cl_queue_node_content(node);
+    cl_queue_node_unref(node);
+
+    return data;
+}
+
+static void *mutex_producer(void *arg)
+{
+    struct bench *b = (struct bench *)arg;
+    unsigned long i;
+
+    for (i = 1; i <= b->items; i++)
+        mutex_enqueue(b, (void *)i);
+
+    return NULL;
+}
+
+static void *mutex_consumer(void *arg)
+{
+    struct bench *b = (struct bench *)arg;
+
+    while (mutex_dequeue(b) != END_OF_WORK)
+        ;
+
+    return NULL;
+}
+
+static void *mpmc_producer(void *arg)
+{
+    struct bench *b = (struct bench *)arg;
+    void *data[b->batch];
+    unsigned long i;
+    unsigned int n = 0;
+
+    for (i = 1; i <= b->items; i++) {
+        if (b->batch == 1) {
+            cl_mpmc_queue_enqueue(b->mpmc, (void *)i, sizeof(void *));
+            continue;
+        }
+
+        data[n++] = (void *)i;
+
+        if ((n == b->batch) || (i == b->items)) {
+            cl_mpmc_queue_enqueue_batch(b->mpmc, data, sizeof(void *), n);
+            n = 0;
+        }
+    }
+
+    return NULL;
+}
+
+static void *mpmc_consumer(void *arg)
+{
+    struct bench *b = (struct bench *)arg;
+    void *data[b->batch];
+    bool end = false;
+    int i, n;
+
+    while (end == false) {
+        n = cl_mpmc_queue_dequeue_batch(b->mpmc, data, b->batch);
+
+        for (i = 0; i < n; i++) {
+            if (data[i] != END_OF_WORK)
+                continue;
+
+            /* A batch may take the marks of other consumers too */
+            if (end == true)
+                cl_mpmc_queue_enqueue(b->mpmc, END_OF_WORK, sizeof(void *));
+
+            end = true;
+        }
+    }
+
+    return NULL;
+}
+
+static double run(struct bench *b, unsigned int nthreads,
+    void *(*producer)(void *), void *(*consumer)(void *))
+{
+    pthread_t *producers, *consumers;
+    struct timespec start, end;
+    unsigned int i;
+    double elapsed;
+
+    producers = calloc(nthreads, sizeof(pthread_t));
+    consumers = calloc(nthreads, sizeof(pthread_t));
+
+    if ((NULL == producers) || (NULL == consumers)) {
+        free(producers);
+        free(consumers);
+        return 0;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (i = 0; i < nthreads; i++) {
+        pthread_create(&consumers[i], NULL, consumer, b);
+        pthread_create(&producers[i], NULL, producer, b);
+    }
+
+    for (i = 0; i < nthreads; i++)
+        pthread_join(producers[i], NULL);
+
+    for (i = 0; i < nthreads; i++) {
+        if (consumer == mpmc_consumer)
+            cl_mpmc_queue_enqueue(b->mpmc, END_OF_WORK, sizeof(void *));
+        else
+            mutex_enqueue(b, END_OF_WORK);
+    }
+
+    for (i = 0; i < nthreads; i++)
+        pthread_join(consumers[i], NULL);
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    free(producers);
+    free(consumers);
+
+    elapsed = (end.tv_sec - start.tv_sec) +
+              (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    /* Millions of elements per second */
+    return ((double)nthreads * b->items) / elapsed / 1e6;
+}
+
+static void usage(void)
+{
+    fprintf(stdout, "Usage: mpmc_queue [OPTIONS]\n");
+    fprintf(stdout, "Options:\n\n");
+    fprintf(stdout, "  -t [number]\tMaximum number of producer (and consumer) "
+                    "threads.\n");
+    fprintf(stdout, "  -c [number]\tQueue capacity.\n");
+    fprintf(stdout, "  -n [number]\tElements sent by each producer.\n");
+    fprintf(stdout, "  -b [number]\tElements moved at once by the "
+                    "cl_mpmc_queue_t threads.\n");
+    fprintf(stdout, "\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *opt = "t:c:n:b:h\0";
+    int option;
+    unsigned int nthreads, max_threads;
+    struct bench b;
+    double mpmc, mutex;
+
+    max_threads = sysconf(_SC_NPROCESSORS_ONLN) / 2;
+    b.capacity = 1024;
+    b.items = 1000000;
+    b.batch = 1;
+    b.size = 0;
+
+    do {
+        option = getopt(argc, argv, opt);
+
+        switch (option) {
+            case 'h':
+                usage();
+                return 1;
+
+            case 't':
+                max_threads = atoi(optarg);
+                break;
+
+            case 'c':
+                b.capacity = atoi(optarg);
+                break;
+
+            case 'n':
+                b.items = atoi(optarg);
+                break;
+
+            case 'b':
+                b.batch = atoi(optarg);
+                break;
+
+            case '?':
+                return -1;
+        }
+    } while (option != -1);
+
+    if (max_threads == 0)
+        max_threads = 1;
+
+    if ((b.capacity == 0) || (b.batch == 0)) {
+        usage();
+        return -1;
+    }
+
+    cl_init(NULL);
+    b.mpmc = cl_mpmc_queue_create(b.capacity, release_nothing);
+    b.queue = cl_queue_create(release_nothing, NULL, NULL, NULL);
+    pthread_mutex_init(&b.lock, NULL);
+    pthread_cond_init(&b.not_empty, NULL);
+    pthread_cond_init(&b.not_full, NULL);
+
+    printf("capacity %u, %u elements per producer, batches of %u\n\n",
+           b.capacity, b.items, b.batch);
+
+    printf("threads  cl_mpmc_queue_t (Melem/s)  cl_queue_t + mutex "
+           "(Melem/s)\n");
+
+    nthreads = 1;
+
+    while (1) {
+        mpmc = run(&b, nthreads, mpmc_producer, mpmc_consumer);
+        mutex = run(&b, nthreads, mutex_producer, mutex_consumer);
+        printf("%7u  %25.2f  %27.2f\n", nthreads, mpmc, mutex);
+
+        if (nthreads == max_threads)
+            break;
+
+        /* Always ends measuring the maximum number of threads */
+        nthreads = ((nthreads << 1) > max_threads) ? max_threads
+                                                   : nthreads << 1;
+    }
+
+    cl_mpmc_queue_destroy(b.mpmc);
+    cl_queue_destroy(b.queue);
+    pthread_cond_destroy(&b.not_full);
+    pthread_cond_destroy(&b.not_empty);
+    pthread_mutex_destroy(&b.lock);
+    cl_uninit();
+
+    return 0;
+}
+
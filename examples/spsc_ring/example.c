@@ -0,0 +1,263 @@
+
+/*
+ * Description: Benchmark showing a cl_spsc_ring_t handing records from a
+ *              reader thread to a parser thread, compared to a cl_queue_t
+ *              guarded by a mutex.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 17:41:26 2026
+ * Project: examples
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include <time.h>
+
+#include <pthread.h>
+
+#include "collections.h"
+
+#define BATCH_SIZE          32
+
+struct record {
+    unsigned long       seq;
+    char                payload[56];
+};
+
+struct bench {
+    cl_spsc_ring_t      *ring;
+    cl_queue_t          *queue;
+    pthread_mutex_t     lock;
+    pthread_cond_t      not_empty;
+    pthread_cond_t      not_full;
+    unsigned int        size;
+    unsigned int        capacity;
+    unsigned int        items;
+    unsigned int        errors;
+};
+
+static void fill_record(struct record *r, unsigned long seq)
+{
+    r->seq = seq;
+    memset(r->payload, (int)(seq & 0xff), sizeof(r->payload));
+}
+
+static void *ring_reader(void *arg)
+{
+    struct bench *b = (struct bench *)arg;
+    struct record *r;
+    unsigned long i = 0;
+    unsigned int n;
+
+    while (i < b->items) {
+        /* Records are written straight into the ring slots */
+        for (n = 0; (n < BATCH_SIZE) && (i < b->items); n++) {
+            r = cl_spsc_ring_reserve(b->ring);
+
+            if (NULL == r)
+                break;
+
+            fill_record(r, i++);
+        }
+
+        if (cl_spsc_ring_commit(b->ring) == 0)
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+static void *ring_parser(void *arg)
+{
+    struct bench *b = (struct bench *)arg;
+    struct record records[BATCH_SIZE];
+    unsigned long expected = 0;
+    int i, n;
+
+    while (expected < b->items) {
+        n = cl_spsc_ring_pop_batch(b->ring, records, BATCH_SIZE);
+
+        if (n == 0) {
+            cl_spsc_ring_wait(b->ring, -1);
+            continue;
+        }
+
+        for (i = 0; i < n; i++)
+            if (records[i].seq != expected++)
+                b->errors++;
+    }
+
+    return NULL;
+}
+
+static void *mutex_reader(void *arg)
+{
+    struct bench *b = (struct bench *)arg;
+    struct record *r;
+    unsigned long i;
+
+    for (i = 0; i < b->items; i++) {
+        r = malloc(sizeof(struct record));
+        fill_record(r, i);
+        pthread_mutex_lock(&b->lock);
+
+        while (b->size >= b->capacity)
+            pthread_cond_wait(&b->not_full, &b->lock);
+
+        cl_queue_enqueue(b->queue, r, sizeof(struct record));
+        b->size++;
+        pthread_cond_signal(&b->not_empty);
+        pthread_mutex_unlock(&b->lock);
+    }
+
+    return NULL;
+}
+
+static void *mutex_parser(void *arg)
+{
+    struct bench *b = (struct bench *)arg;
+    cl_queue_node_t *node;
+    struct record *r;
+    unsigned long expected = 0;
+
+    while (expected < b->items) {
+        pthread_mutex_lock(&b->lock);
+
+        while (b->size == 0)
+            pthread_cond_wait(&b->not_empty, &b->lock);
+
+        node = cl_queue_dequeue(b->queue);
+        b->size--;
+        pthread_cond_signal(&b->not_full);
+        pthread_mutex_unlock(&b->lock);
+
+        r = cl_queue_node_content(node);
+
+        if (r->seq != expected++)
+            b->errors++;
+
+        cl_queue_node_unref(node);
+    }
+
+    return NULL;
+}
+
+static double run(struct bench *b, void *(*reader)(void *),
+    void *(*parser)(void *))
+{
+    pthread_t r, p;
+    struct timespec start, end;
+    double elapsed;
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pthread_create(&p, NULL, parser, b);
+    pthread_create(&r, NULL, reader, b);
+    pthread_join(r, NULL);
+    pthread_join(p, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    elapsed = (end.tv_sec - start.tv_sec) +
+              (end.tv_nsec - start.tv_nsec) / 1e9;
+
+    /* Millions of records per second */
+    return (double)b->items / elapsed / 1e6;
+}
+
+static void usage(void)
+{
+    fprintf(stdout, "Usage: spsc_ring [OPTIONS]\n");
+    fprintf(stdout, "Options:\n\n");
+    fprintf(stdout, "  -c [number]\tRing (and queue) capacity.\n");
+    fprintf(stdout, "  -n [number]\tRecords sent by the reader.\n");
+    fprintf(stdout, "\n");
+}
+
+int main(int argc, char **argv)
+{
+    const char *opt = "c:n:h\0";
+    int option;
+    struct bench b;
+    double ring, mutex;
+
+    b.capacity = 1024;
+    b.items = 5000000;
+    b.size = 0;
+    b.errors = 0;
+
+    do {
+        option = getopt(argc, argv, opt);
+
+        switch (option) {
+            case 'h':
+                usage();
+                return 1;
+
+            case 'c':
+                b.capacity = atoi(optarg);
+                break;
+
+            case 'n':
+                b.items = atoi(optarg);
+                break;
+
+            case '?':
+                return -1;
+        }
+    } while (option != -1);
+
+    if (b.capacity == 0) {
+        usage();
+        return -1;
+    }
+
+    cl_init(NULL);
+    b.ring = cl_spsc_ring_create(b.capacity, sizeof(struct record),
+                                 CL_SPSC_RING_EVENTFD);
+
+    b.queue = cl_queue_create(free, NULL, NULL, NULL);
+    pthread_mutex_init(&b.lock, NULL);
+    pthread_cond_init(&b.not_empty, NULL);
+    pthread_cond_init(&b.not_full, NULL);
+
+    printf("capacity %u, %u records of %zu bytes\n\n", b.capacity, b.items,
+           sizeof(struct record));
+
+    ring = run(&b, ring_reader, ring_parser);
+    mutex = run(&b, mutex_reader, mutex_parser);
+
+    printf("cl_spsc_ring_t:      %8.2f Mrec/s\n", ring);
+    printf("cl_queue_t + mutex:  %8.2f Mrec/s\n", mutex);
+
+    if (b.errors != 0)
+        printf("%u records arrived out of order\n", b.errors);
+
+    cl_spsc_ring_destroy(b.ring);
+    cl_queue_destroy(b.queue);
+    pthread_cond_destroy(&b.not_full);
+    pthread_cond_destroy(&b.not_empty);
+    pthread_mutex_destroy(&b.lock);
+    cl_uninit();
+
+    return 0;
+}
+
@@ -0,0 +1,302 @@
+
+/*
+ * Description: API to handle sets of unsigned integers as bits.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 21:02:18 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef _COLLECTIONS_API_BITSET_H
+#define _COLLECTIONS_API_BITSET_H         1
+
+#ifndef LIBCOLLECTIONS_COMPILE
+# ifndef _COLLECTIONS_H
+#  error "Never use <bitset.h> directly; include <collections.h> instead."
+# endif
+#endif
+
+/** Options to create bitsets */
+enum cl_bitset_flags {
+    CL_BITSET_GROWABLE      = (1 << 0),
+    CL_BITSET_COMPRESSED    = (1 << 1)
+};
+
+/**
+ * @name cl_bitset_ref
+ * @brief Increases the reference count of a cl_bitset_t object.
+ *
+ * @param [in] bitset: The cl_bitset_t object.
+ *
+ * @return On success returns the item itself with its reference count
+ *         increased or NULL otherwise.
+ */
+cl_bitset_t *cl_bitset_ref(cl_bitset_t *bitset);
+
+/**
+ * @name cl_bitset_unref
+ * @brief Decreases the reference count for a cl_bitset_t object.
+ *
+ * When its reference count drops to 0, the item is finalized (its memory is
+ * freed).
+ *
+ * @param [in] bitset: The cl_bitset_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_bitset_unref(cl_bitset_t *bitset);
+
+/**
+ * @name cl_bitset_create
+ * @brief Creates a set of unsigned integers kept as bits.
+ *
+ * Every member of the set takes a single bit, the one at its position, so
+ * feature flags or seen identifiers cost a bit each instead of a node with a
+ * boxed integer. Set operations, counting the members and looking for the
+ * next one work a machine word at a time, or several of them when the
+ * processor has vector instructions.
+ *
+ * By default a set holds the members from 0 up to \a size - 1, and adding a
+ * larger one fails. With CL_BITSET_GROWABLE in \a flags it holds any
+ * unsigned int, growing as they are added, and \a size is only a hint of
+ * how many bits to allocate at first.
+ *
+ * A set is a plain array of bits, which wastes memory when its members are
+ * few and far apart. With CL_BITSET_COMPRESSED it is split in chunks of
+ * 65536 bits instead, as Roaring bitmaps do, where empty chunks take no
+ * memory at all, chunks with up to 4096 members keep them as a sorted array
+ * of 16 bits integers and fuller ones keep their bits. Members are then found
+ * by a binary search and \a size preallocates nothing.
+ *
+ * A set created with \a thread_safe may be used by several threads at once.
+ * Functions that only read it share a read lock while the ones that change
+ * it take the lock exclusively.
+ *
+ * @param [in] size: The number of bits of the set.
+ * @param [in] flags: A bitwise OR of enum cl_bitset_flags values, or 0.
+ * @param [in] thread_safe: A boolean flag to indicate if the set will be
+ *                          shared between threads or not.
+ *
+ * @return On success returns a cl_bitset_t object or NULL otherwise.
+ */
+cl_bitset_t *cl_bitset_create(unsigned int size, unsigned int flags,
+                              bool thread_safe);
+
+/**
+ * @name cl_bitset_destroy
+ * @brief Releases a cl_bitset_t object from memory.
+ *
+ * @param [in] bitset: The cl_bitset_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_bitset_destroy(cl_bitset_t *bitset);
+
+/**
+ * @name cl_bitset_dup
+ * @brief Duplicates a cl_bitset_t object.
+ *
+ * The new set has the same members, flags and size of the original one.
+ *
+ * @param [in] bitset: The cl_bitset_t object.
+ *
+ * @return On success returns the new cl_bitset_t object or NULL otherwise.
+ */
+cl_bitset_t *cl_bitset_dup(cl_bitset_t *bitset);
+
+/**
+ * @name cl_bitset_set
+ * @brief Adds a member to the set.
+ *
+ * @param [in] bitset: The cl_bitset_t object.
+ * @param [in] bit: The member.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_bitset_set(cl_bitset_t *bitset, unsigned int bit);
+
+/**
+ * @name cl_bitset_clear
+ * @brief Removes a member from the set.
+ *
+ * Removing a member which is not there is not an error.
+ *
+ * @param [in] bitset: The cl_bitset_t object.
+ * @param [in] bit: The member.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_bitset_clear(cl_bitset_t *bitset, unsigned int bit);
+
+/**
+ * @name cl_bitset_test
+ * @brief Checks if a number is a member of the set.
+ *
+ * @param [in] bitset: The cl_bitset_t object.
+ * @param [in] bit: The number.
+ *
+ * @return Returns true if \a bit is a member or false otherwise.
+ */
+bool cl_bitset_test(cl_bitset_t *bitset, unsigned int bit);
+
+/**
+ * @name cl_bitset_clear_all
+ * @brief Removes every member from the set.
+ *
+ * @param [in] bitset: The cl_bitset_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_bitset_clear_all(cl_bitset_t *bitset);
+
+/**
+ * @name cl_bitset_count
+ * @brief Gets the number of members of the set.
+ *
+ * @param [in] bitset: The cl_bitset_t object.
+ *
+ * @return On success returns the number of members or -1 otherwise.
+ */
+long long cl_bitset_count(cl_bitset_t *bitset);
+
+/**
+ * @name cl_bitset_next_set
+ * @brief Finds the smallest member of the set not below a number.
+ *
+ * Every member can be visited, in order, starting from 0 and calling this
+ * again from the last found member plus one.
+ *
+ * @param [in] bitset: The cl_bitset_t object.
+ * @param [in] from: The number where the search starts.
+ *
+ * @return On success returns the member or -1 if there is none.
+ */
+long long cl_bitset_next_set(cl_bitset_t *bitset, unsigned int from);
+
+/**
+ * @name cl_bitset_and
+ * @brief Keeps in a set only the members also found in another one.
+ *
+ * Both sets may use different representations. A set which is not growable
+ * keeps its size in this and the following operations, ignoring any member
+ * of \a other beyond it.
+ *
+ * @param [in,out] bitset: The cl_bitset_t object which is changed.
+ * @param [in] other: The cl_bitset_t object with the other members.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_bitset_and(cl_bitset_t *bitset, cl_bitset_t *other);
+
+/**
+ * @name cl_bitset_or
+ * @brief Adds to a set every member of another one.
+ *
+ * @param [in,out] bitset: The cl_bitset_t object which is changed.
+ * @param [in] other: The cl_bitset_t object with the other members.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_bitset_or(cl_bitset_t *bitset, cl_bitset_t *other);
+
+/**
+ * @name cl_bitset_xor
+ * @brief Keeps in a set the members found in only one of two sets.
+ *
+ * @param [in,out] bitset: The cl_bitset_t object which is changed.
+ * @param [in] other: The cl_bitset_t object with the other members.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_bitset_xor(cl_bitset_t *bitset, cl_bitset_t *other);
+
+/**
+ * @name cl_bitset_andnot
+ * @brief Removes from a set every member of another one.
+ *
+ * @param [in,out] bitset: The cl_bitset_t object which is changed.
+ * @param [in] other: The cl_bitset_t object with the members to remove.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_bitset_andnot(cl_bitset_t *bitset, cl_bitset_t *other);
+
+/**
+ * @name cl_bitset_to_list
+ * @brief Creates a list with the members of a set.
+ *
+ * The list holds, in ascending order, a cl_object_t of CL_UINT type for
+ * every member.
+ *
+ * @param [in] bitset: The cl_bitset_t object.
+ *
+ * @return On success returns a cl_list_t object or NULL otherwise.
+ */
+cl_list_t *cl_bitset_to_list(cl_bitset_t *bitset);
+
+/**
+ * @name cl_bitset_from_list
+ * @brief Creates a set with the numbers of a list.
+ *
+ * The list must hold cl_object_t objects of integer types, whose values
+ * can't be negative nor larger than an unsigned int. Unless \a flags has
+ * CL_BITSET_GROWABLE, the size of the new set is its largest member plus
+ * one.
+ *
+ * @param [in] list: The list object.
+ * @param [in] flags: A bitwise OR of enum cl_bitset_flags values, or 0.
+ * @param [in] thread_safe: A boolean flag to indicate if the set will be
+ *                          shared between threads or not.
+ *
+ * @return On success returns a cl_bitset_t object or NULL otherwise.
+ */
+cl_bitset_t *cl_bitset_from_list(const cl_list_t *list, unsigned int flags,
+                                 bool thread_safe);
+
+/**
+ * @name cl_bitset_to_json
+ * @brief Creates a JSON array with the members of a set.
+ *
+ * @param [in] bitset: The cl_bitset_t object.
+ *
+ * @return On success returns a cl_json_t array, with the members in
+ *         ascending order, or NULL otherwise.
+ */
+cl_json_t *cl_bitset_to_json(cl_bitset_t *bitset);
+
+/**
+ * @name cl_bitset_from_json
+ * @brief Creates a set with the numbers of a JSON array.
+ *
+ * The array must hold only integer numbers, which can't be negative nor
+ * larger than an unsigned int. Sizes are handled as in cl_bitset_from_list.
+ *
+ * @param [in] array: The cl_json_t array.
+ * @param [in] flags: A bitwise OR of enum cl_bitset_flags values, or 0.
+ * @param [in] thread_safe: A boolean flag to indicate if the set will be
+ *                          shared between threads or not.
+ *
+ * @return On success returns a cl_bitset_t object or NULL otherwise.
+ */
+cl_bitset_t *cl_bitset_from_json(const cl_json_t *array, unsigned int flags,
+                                 bool thread_safe);
+
+#endif
+
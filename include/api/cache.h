@@ -0,0 +1,248 @@
+
+/*
+ * Description: API to handle caches with a bounded capacity.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 23:41:09 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef _COLLECTIONS_API_CACHE_H
+#define _COLLECTIONS_API_CACHE_H          1
+
+#ifndef LIBCOLLECTIONS_COMPILE
+# ifndef _COLLECTIONS_H
+#  error "Never use <cache.h> directly; include <collections.h> instead."
+# endif
+#endif
+
+/** Policies to choose which entry leaves a full cache */
+enum cl_cache_policy {
+    CL_CACHE_LRU,
+    CL_CACHE_TINYLFU
+};
+
+/** What the capacity of a cache limits */
+enum cl_cache_limit {
+    CL_CACHE_LIMIT_ENTRIES,
+    CL_CACHE_LIMIT_BYTES
+};
+
+/** Cache internal counters */
+struct cl_cache_stats_s {
+    unsigned long long  hits;
+    unsigned long long  misses;
+    unsigned long long  evictions;
+    unsigned long long  expirations;
+    unsigned int        entries;
+    unsigned long long  weight;
+};
+
+/**
+ * @name cl_cache_ref
+ * @brief Increases the reference count of a cl_cache_t object.
+ *
+ * @param [in] cache: The cl_cache_t object.
+ *
+ * @return On success returns the item itself with its reference count
+ *         increased or NULL otherwise.
+ */
+cl_cache_t *cl_cache_ref(cl_cache_t *cache);
+
+/**
+ * @name cl_cache_unref
+ * @brief Decreases the reference count for a cl_cache_t object.
+ *
+ * When its reference count drops to 0, the item is finalized (its memory is
+ * freed).
+ *
+ * @param [in] cache: The cl_cache_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_cache_unref(cl_cache_t *cache);
+
+/**
+ * @name cl_cache_create
+ * @brief Creates a cache.
+ *
+ * Entries are found through a hash table and kept in recency order inside
+ * linked lists, so looking up, inserting and evicting an entry take O(1).
+ *
+ * With CL_CACHE_LRU the least recently used entry leaves when the cache is
+ * full. CL_CACHE_TINYLFU keeps new entries in a small LRU window and, when
+ * they leave it, only lets them in the rest of the cache if they are used
+ * more often than the entry they would push out. Use frequencies are
+ * estimated by a small sketch, so keys that are only seen once, like those
+ * of a scan, can't flush the entries that are used all the time.
+ *
+ * The \a capacity limits the number of entries or, with CL_CACHE_LIMIT_BYTES,
+ * the sum of the sizes given when they were inserted.
+ *
+ * Once inserted, values belong to the cache and are released with
+ * \a release whenever they leave it, be it evicted, expired, replaced or
+ * deleted. When \a release is NULL the values are never released.
+ *
+ * A cache created with \a thread_safe may be used by several threads at
+ * once. Functions of this object do not hold a reference to it while
+ * running, so the caller must keep one of its own while sharing it between
+ * threads.
+ *
+ * @param [in] policy: The eviction policy.
+ * @param [in] limit: What \a capacity limits.
+ * @param [in] capacity: The most entries, or bytes, the cache can hold.
+ * @param [in] release: An optional function to release the values.
+ * @param [in] thread_safe: A boolean flag to indicate if the cache will be
+ *                          shared between threads or not.
+ *
+ * @return On success returns a cl_cache_t object or NULL otherwise.
+ */
+cl_cache_t *cl_cache_create(enum cl_cache_policy policy,
+                            enum cl_cache_limit limit,
+                            unsigned long long capacity,
+                            void (*release)(void *), bool thread_safe);
+
+/**
+ * @name cl_cache_destroy
+ * @brief Releases a cl_cache_t object from memory.
+ *
+ * @param [in] cache: The cl_cache_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_cache_destroy(cl_cache_t *cache);
+
+/**
+ * @name cl_cache_put
+ * @brief Maps a key to a value inside the cache.
+ *
+ * If the key already exists its previous value is released and replaced by
+ * \a value. Inserting may evict other entries, or even the new one with
+ * CL_CACHE_TINYLFU, to keep the cache within its capacity.
+ *
+ * @param [in] cache: The cl_cache_t object.
+ * @param [in] key: The key.
+ * @param [in] value: The value.
+ * @param [in] size: The value size in bytes, which only matters if the cache
+ *                   capacity is measured in bytes.
+ * @param [in] ttl: For how many milliseconds the entry is valid, or 0 to
+ *                  keep it until it is evicted.
+ *
+ * An entry heavier than what the cache may hold outside the CL_CACHE_TINYLFU
+ * window, which takes 1% of its capacity, is refused.
+ *
+ * @return On success returns 0 or -1 otherwise, in which case the value does
+ *         not belong to the cache.
+ */
+int cl_cache_put(cl_cache_t *cache, const char *key, void *value,
+                 unsigned int size, unsigned int ttl);
+
+/**
+ * @name cl_cache_get
+ * @brief Gets the value to which a key is mapped.
+ *
+ * The entry becomes the most recently used one. Expired entries are removed
+ * here, and count as misses.
+ *
+ * The value still belongs to the cache and is valid only until its entry
+ * leaves it. With a cache shared between threads another thread may release
+ * it as soon as this function returns, so it is only safe to use there if
+ * the values can be referenced by the caller, like cl_object_t. Otherwise
+ * use cl_cache_visit to read or copy the value while the cache is locked.
+ *
+ * @param [in] cache: The cl_cache_t object.
+ * @param [in] key: The key whose value is to be returned.
+ *
+ * @return On success returns the value or NULL otherwise.
+ */
+void *cl_cache_get(cl_cache_t *cache, const char *key);
+
+/**
+ * @name cl_cache_visit
+ * @brief Runs a function over the value to which a key is mapped.
+ *
+ * The entry is looked up exactly as cl_cache_get does, and the \a foo
+ * function receives as arguments its key, its value and some \a data, while
+ * the cache is still locked, so it may safely read the value, copy it or
+ * take a reference to it even if other threads change the cache. Its
+ * prototype must be something of this type:
+ * void foo(const char *, void *, void *);
+ *
+ * The cache must not be used from inside \a foo.
+ *
+ * @param [in] cache: The cl_cache_t object.
+ * @param [in] key: The key to look for.
+ * @param [in] foo: The function.
+ * @param [in] data: The custom data passed to the function.
+ *
+ * @return Returns 0 if the key was found and \a foo called or -1 otherwise.
+ */
+int cl_cache_visit(cl_cache_t *cache, const char *key,
+                   void (*foo)(const char *, void *, void *), void *data);
+
+/**
+ * @name cl_cache_delete
+ * @brief Removes a key, and its value, from the cache.
+ *
+ * The value is released the same way as when the cache is released.
+ *
+ * @param [in] cache: The cl_cache_t object.
+ * @param [in] key: The key that needs to be removed.
+ *
+ * @return On success returns 0 or -1 if the key was not found.
+ */
+int cl_cache_delete(cl_cache_t *cache, const char *key);
+
+/**
+ * @name cl_cache_expire
+ * @brief Removes every expired entry from the cache.
+ *
+ * Expired entries are otherwise only noticed when they are looked up, so this
+ * is the way to give back their memory earlier.
+ *
+ * @param [in] cache: The cl_cache_t object.
+ *
+ * @return On success returns the number of removed entries or -1 otherwise.
+ */
+int cl_cache_expire(cl_cache_t *cache);
+
+/**
+ * @name cl_cache_size
+ * @brief Gets the number of entries inside the cache.
+ *
+ * @param [in] cache: The cl_cache_t object.
+ *
+ * @return On success returns the number of entries or -1 otherwise.
+ */
+int cl_cache_size(cl_cache_t *cache);
+
+/**
+ * @name cl_cache_stats
+ * @brief Gets the internal counters of a cache.
+ *
+ * @param [in] cache: The cl_cache_t object.
+ * @param [out] stats: The structure where the counters will be stored.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_cache_stats(cl_cache_t *cache, struct cl_cache_stats_s *stats);
+
+#endif
+
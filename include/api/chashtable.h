@@ -0,0 +1,168 @@
+
+/*
+ * Description: API to handle a hash table shared between threads.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 10:41:27 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef _COLLECTIONS_API_CHASHTABLE_H
+#define _COLLECTIONS_API_CHASHTABLE_H          1
+
+#ifndef LIBCOLLECTIONS_COMPILE
+# ifndef _COLLECTIONS_H
+#  error "Never use <chashtable.h> directly; include <collections.h> instead."
+# endif
+#endif
+
+/**
+ * @name cl_chashtable_ref
+ * @brief Increases the reference count of a cl_chashtable_t object.
+ *
+ * @param [in] hashtable: The cl_chashtable_t object.
+ *
+ * @return On success returns the item itself with its reference count
+ *         increased or NULL otherwise.
+ */
+cl_chashtable_t *cl_chashtable_ref(cl_chashtable_t *hashtable);
+
+/**
+ * @name cl_chashtable_unref
+ * @brief Decreases the reference count for a cl_chashtable_t object.
+ *
+ * When its reference count drops to 0, the item is finalized (its memory is
+ * freed).
+ *
+ * @param [in] hashtable: The cl_chashtable_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_chashtable_unref(cl_chashtable_t *hashtable);
+
+/**
+ * @name cl_chashtable_init
+ * @brief Creates a hash table that may be used by several threads at once.
+ *
+ * The keys are spread over \a shards independent tables, each one with its
+ * own lock, so writers only contend when they touch the same shard. Readers
+ * never take a lock: cl_chashtable_get and cl_chashtable_contains_key are
+ * lock-free, since the first lookup of each thread claims a reader record
+ * with a compare-and-swap loop, and removed entries are only released when
+ * no reader can be looking at them anymore.
+ *
+ * Functions of this object do not hold a reference to it while running, so
+ * the caller must keep one of its own while sharing it between threads.
+ *
+ * @param [in] size: The initial hash table size. The table grows as needed.
+ * @param [in] shards: The number of shards, rounded up to a power of 2. If
+ *                     0 a default value is used.
+ * @param [in] replace_data: A boolean flag to indicate if the data of an
+ *                           already existing key will be overwritten or not.
+ * @param [in] release: An optional function to be called over every stored
+ *                      value when releasing the hash table.
+ *
+ * @return On success returns a cl_chashtable_t object or NULL otherwise.
+ */
+cl_chashtable_t *cl_chashtable_init(unsigned int size, unsigned int shards,
+                                    bool replace_data,
+                                    void (*release)(void *));
+
+/**
+ * @name cl_chashtable_uninit
+ * @brief Releases a hash table from memory.
+ *
+ * @param [in] hashtable: The cl_chashtable_t object which will be released.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_chashtable_uninit(cl_chashtable_t *hashtable);
+
+/**
+ * @name cl_chashtable_put
+ * @brief Maps the specified key to the specified value in the hashtable.
+ *
+ * If the key already exists and replace_data was false when creating the hash
+ * table, nothing is stored and the error code is set to CL_HASHTABLE_COLLISION.
+ *
+ * When a value is replaced, concurrent readers may still have received the
+ * old one, so the caller must not release it while they can be using it.
+ *
+ * @param [in] hashtable: The cl_chashtable_t object.
+ * @param [in] key: The hash table key.
+ * @param [in] data: The value.
+ *
+ * @return On success, returns the previous value of the specified key in this
+ *         hash table, if replace_data was true when creating the hash table, or
+ *         NULL otherwise.
+ */
+void *cl_chashtable_put(cl_chashtable_t *hashtable, const char *key,
+                        void *data);
+
+/**
+ * @name cl_chashtable_get
+ * @brief Gets the value to which the specified key is mapped.
+ *
+ * @param [in] hashtable: The cl_chashtable_t object.
+ * @param [in] key: The key whose associated value is to be returned.
+ *
+ * @return On success returns the value or NULL otherwise.
+ */
+void *cl_chashtable_get(cl_chashtable_t *hashtable, const char *key);
+
+/**
+ * @name cl_chashtable_delete
+ * @brief Removes a key, and its value, from the hash table.
+ *
+ * The value is not released, it remains under the caller responsibility.
+ *
+ * @param [in] hashtable: The cl_chashtable_t object.
+ * @param [in] key: The key that needs to be removed.
+ *
+ * @return On success returns 0 or -1 if the key was not found.
+ */
+int cl_chashtable_delete(cl_chashtable_t *hashtable, const char *key);
+
+/**
+ * @name cl_chashtable_contains_key
+ * @brief Tests if the specified object is a key in this hash table.
+ *
+ * @param [in] hashtable: The cl_chashtable_t object.
+ * @param [in] key: Possible key.
+ *
+ * @return Returns true if and only if the specified object is a key in this
+ *         hash table or false otherwise.
+ */
+bool cl_chashtable_contains_key(cl_chashtable_t *hashtable, const char *key);
+
+/**
+ * @name cl_chashtable_size
+ * @brief Gets the number of values in this hash table.
+ *
+ * While other threads are changing the hash table this is only a snapshot.
+ *
+ * @param [in] hashtable: The cl_chashtable_t object.
+ *
+ * @return On success returns the number of values or -1 otherwise.
+ */
+int cl_chashtable_size(cl_chashtable_t *hashtable);
+
+#endif
+
@@ -33,6 +33,16 @@
 # endif
 #endif
 
+/** Hash table internal counters */
+struct cl_hashtable_stats_s {
+    unsigned int    size;
+    unsigned int    capacity;
+    double          load_factor;
+    bool            resizing;
+    unsigned int    old_capacity;
+    unsigned int    migrated_slots;
+};
+
 /**
  * @name cl_hashtable_ref
  * @brief Increases the reference count of a cl_hashtable_t object.
@@ -61,9 +71,12 @@ int cl_hashtable_unref(cl_hashtable_t *hashtable);
  * @name cl_hashtable_init
  * @brief Creates a hash table to store any kind of data.
  *
- * @param [in] size: The hash table size.
- * @param [in] replace_data: A boolean flag to indicate if a collision of key
- *                           happens the data will be overwritten or not.
+ * The table uses open addressing and grows automatically as keys are
+ * inserted, so \a size is only a hint of how many keys it will hold.
+ *
+ * @param [in] size: The initial hash table size.
+ * @param [in] replace_data: A boolean flag to indicate if the data of an
+ *                           already existing key will be overwritten or not.
  * @param [in] compare: A function to compare the item stored inside the hash
  *                      table. It must return true if the two arguments are
  *                      equals or false otherwise.
@@ -94,6 +107,9 @@ int cl_hashtable_uninit(cl_hashtable_t *hashtable);
  * @param [in] key: The hash table key.
  * @param [in] data: The value.
  *
+ * If the key already exists and replace_data was false when creating the hash
+ * table, nothing is stored and the error code is set to CL_HASHTABLE_COLLISION.
+ *
  * @return On success, returns the previous value of the specified key in this
  *         hash table, if replace_data was true when creating the hash table, or
  *         NULL otherwise.
@@ -113,12 +129,14 @@ void *cl_hashtable_get(cl_hashtable_t *hashtable, const char *key);
 
 /**
  * @name cl_hashtable_delete
- * @brief
+ * @brief Removes a key, and its value, from the hash table.
+ *
+ * The value is not released, it remains under the caller responsibility.
  *
  * @param [in] hashtable: The cl_hashtable_t object.
  * @param [in] key: The key that needs to be removed.
  *
- * @return
+ * @return On success returns 0 or -1 if the key was not found.
  */
 int cl_hashtable_delete(cl_hashtable_t *hashtable, const char *key);
 
@@ -170,6 +188,12 @@ bool cl_hashtable_contains_value(cl_hashtable_t *hashtable, void *data);
  * @name cl_hashtable_keys
  * @brief Gets the keys in this hash table.
  *
+ * Keys that are not duplicated point to the hash table internal storage,
+ * without any copy, and are valid only until a key is removed from it or
+ * the table is cleared. Duplicated keys belong to the list. Both kinds are
+ * always '\0' terminated, even those added with the _bytes or _ullong
+ * functions.
+ *
  * @param [in] hashtable: The cl_hashtable_t object.
  * @param [in] dup: A boolean flag to duplicate every key name inside the
  *                  returned list or just a reference to the original one.
@@ -179,5 +203,195 @@ bool cl_hashtable_contains_value(cl_hashtable_t *hashtable, void *data);
  */
 cl_list_t *cl_hashtable_keys(cl_hashtable_t *hashtable, bool dup);
 
+/**
+ * @name cl_hashtable_map
+ * @brief Maps a function to every key of a hash table.
+ *
+ * The \a foo function receives as arguments a key, its value and some
+ * \a data. Its prototype must be something of this type:
+ * int foo(const char *, void *, void *);
+ *
+ * Keys are not copied, they point to the hash table internal storage and
+ * are valid only until a key is removed from it. Keys added with the
+ * _ullong functions point to an unsigned long long and are valid only until
+ * the hash table is changed. The hash table must not be changed from inside
+ * \a foo.
+ *
+ * @param [in] hashtable: The cl_hashtable_t object.
+ * @param [in] foo: The function.
+ * @param [in] data: The custom data passed to the map function.
+ *
+ * @return If \a foo returns a non-zero returns the current key. If not
+ *         returns NULL.
+ */
+const char *cl_hashtable_map(cl_hashtable_t *hashtable,
+                             int (*foo)(const char *, void *, void *),
+                             void *data);
+
+/**
+ * @name cl_hashtable_set_incremental_resize
+ * @brief Sets how the hash table moves its entries when it grows.
+ *
+ * By default all entries are moved to the new table at once, inside the
+ * cl_hashtable_put call that triggered the growth. In the incremental mode
+ * the old table is kept and at least \a slots_per_operation of its slots are
+ * moved at every put or delete call, so no single call pays for the whole
+ * resize. Lookups search both tables and never move any entry.
+ *
+ * @param [in] hashtable: The cl_hashtable_t object.
+ * @param [in] slots_per_operation: The number of slots moved by each call or
+ *                                  0 to go back to the blocking mode, which
+ *                                  also finishes a pending resize.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_hashtable_set_incremental_resize(cl_hashtable_t *hashtable,
+                                        unsigned int slots_per_operation);
+
+/**
+ * @name cl_hashtable_stats
+ * @brief Gets the internal counters of a hash table.
+ *
+ * @param [in] hashtable: The cl_hashtable_t object.
+ * @param [out] stats: The structure where the counters will be stored.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_hashtable_stats(cl_hashtable_t *hashtable,
+                       struct cl_hashtable_stats_s *stats);
+
+/**
+ * @name cl_hashtable_put_bytes
+ * @brief Maps a key of \a size bytes to the specified value in the hashtable.
+ *
+ * Keys are compared by their bytes, so a string key is the same as its bytes
+ * key without the '\0'.
+ *
+ * @param [in] hashtable: The cl_hashtable_t object.
+ * @param [in] key: The hash table key.
+ * @param [in] size: The key size in bytes.
+ * @param [in] data: The value.
+ *
+ * @return The same as cl_hashtable_put.
+ */
+void *cl_hashtable_put_bytes(cl_hashtable_t *hashtable, const void *key,
+                             unsigned int size, void *data);
+
+/**
+ * @name cl_hashtable_get_bytes
+ * @brief Gets the value to which a key of \a size bytes is mapped.
+ *
+ * @param [in] hashtable: The cl_hashtable_t object.
+ * @param [in] key: The key whose associated value is to be returned.
+ * @param [in] size: The key size in bytes.
+ *
+ * @return On success returns the value or NULL otherwise.
+ */
+void *cl_hashtable_get_bytes(cl_hashtable_t *hashtable, const void *key,
+                             unsigned int size);
+
+/**
+ * @name cl_hashtable_delete_bytes
+ * @brief Removes a key of \a size bytes, and its value, from the hash table.
+ *
+ * @param [in] hashtable: The cl_hashtable_t object.
+ * @param [in] key: The key that needs to be removed.
+ * @param [in] size: The key size in bytes.
+ *
+ * @return On success returns 0 or -1 if the key was not found.
+ */
+int cl_hashtable_delete_bytes(cl_hashtable_t *hashtable, const void *key,
+                              unsigned int size);
+
+/**
+ * @name cl_hashtable_contains_key_bytes
+ * @brief Tests if a key of \a size bytes is a key in this hash table.
+ *
+ * @param [in] hashtable: The cl_hashtable_t object.
+ * @param [in] key: Possible key.
+ * @param [in] size: The key size in bytes.
+ *
+ * @return Returns true if the key is inside the hash table or false
+ *         otherwise.
+ */
+bool cl_hashtable_contains_key_bytes(cl_hashtable_t *hashtable,
+                                     const void *key, unsigned int size);
+
+/**
+ * @name cl_hashtable_put_ullong
+ * @brief Maps an integer key to the specified value in the hashtable.
+ *
+ * Integer keys are stored inside the table itself, using no extra memory,
+ * and never match a string or bytes key.
+ *
+ * @param [in] hashtable: The cl_hashtable_t object.
+ * @param [in] key: The hash table key.
+ * @param [in] data: The value.
+ *
+ * @return The same as cl_hashtable_put.
+ */
+void *cl_hashtable_put_ullong(cl_hashtable_t *hashtable,
+                              unsigned long long key, void *data);
+
+/**
+ * @name cl_hashtable_get_ullong
+ * @brief Gets the value to which an integer key is mapped.
+ *
+ * @param [in] hashtable: The cl_hashtable_t object.
+ * @param [in] key: The key whose associated value is to be returned.
+ *
+ * @return On success returns the value or NULL otherwise.
+ */
+void *cl_hashtable_get_ullong(cl_hashtable_t *hashtable,
+                              unsigned long long key);
+
+/**
+ * @name cl_hashtable_delete_ullong
+ * @brief Removes an integer key, and its value, from the hash table.
+ *
+ * @param [in] hashtable: The cl_hashtable_t object.
+ * @param [in] key: The key that needs to be removed.
+ *
+ * @return On success returns 0 or -1 if the key was not found.
+ */
+int cl_hashtable_delete_ullong(cl_hashtable_t *hashtable,
+                               unsigned long long key);
+
+/**
+ * @name cl_hashtable_contains_key_ullong
+ * @brief Tests if an integer is a key in this hash table.
+ *
+ * @param [in] hashtable: The cl_hashtable_t object.
+ * @param [in] key: Possible key.
+ *
+ * @return Returns true if the key is inside the hash table or false
+ *         otherwise.
+ */
+bool cl_hashtable_contains_key_ullong(cl_hashtable_t *hashtable,
+                                      unsigned long long key);
+
+/**
+ * @name cl_hashtable_set_key_functions
+ * @brief Replaces the functions used to hash and compare string and bytes
+ *        keys.
+ *
+ * The \a hash function receives a key and its size in bytes, and \a equals
+ * two keys of the same size, returning true if they are equal. Passing NULL
+ * restores the internal function. Integer keys are not affected.
+ *
+ * This can only be done while the hash table is empty.
+ *
+ * @param [in] hashtable: The cl_hashtable_t object.
+ * @param [in] hash: The hash function.
+ * @param [in] equals: The comparison function.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_hashtable_set_key_functions(cl_hashtable_t *hashtable,
+                                   unsigned long long (*hash)(const void *,
+                                                              unsigned int),
+                                   bool (*equals)(const void *, const void *,
+                                                  unsigned int));
+
 #endif
 
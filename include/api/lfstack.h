@@ -0,0 +1,147 @@
+
+/*
+ * Description: API to handle a lock-free stack shared between several
+ *              threads.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 18:20:37 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef _COLLECTIONS_API_LFSTACK_H
+#define _COLLECTIONS_API_LFSTACK_H          1
+
+#ifndef LIBCOLLECTIONS_COMPILE
+# ifndef _COLLECTIONS_H
+#  error "Never use <lfstack.h> directly; include <collections.h> instead."
+# endif
+#endif
+
+/**
+ * @name cl_lfstack_ref
+ * @brief Increases the reference count of a cl_lfstack_t object.
+ *
+ * @param [in] stack: The cl_lfstack_t object.
+ *
+ * @return On success returns the item itself with its reference count
+ *         increased or NULL otherwise.
+ */
+cl_lfstack_t *cl_lfstack_ref(cl_lfstack_t *stack);
+
+/**
+ * @name cl_lfstack_unref
+ * @brief Decreases the reference count for a cl_lfstack_t object.
+ *
+ * When its reference count drops to 0, the item is finalized (its memory is
+ * freed).
+ *
+ * @param [in] stack: The cl_lfstack_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_lfstack_unref(cl_lfstack_t *stack);
+
+/**
+ * @name cl_lfstack_create
+ * @brief Creates a stack to be used by several threads at once.
+ *
+ * Pushing and popping elements never takes a lock. An unbounded stack only
+ * takes one when it needs to allocate more room, which becomes rarer as it
+ * grows, since the memory is reused and only released with the stack.
+ *
+ * A bounded stack allocates all its room at once and refuses new elements
+ * when full, instead of dropping the oldest one like a cl_cstack_t does.
+ *
+ * Popped elements are handed out as cl_stack_node_t, so their contents are
+ * reached and released with the cl_stack_node_t API. Contents left inside
+ * the stack when it is released are released the same way.
+ *
+ * Functions of this object do not hold a reference to it while running, so
+ * the caller must keep one of its own while sharing it between threads.
+ *
+ * @param [in] capacity: The maximum number of elements or 0 for an
+ *                       unbounded stack.
+ * @param [in] free_data: An optional function to release the contents.
+ *
+ * @return On success returns a cl_lfstack_t object or NULL otherwise.
+ */
+cl_lfstack_t *cl_lfstack_create(unsigned int capacity,
+                                void (*free_data)(void *));
+
+/**
+ * @name cl_lfstack_destroy
+ * @brief Releases a cl_lfstack_t object from memory.
+ *
+ * @param [in] stack: The cl_lfstack_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_lfstack_destroy(cl_lfstack_t *stack);
+
+/**
+ * @name cl_lfstack_push
+ * @brief Inserts an element at the top of the stack.
+ *
+ * @param [in] stack: The cl_lfstack_t object.
+ * @param [in] node_content: The element, which can't be NULL.
+ * @param [in] size: The element size.
+ *
+ * @return Returns true if the element was inserted or false if the stack is
+ *         full or an error occurred.
+ */
+bool cl_lfstack_push(cl_lfstack_t *stack, const void *node_content,
+                     unsigned int size);
+
+/**
+ * @name cl_lfstack_pop
+ * @brief Removes the element at the top of the stack.
+ *
+ * @param [in] stack: The cl_lfstack_t object.
+ *
+ * @return Returns a cl_stack_node_t holding the element, which must be
+ *         released with cl_stack_node_unref, or NULL if the stack is empty
+ *         or an error occurred.
+ */
+cl_stack_node_t *cl_lfstack_pop(cl_lfstack_t *stack);
+
+/**
+ * @name cl_lfstack_size
+ * @brief Gets the number of elements inside the stack.
+ *
+ * While other threads are using the stack this is only a snapshot.
+ *
+ * @param [in] stack: The cl_lfstack_t object.
+ *
+ * @return On success returns the number of elements or -1 otherwise.
+ */
+int cl_lfstack_size(cl_lfstack_t *stack);
+
+/**
+ * @name cl_lfstack_is_empty
+ * @brief Checks if the stack is empty or not.
+ *
+ * @param [in] stack: The cl_lfstack_t object.
+ *
+ * @return Returns true if the stack is empty or false otherwise.
+ */
+bool cl_lfstack_is_empty(cl_lfstack_t *stack);
+
+#endif
+
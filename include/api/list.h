@@ -33,6 +33,20 @@
 # endif
 #endif
 
+/** Options to create lists, queues and stacks */
+enum cl_list_flags {
+    CL_LIST_NODE_POOL       = (1 << 0),
+    CL_LIST_INLINE_CONTENT  = (1 << 1)
+};
+
+/** Counters of a node pool */
+struct cl_list_pool_stats_s {
+    unsigned long long  hits;
+    unsigned long long  misses;
+    unsigned int        free_nodes;
+    unsigned int        allocated_nodes;
+};
+
 /**
  * @name cl_list_node_content
  * @brief A function to retrieve the content of a list node.
@@ -121,6 +135,12 @@ int cl_list_unref(cl_list_t *list);
  * pass the arguments \a free_data, \a compare_to and \a equals, since them can
  * exist inside a cobject_t object.
  *
+ * A list may be shared between threads. Functions that only read it, like
+ * the _map_ ones, cl_list_at or _contains, run at the same time and see the
+ * list as it was when they started, while functions that change it run
+ * alone, ahead of any reader still waiting. So the functions called by the
+ * _map_ ones must not call any function of the list they are walking.
+ *
  * @param [in] free_data: The free_data function pointer.
  * @param [in] compare_to: The compare_to function pointer.
  * @param [in] filter: The filter function pointer.
@@ -133,6 +153,45 @@ cl_list_t *cl_list_create(void (*free_data)(void *),
                           int (*filter)(cl_list_node_t *, void *),
                           int (*equals)(cl_list_node_t *, cl_list_node_t *));
 
+/**
+ * @name cl_list_create_ex
+ * @brief Creates a new list object with extra options.
+ *
+ * This is the same as cl_list_create, with \a flags to change how the list
+ * works internally. It may be a combination of the following values:
+ *
+ * CL_LIST_NODE_POOL: nodes are taken from a pool owned by the list, and
+ *                    given back to it when released, instead of being
+ *                    allocated one at a time.
+ *
+ * CL_LIST_INLINE_CONTENT: the content given when inserting an element is
+ *                         copied, \a size bytes of it, inside the same
+ *                         allocation as its node, so the caller may
+ *                         reuse or release its own copy right after.
+ *                         \a free_data, if any, receives the copy and
+ *                         must only release what it points to, and
+ *                         contents are never released otherwise. This
+ *                         can't be combined with CL_LIST_NODE_POOL.
+ *
+ * Structures which start with their own prev and next pointers need no node
+ * at all, and can be linked with the cl_dll_ functions instead.
+ *
+ * @param [in] free_data: The free_data function pointer.
+ * @param [in] compare_to: The compare_to function pointer.
+ * @param [in] filter: The filter function pointer.
+ * @param [in] equals: The equals function pointer.
+ * @param [in] flags: The list options.
+ *
+ * @return On success a void object will be returned or NULL otherwise.
+ */
+cl_list_t *cl_list_create_ex(void (*free_data)(void *),
+                             int (*compare_to)(cl_list_node_t *,
+                                               cl_list_node_t *),
+                             int (*filter)(cl_list_node_t *, void *),
+                             int (*equals)(cl_list_node_t *,
+                                           cl_list_node_t *),
+                             unsigned int flags);
+
 /**
  * @name cl_list_destroy
  * @brief Releases a void from memory.
@@ -201,6 +260,39 @@ cl_list_node_t *cl_list_shift(cl_list_t *list);
  */
 int cl_list_unshift(cl_list_t *list, const void *node_content, unsigned int size);
 
+/**
+ * @name cl_list_push_many
+ * @brief Pushes several new nodes onto the list at once.
+ *
+ * The list is left as if cl_list_push was called for every element, in the
+ * array order, but it is validated and locked only once and the new nodes
+ * are linked to it in a single step. If a node can't be created nothing is
+ * inserted.
+ *
+ * @param [in,out] list: The list object.
+ * @param [in] contents: The array with the contents of the new nodes.
+ * @param [in] size: The size in bytes of every content.
+ * @param [in] count: The number of elements of the array.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_list_push_many(cl_list_t *list, void **contents, unsigned int size,
+                      unsigned int count);
+
+/**
+ * @name cl_list_splice
+ * @brief Moves all nodes of a list onto the far end of another one.
+ *
+ * The nodes are moved in constant time, whatever their number, and  other
+ * is left empty.
+ *
+ * @param [in,out] list: The list object which receives the nodes.
+ * @param [in,out] other: The list object whose nodes will be moved.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_list_splice(cl_list_t *list, cl_list_t *other);
+
 /**
  * @name cl_list_map
  * @brief Maps a function to every node on a list.
@@ -209,6 +301,10 @@ int cl_list_unshift(cl_list_t *list, const void *node_content, unsigned int size
  * \a data. Its prototype must be something of this type:
  * int foo(cl_list_node_t *, void *);
  *
+ * The nodes visited are those inside the list when the call starts, and
+ * \a foo runs with the list unlocked, so it may use the list, even to
+ * change it. This holds for every map function of the list.
+ *
  * On a successful call the node reference must be 'unreferenced'.
  *
  * @param [in] list: The list object.
@@ -467,6 +563,47 @@ int cl_list_set_filter(const cl_list_t *list,
 int cl_list_set_equals(const cl_list_t *list,
                        int (*equals)(cl_list_node_t *, cl_list_node_t *));
 
+/**
+ * @name cl_list_set_sort_threshold
+ * @brief Sets the list size from which cl_list_sort uses several threads.
+ *
+ * Lists at least this large are split in parts sorted by different threads
+ * and merged back, also in parallel. The compare_to function must then be
+ * safe to be called from several threads at once. The default, 0, always
+ * sorts in the caller thread.
+ *
+ * @param [in] list: The list object.
+ * @param [in] threshold: The minimum size or 0 to disable it.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_list_set_sort_threshold(const cl_list_t *list, unsigned int threshold);
+
+/**
+ * @name cl_list_set_bloom_filter
+ * @brief Enables or disables the membership filter of a list.
+ *
+ * The filter is a counting Bloom filter kept up to date as elements enter
+ * and leave the list. It lets cl_list_contains, cl_list_indexof and
+ * cl_list_last_indexof answer for most absent elements without walking the
+ * list, at the cost of hashing every inserted or removed element and around
+ * 8 bytes of memory per element.
+ *
+ * The \a hash function must return the same value for every two elements
+ * that the list comparison considers equal, so it can't be NULL when the
+ * filter is enabled. Elements must not be changed while inside a filtered
+ * list.
+ *
+ * @param [in] list: The list object.
+ * @param [in] enabled: A boolean flag to enable or disable the filter.
+ * @param [in] hash: The function to hash an element. Ignored when the
+ *                   filter is disabled.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_list_set_bloom_filter(const cl_list_t *list, bool enabled,
+                             unsigned long long (*hash)(cl_list_node_t *));
+
 /**
  * @name cl_list_middle
  * @brief Gives the element from the middle of the list.
@@ -488,5 +625,102 @@ cl_list_node_t *cl_list_middle(const cl_list_t *list);
  */
 int cl_list_rotate(cl_list_t *list, unsigned int n);
 
-#endif
+/**
+ * @name cl_list_pool_stats
+ * @brief Gets the counters of the node pool of a list.
+ *
+ * A hit is a node reused from the pool and a miss is a node requested while
+ * the pool was empty, which makes it allocate a new set of nodes. All
+ * counters are zero if the list was not created with CL_LIST_NODE_POOL.
+ *
+ * @param [in] list: The list object.
+ * @param [out] stats: The structure where the counters will be stored.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_list_pool_stats(const cl_list_t *list, struct cl_list_pool_stats_s *stats);
+
+/**
+ * @name cl_list_iter_begin
+ * @brief Starts walking a list with a cursor.
+ *
+ * The cursor starts before the first node and walks the nodes the list held
+ * when it was created. Each of them is kept alive until cl_list_iter_end, so
+ * the nodes and contents it hands out are borrowed, without taking any
+ * reference at each step, and remain valid until then even if they leave
+ * the list. The list is not locked while the cursor exists, so it may be
+ * used and changed meanwhile, but those changes are not seen by the cursor,
+ * which must not be passed to another thread.
+ *
+ * @param [in] list: The list object.
+ *
+ * @return On success returns a cl_list_iter_t object or NULL otherwise.
+ */
+cl_list_iter_t *cl_list_iter_begin(const cl_list_t *list);
+
+/**
+ * @name cl_list_iter_end
+ * @brief Finishes a walk started by cl_list_iter_begin.
+ *
+ * Every node and content handed out by the cursor becomes invalid, except
+ * those retained with cl_list_iter_retain.
+ *
+ * @param [in] iter: The cl_list_iter_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_list_iter_end(cl_list_iter_t *iter);
 
+/**
+ * @name cl_list_iter_next
+ * @brief Moves the cursor to the next node of the list.
+ *
+ * @param [in] iter: The cl_list_iter_t object.
+ *
+ * @return Returns the borrowed node or NULL when the cursor goes past the
+ *         last node.
+ */
+cl_list_node_t *cl_list_iter_next(cl_list_iter_t *iter);
+
+/**
+ * @name cl_list_iter_prev
+ * @brief Moves the cursor to the previous node of the list.
+ *
+ * Once past the last node, this moves the cursor back to it, so a list can
+ * also be walked from its end.
+ *
+ * @param [in] iter: The cl_list_iter_t object.
+ *
+ * @return Returns the borrowed node or NULL when the cursor goes before the
+ *         first node.
+ */
+cl_list_node_t *cl_list_iter_prev(cl_list_iter_t *iter);
+
+/**
+ * @name cl_list_iter_content
+ * @brief Gets the content of the node under the cursor.
+ *
+ * Unlike cl_list_node_content, no reference is taken even when the content
+ * is a cl_object_t.
+ *
+ * @param [in] iter: The cl_list_iter_t object.
+ *
+ * @return On success returns the borrowed content or NULL otherwise.
+ */
+void *cl_list_iter_content(const cl_list_iter_t *iter);
+
+/**
+ * @name cl_list_iter_retain
+ * @brief Takes a reference to the node under the cursor.
+ *
+ * This is the way to keep a node after cl_list_iter_end. The reference must
+ * be released with cl_list_node_unref.
+ *
+ * @param [in] iter: The cl_list_iter_t object.
+ *
+ * @return On success returns the node with a new reference or NULL
+ *         otherwise.
+ */
+cl_list_node_t *cl_list_iter_retain(const cl_list_iter_t *iter);
+
+#endif
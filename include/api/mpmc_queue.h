@@ -0,0 +1,233 @@
+
+/*
+ * Description: API to handle a bounded queue shared between several
+ *              producer and consumer threads.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 16:12:40 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef _COLLECTIONS_API_MPMC_QUEUE_H
+#define _COLLECTIONS_API_MPMC_QUEUE_H          1
+
+#ifndef LIBCOLLECTIONS_COMPILE
+# ifndef _COLLECTIONS_H
+#  error "Never use <mpmc_queue.h> directly; include <collections.h> instead."
+# endif
+#endif
+
+/**
+ * @name cl_mpmc_queue_ref
+ * @brief Increases the reference count of a cl_mpmc_queue_t object.
+ *
+ * @param [in] queue: The cl_mpmc_queue_t object.
+ *
+ * @return On success returns the item itself with its reference count
+ *         increased or NULL otherwise.
+ */
+cl_mpmc_queue_t *cl_mpmc_queue_ref(cl_mpmc_queue_t *queue);
+
+/**
+ * @name cl_mpmc_queue_unref
+ * @brief Decreases the reference count for a cl_mpmc_queue_t object.
+ *
+ * When its reference count drops to 0, the item is finalized (its memory is
+ * freed).
+ *
+ * @param [in] queue: The cl_mpmc_queue_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_mpmc_queue_unref(cl_mpmc_queue_t *queue);
+
+/**
+ * @name cl_mpmc_queue_create
+ * @brief Creates a bounded queue to be used by several threads at once.
+ *
+ * The elements are kept inside a preallocated ring and neither enqueuing nor
+ * dequeuing takes a lock or allocates memory. Only the blocking functions
+ * may sleep, and only when the queue is full or empty.
+ *
+ * Like a cl_queue_t, the queue holds the contents themselves. When released
+ * with elements still inside it, they are released using \a free_data or,
+ * if it's NULL, the same way a cl_queue_t releases its nodes contents.
+ *
+ * Functions of this object do not hold a reference to it while running, so
+ * the caller must keep one of its own while sharing it between threads.
+ *
+ * @param [in] capacity: The maximum number of elements, rounded up to a
+ *                       power of 2.
+ * @param [in] free_data: An optional function to release the contents left
+ *                        inside the queue.
+ *
+ * @return On success returns a cl_mpmc_queue_t object or NULL otherwise.
+ */
+cl_mpmc_queue_t *cl_mpmc_queue_create(unsigned int capacity,
+                                      void (*free_data)(void *));
+
+/**
+ * @name cl_mpmc_queue_destroy
+ * @brief Releases a cl_mpmc_queue_t object from memory.
+ *
+ * @param [in] queue: The cl_mpmc_queue_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_mpmc_queue_destroy(cl_mpmc_queue_t *queue);
+
+/**
+ * @name cl_mpmc_queue_try_enqueue
+ * @brief Inserts an element at the end of the queue, if there is room for it.
+ *
+ * @param [in] queue: The cl_mpmc_queue_t object.
+ * @param [in] node_content: The element, which can't be NULL.
+ * @param [in] size: The element size.
+ *
+ * @return Returns true if the element was inserted or false if the queue is
+ *         full or an error occurred.
+ */
+bool cl_mpmc_queue_try_enqueue(cl_mpmc_queue_t *queue,
+                               const void *node_content, unsigned int size);
+
+/**
+ * @name cl_mpmc_queue_enqueue
+ * @brief Inserts an element at the end of the queue, waiting while it is
+ *        full.
+ *
+ * @param [in] queue: The cl_mpmc_queue_t object.
+ * @param [in] node_content: The element, which can't be NULL.
+ * @param [in] size: The element size.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_mpmc_queue_enqueue(cl_mpmc_queue_t *queue, const void *node_content,
+                          unsigned int size);
+
+/**
+ * @name cl_mpmc_queue_try_dequeue
+ * @brief Removes the element at the front of the queue, if any.
+ *
+ * @param [in] queue: The cl_mpmc_queue_t object.
+ *
+ * @return Returns the element, which is now under the caller responsibility,
+ *         or NULL if the queue is empty or an error occurred.
+ */
+void *cl_mpmc_queue_try_dequeue(cl_mpmc_queue_t *queue);
+
+/**
+ * @name cl_mpmc_queue_dequeue
+ * @brief Removes the element at the front of the queue, waiting while it is
+ *        empty.
+ *
+ * @param [in] queue: The cl_mpmc_queue_t object.
+ *
+ * @return Returns the element, which is now under the caller responsibility,
+ *         or NULL if an error occurred.
+ */
+void *cl_mpmc_queue_dequeue(cl_mpmc_queue_t *queue);
+
+/**
+ * @name cl_mpmc_queue_try_enqueue_batch
+ * @brief Inserts as many elements of an array as there is room for, at once.
+ *
+ * The inserted elements are always the first ones of the array and stay
+ * together inside the queue.
+ *
+ * @param [in] queue: The cl_mpmc_queue_t object.
+ * @param [in] contents: The array of elements, which can't be NULL.
+ * @param [in] size: The size of every element.
+ * @param [in] count: The number of elements of the array.
+ *
+ * @return On success returns the number of inserted elements or -1
+ *         otherwise.
+ */
+int cl_mpmc_queue_try_enqueue_batch(cl_mpmc_queue_t *queue,
+                                    void **contents, unsigned int size,
+                                    unsigned int count);
+
+/**
+ * @name cl_mpmc_queue_enqueue_batch
+ * @brief Inserts all elements of an array, waiting while the queue is full.
+ *
+ * @param [in] queue: The cl_mpmc_queue_t object.
+ * @param [in] contents: The array of elements, which can't be NULL.
+ * @param [in] size: The size of every element.
+ * @param [in] count: The number of elements of the array.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_mpmc_queue_enqueue_batch(cl_mpmc_queue_t *queue, void **contents,
+                                unsigned int size, unsigned int count);
+
+/**
+ * @name cl_mpmc_queue_try_dequeue_batch
+ * @brief Removes up to \a count elements from the front of the queue, at
+ *        once.
+ *
+ * @param [in] queue: The cl_mpmc_queue_t object.
+ * @param [out] contents: An array to store the removed elements.
+ * @param [in] count: The number of elements the array can hold.
+ *
+ * @return On success returns the number of removed elements, which may be 0,
+ *         or -1 otherwise.
+ */
+int cl_mpmc_queue_try_dequeue_batch(cl_mpmc_queue_t *queue, void **contents,
+                                    unsigned int count);
+
+/**
+ * @name cl_mpmc_queue_dequeue_batch
+ * @brief Removes up to \a count elements from the front of the queue, waiting
+ *        while it is empty.
+ *
+ * @param [in] queue: The cl_mpmc_queue_t object.
+ * @param [out] contents: An array to store the removed elements.
+ * @param [in] count: The number of elements the array can hold.
+ *
+ * @return On success returns the number of removed elements, at least one,
+ *         or -1 otherwise.
+ */
+int cl_mpmc_queue_dequeue_batch(cl_mpmc_queue_t *queue, void **contents,
+                                unsigned int count);
+
+/**
+ * @name cl_mpmc_queue_size
+ * @brief Gets the number of elements inside the queue.
+ *
+ * While other threads are using the queue this is only a snapshot.
+ *
+ * @param [in] queue: The cl_mpmc_queue_t object.
+ *
+ * @return On success returns the number of elements or -1 otherwise.
+ */
+int cl_mpmc_queue_size(cl_mpmc_queue_t *queue);
+
+/**
+ * @name cl_mpmc_queue_is_empty
+ * @brief Checks if the queue is empty or not.
+ *
+ * @param [in] queue: The cl_mpmc_queue_t object.
+ *
+ * @return Returns true if the queue is empty or false otherwise.
+ */
+bool cl_mpmc_queue_is_empty(cl_mpmc_queue_t *queue);
+
+#endif
+
@@ -0,0 +1,306 @@
+
+/*
+ * Description: API to handle maps whose keys are kept in order.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 20:31:06 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef _COLLECTIONS_API_ORDMAP_H
+#define _COLLECTIONS_API_ORDMAP_H          1
+
+#ifndef LIBCOLLECTIONS_COMPILE
+# ifndef _COLLECTIONS_H
+#  error "Never use <ordmap.h> directly; include <collections.h> instead."
+# endif
+#endif
+
+/** Lookups done by cl_ordmap_visit */
+enum cl_ordmap_seek {
+    CL_ORDMAP_EXACT,
+    CL_ORDMAP_FLOOR,
+    CL_ORDMAP_CEILING,
+    CL_ORDMAP_FIRST,
+    CL_ORDMAP_LAST
+};
+
+/**
+ * @name cl_ordmap_ref
+ * @brief Increases the reference count of a cl_ordmap_t object.
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ *
+ * @return On success returns the item itself with its reference count
+ *         increased or NULL otherwise.
+ */
+cl_ordmap_t *cl_ordmap_ref(cl_ordmap_t *map);
+
+/**
+ * @name cl_ordmap_unref
+ * @brief Decreases the reference count for a cl_ordmap_t object.
+ *
+ * When its reference count drops to 0, the item is finalized (its memory is
+ * freed).
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_ordmap_unref(cl_ordmap_t *map);
+
+/**
+ * @name cl_ordmap_create
+ * @brief Creates a map which keeps its keys sorted.
+ *
+ * The keys are kept inside a skip list, so inserting, removing and looking
+ * up a key, including the nearest one to a key that is not there, take
+ * O(log n) comparisons on average.
+ *
+ * Once inserted, keys and values belong to the map and are released with
+ * \a free_key and \a free_value when removed or when the map is released.
+ * When one of them is NULL the respective pointers are never released.
+ *
+ * A map created with \a thread_safe may be used by several threads at once.
+ * Lookups and iterations share a read lock while insertions and removals
+ * take it exclusively. Functions of this object do not hold a reference to
+ * it while running, so the caller must keep one of its own while sharing it
+ * between threads.
+ *
+ * The keys and values handed out by the lookup functions still belong to the
+ * map, and another thread may release them as soon as the lock is gone. A
+ * shared map should be read with cl_ordmap_visit or cl_ordmap_map_range,
+ * which run a function while the lock is held.
+ *
+ * @param [in] compare_to: The function to compare two keys. It must return
+ *                         a negative number, 0 or a positive number if the
+ *                         first key is lower, equal to or greater than the
+ *                         second one.
+ * @param [in] free_key: An optional function to release the keys.
+ * @param [in] free_value: An optional function to release the values.
+ * @param [in] thread_safe: A boolean flag to indicate if the map will be
+ *                          shared between threads or not.
+ *
+ * @return On success returns a cl_ordmap_t object or NULL otherwise.
+ */
+cl_ordmap_t *cl_ordmap_create(int (*compare_to)(const void *, const void *),
+                              void (*free_key)(void *),
+                              void (*free_value)(void *),
+                              bool thread_safe);
+
+/**
+ * @name cl_ordmap_destroy
+ * @brief Releases a cl_ordmap_t object from memory.
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_ordmap_destroy(cl_ordmap_t *map);
+
+/**
+ * @name cl_ordmap_put
+ * @brief Maps a key to a value.
+ *
+ * If the key already exists its previous value is released and replaced by
+ * \a value. The stored key is kept and \a key is released, since both
+ * belong to the map.
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ * @param [in] key: The key, which can't be NULL.
+ * @param [in] value: The value.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_ordmap_put(cl_ordmap_t *map, void *key, void *value);
+
+/**
+ * @name cl_ordmap_get
+ * @brief Gets the value to which a key is mapped.
+ *
+ * The value is valid only until the key is removed or mapped to another one.
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ * @param [in] key: The key whose value is to be returned.
+ *
+ * @return On success returns the value or NULL otherwise.
+ */
+void *cl_ordmap_get(cl_ordmap_t *map, const void *key);
+
+/**
+ * @name cl_ordmap_delete
+ * @brief Removes a key, and its value, from the map.
+ *
+ * Both are released the same way as when the map is released.
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ * @param [in] key: The key that needs to be removed.
+ *
+ * @return On success returns 0 or -1 if the key was not found.
+ */
+int cl_ordmap_delete(cl_ordmap_t *map, const void *key);
+
+/**
+ * @name cl_ordmap_contains_key
+ * @brief Tests if a key is inside the map.
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ * @param [in] key: The key.
+ *
+ * @return Returns true if the key is inside the map or false otherwise.
+ */
+bool cl_ordmap_contains_key(cl_ordmap_t *map, const void *key);
+
+/**
+ * @name cl_ordmap_size
+ * @brief Gets the number of keys inside the map.
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ *
+ * @return On success returns the number of keys or -1 otherwise.
+ */
+int cl_ordmap_size(cl_ordmap_t *map);
+
+/**
+ * @name cl_ordmap_is_empty
+ * @brief Checks if the map is empty or not.
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ *
+ * @return Returns true if the map is empty or false otherwise.
+ */
+bool cl_ordmap_is_empty(cl_ordmap_t *map);
+
+/**
+ * @name cl_ordmap_floor
+ * @brief Finds the greatest key lower than or equal to a key.
+ *
+ * The returned key and value point to the map internal storage and are
+ * valid only until the key is removed from it or mapped to another value.
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ * @param [in] key: The key to look for.
+ * @param [out] value: An optional pointer to store the found key value.
+ *
+ * @return On success returns the found key or NULL otherwise.
+ */
+const void *cl_ordmap_floor(cl_ordmap_t *map, const void *key, void **value);
+
+/**
+ * @name cl_ordmap_ceiling
+ * @brief Finds the lowest key greater than or equal to a key.
+ *
+ * The returned key and value point to the map internal storage and are
+ * valid only until the key is removed from it or mapped to another value.
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ * @param [in] key: The key to look for.
+ * @param [out] value: An optional pointer to store the found key value.
+ *
+ * @return On success returns the found key or NULL otherwise.
+ */
+const void *cl_ordmap_ceiling(cl_ordmap_t *map, const void *key,
+                              void **value);
+
+/**
+ * @name cl_ordmap_first
+ * @brief Gets the lowest key of the map.
+ *
+ * The returned key and value point to the map internal storage and are
+ * valid only until the key is removed from it or mapped to another value.
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ * @param [out] value: An optional pointer to store the key value.
+ *
+ * @return On success returns the key or NULL if the map is empty.
+ */
+const void *cl_ordmap_first(cl_ordmap_t *map, void **value);
+
+/**
+ * @name cl_ordmap_last
+ * @brief Gets the greatest key of the map.
+ *
+ * The returned key and value point to the map internal storage and are
+ * valid only until the key is removed from it or mapped to another value.
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ * @param [out] value: An optional pointer to store the key value.
+ *
+ * @return On success returns the key or NULL if the map is empty.
+ */
+const void *cl_ordmap_last(cl_ordmap_t *map, void **value);
+
+/**
+ * @name cl_ordmap_map_range
+ * @brief Maps a function to every key inside a range, in order.
+ *
+ * The \a foo function receives as arguments a key, its value and some
+ * \a data. Its prototype must be something of this type:
+ * int foo(const void *, void *, void *);
+ *
+ * Both range limits are inclusive and any of them may be NULL, to leave that
+ * side of the range open. The map must not be changed from inside \a foo.
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ * @param [in] from: The lowest key of the range.
+ * @param [in] to: The greatest key of the range.
+ * @param [in] reverse: A boolean flag to walk the range from the greatest key
+ *                      to the lowest one.
+ * @param [in] foo: The function.
+ * @param [in] data: The custom data passed to the map function.
+ *
+ * @return If \a foo returns a non-zero returns the current key. If not
+ *         returns NULL.
+ */
+const void *cl_ordmap_map_range(cl_ordmap_t *map, const void *from,
+                                const void *to, bool reverse,
+                                int (*foo)(const void *, void *, void *),
+                                void *data);
+
+/**
+ * @name cl_ordmap_visit
+ * @brief Runs a function over the key found by a lookup.
+ *
+ * The \a foo function receives as arguments the found key, its value and
+ * some \a data, while the map is still locked, so it may safely read or copy
+ * them even if other threads change the map. Its prototype must be something
+ * of this type:
+ * void foo(const void *, void *, void *);
+ *
+ * With CL_ORDMAP_EXACT the key must be equal to \a key, while
+ * CL_ORDMAP_FLOOR and CL_ORDMAP_CEILING find the nearest one as
+ * cl_ordmap_floor and cl_ordmap_ceiling do. CL_ORDMAP_FIRST and
+ * CL_ORDMAP_LAST ignore \a key and find the lowest and the greatest key.
+ * The map must not be changed from inside \a foo.
+ *
+ * @param [in] map: The cl_ordmap_t object.
+ * @param [in] key: The key to look for.
+ * @param [in] seek: The kind of lookup.
+ * @param [in] foo: The function.
+ * @param [in] data: The custom data passed to the function.
+ *
+ * @return Returns 0 if a key was found and \a foo called or -1 otherwise.
+ */
+int cl_ordmap_visit(cl_ordmap_t *map, const void *key,
+                    enum cl_ordmap_seek seek,
+                    void (*foo)(const void *, void *, void *), void *data);
+
+#endif
+
@@ -0,0 +1,267 @@
+
+/*
+ * Description: API to handle priority queues.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 21:14:27 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef _COLLECTIONS_API_PQUEUE_H
+#define _COLLECTIONS_API_PQUEUE_H          1
+
+#ifndef LIBCOLLECTIONS_COMPILE
+# ifndef _COLLECTIONS_H
+#  error "Never use <pqueue.h> directly; include <collections.h> instead."
+# endif
+#endif
+
+/**
+ * @name cl_pqueue_ref
+ * @brief Increases the reference count of a cl_pqueue_t object.
+ *
+ * @param [in] pqueue: The cl_pqueue_t object.
+ *
+ * @return On success returns the item itself with its reference count
+ *         increased or NULL otherwise.
+ */
+cl_pqueue_t *cl_pqueue_ref(cl_pqueue_t *pqueue);
+
+/**
+ * @name cl_pqueue_unref
+ * @brief Decreases the reference count for a cl_pqueue_t object.
+ *
+ * When its reference count drops to 0, the item is finalized (its memory is
+ * freed).
+ *
+ * @param [in] pqueue: The cl_pqueue_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_pqueue_unref(cl_pqueue_t *pqueue);
+
+/**
+ * @name cl_pqueue_create
+ * @brief Creates a priority queue.
+ *
+ * The elements are kept inside an array organized as a heap where every
+ * element has up to \a arity children, so inserting and removing one takes
+ * O(log n) comparisons. Wider heaps are shallower and friendlier to the
+ * cache, at the cost of more comparisons per level.
+ *
+ * The elements are stored inside cl_list_node_t nodes and \a compare_to
+ * receives them, so the comparison functions written for a cl_list_t can be
+ * used here too. The element for which \a compare_to returns a negative
+ * number when compared to all the others is the first one to leave the
+ * queue.
+ *
+ * A queue created with \a thread_safe may be used by several threads at
+ * once. Functions of this object do not hold a reference to it while
+ * running, so the caller must keep one of its own while sharing it between
+ * threads.
+ *
+ * @param [in] arity: The number of children of every heap element, or 0 to
+ *                    use the default of 4.
+ * @param [in] free_data: An optional function to release the elements, used
+ *                        the same way as in a cl_list_t.
+ * @param [in] compare_to: The function to compare two elements.
+ * @param [in] thread_safe: A boolean flag to indicate if the queue will be
+ *                          shared between threads or not.
+ *
+ * @return On success returns a cl_pqueue_t object or NULL otherwise.
+ */
+cl_pqueue_t *cl_pqueue_create(unsigned int arity, void (*free_data)(void *),
+                              int (*compare_to)(cl_list_node_t *,
+                                                cl_list_node_t *),
+                              bool thread_safe);
+
+/**
+ * @name cl_pqueue_destroy
+ * @brief Releases a cl_pqueue_t object from memory.
+ *
+ * @param [in] pqueue: The cl_pqueue_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_pqueue_destroy(cl_pqueue_t *pqueue);
+
+/**
+ * @name cl_pqueue_push
+ * @brief Inserts an element into the queue.
+ *
+ * The returned handle identifies the element inside the queue, to change
+ * its priority or remove it later. It comes with a reference owned by the
+ * caller, which must be released with cl_pqueue_node_unref. The handle
+ * stays valid after its element leaves the queue, popped or removed, maybe
+ * by another thread, in which case cl_pqueue_update and cl_pqueue_remove
+ * just fail with it.
+ *
+ * @param [in] pqueue: The cl_pqueue_t object.
+ * @param [in] node_content: The element.
+ * @param [in] size: The element size.
+ *
+ * @return On success returns the element handle or NULL otherwise.
+ */
+cl_pqueue_node_t *cl_pqueue_push(cl_pqueue_t *pqueue, const void *node_content,
+                                 unsigned int size);
+
+/**
+ * @name cl_pqueue_node_ref
+ * @brief Increases the reference count of an element handle.
+ *
+ * @param [in] handle: The element handle, as returned by cl_pqueue_push.
+ *
+ * @return On success returns the handle itself with its reference count
+ *         increased or NULL otherwise.
+ */
+cl_pqueue_node_t *cl_pqueue_node_ref(cl_pqueue_node_t *handle);
+
+/**
+ * @name cl_pqueue_node_unref
+ * @brief Decreases the reference count of an element handle.
+ *
+ * The handle is released once neither the caller nor the queue hold it.
+ * This does not remove its element from the queue.
+ *
+ * @param [in] handle: The element handle, as returned by cl_pqueue_push.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_pqueue_node_unref(cl_pqueue_node_t *handle);
+
+/**
+ * @name cl_pqueue_pop
+ * @brief Removes the element with the highest priority from the queue.
+ *
+ * @param [in] pqueue: The cl_pqueue_t object.
+ *
+ * @return On success returns the removed node, and the user is responsible
+ *         for releasing it, or NULL otherwise.
+ */
+cl_list_node_t *cl_pqueue_pop(cl_pqueue_t *pqueue);
+
+/**
+ * @name cl_pqueue_peek
+ * @brief Retrieves, but does not remove, the element with the highest
+ *        priority.
+ *
+ * On a successful call the node reference must be 'unreferenced'.
+ *
+ * @param [in] pqueue: The cl_pqueue_t object.
+ *
+ * @return Returns a reference to the node on success or NULL otherwise.
+ */
+cl_list_node_t *cl_pqueue_peek(cl_pqueue_t *pqueue);
+
+/**
+ * @name cl_pqueue_update
+ * @brief Restores the queue order after an element priority changed.
+ *
+ * The priority is whatever \a compare_to looks at inside the element, so the
+ * caller changes the element itself and then calls this function, which
+ * moves it up or down the heap in O(log n).
+ *
+ * Changing the element outside the queue lock races with other threads
+ * comparing it, so a queue shared between threads must use
+ * cl_pqueue_update_priority instead.
+ *
+ * @param [in] pqueue: The cl_pqueue_t object.
+ * @param [in] handle: The element handle, as returned by cl_pqueue_push.
+ *
+ * @return On success returns 0 or -1 otherwise, as when the element is not
+ *         inside the queue anymore.
+ */
+int cl_pqueue_update(cl_pqueue_t *pqueue, cl_pqueue_node_t *handle);
+
+/**
+ * @name cl_pqueue_update_priority
+ * @brief Changes an element priority and restores the queue order.
+ *
+ * The \a change function receives the element node and some \a data, and
+ * changes whatever \a compare_to looks at inside it. It runs with the queue
+ * locked, so no other thread compares the element meanwhile, and must not
+ * call any function of the queue. Its prototype must be something of this
+ * type:
+ * void change(cl_list_node_t *, void *);
+ *
+ * @param [in] pqueue: The cl_pqueue_t object.
+ * @param [in] handle: The element handle, as returned by cl_pqueue_push.
+ * @param [in] change: The function changing the element.
+ * @param [in] data: The custom data passed to the change function.
+ *
+ * @return On success returns 0 or -1 otherwise, as when the element is not
+ *         inside the queue anymore.
+ */
+int cl_pqueue_update_priority(cl_pqueue_t *pqueue, cl_pqueue_node_t *handle,
+                              void (*change)(cl_list_node_t *, void *),
+                              void *data);
+
+/**
+ * @name cl_pqueue_remove
+ * @brief Removes an element from the queue, whatever its priority.
+ *
+ * The element is released the same way as when the queue is released,
+ * while the handle is kept until its last reference is released.
+ *
+ * @param [in] pqueue: The cl_pqueue_t object.
+ * @param [in] handle: The element handle, as returned by cl_pqueue_push.
+ *
+ * @return On success returns 0 or -1 otherwise, as when the element is not
+ *         inside the queue anymore.
+ */
+int cl_pqueue_remove(cl_pqueue_t *pqueue, cl_pqueue_node_t *handle);
+
+/**
+ * @name cl_pqueue_heapify
+ * @brief Moves all the elements of a list into the queue.
+ *
+ * The list nodes themselves are moved, leaving the list empty, and the heap
+ * is rebuilt once at the end, which takes O(n) instead of the O(n log n) of
+ * pushing them one at a time. These elements have no handle.
+ *
+ * @param [in] pqueue: The cl_pqueue_t object.
+ * @param [in,out] list: The cl_list_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_pqueue_heapify(cl_pqueue_t *pqueue, cl_list_t *list);
+
+/**
+ * @name cl_pqueue_size
+ * @brief Gets the number of elements inside the queue.
+ *
+ * @param [in] pqueue: The cl_pqueue_t object.
+ *
+ * @return On success returns the number of elements or -1 otherwise.
+ */
+int cl_pqueue_size(cl_pqueue_t *pqueue);
+
+/**
+ * @name cl_pqueue_is_empty
+ * @brief Checks if the queue is empty or not.
+ *
+ * @param [in] pqueue: The cl_pqueue_t object.
+ *
+ * @return Returns true if the queue is empty or false otherwise.
+ */
+bool cl_pqueue_is_empty(cl_pqueue_t *pqueue);
+
+#endif
+
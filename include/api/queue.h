@@ -121,6 +121,12 @@ int cl_queue_unref(cl_queue_t *queue);
  * pass the arguments \a free_data, \a compare_to and \a equals, since them can
  * exist inside a cobject_t object.
  *
+ * A queue may be shared between threads. Functions that only read it, like
+ * the _map_ ones, cl_queue_at or _contains, run at the same time and see the
+ * queue as it was when they started, while functions that change it run
+ * alone, ahead of any reader still waiting. So the functions called by the
+ * _map_ ones must not call any function of the queue they are walking.
+ *
  * @param [in] free_data: The free_data function pointer.
  * @param [in] compare_to: The compare_to function pointer.
  * @param [in] filter: The filter function pointer.
@@ -135,6 +141,42 @@ cl_queue_t *cl_queue_create(void (*free_data)(void *),
                             int (*equals)(cl_queue_node_t *,
                                           cl_queue_node_t *));
 
+/**
+ * @name cl_queue_create_ex
+ * @brief Creates a new queue object with extra options.
+ *
+ * This is the same as cl_queue_create, with \a flags to change how the queue
+ * works internally. It may be a combination of the following values:
+ *
+ * CL_LIST_NODE_POOL: nodes are taken from a pool owned by the queue, and
+ *                    given back to it when released, instead of being
+ *                    allocated one at a time.
+ *
+ * CL_LIST_INLINE_CONTENT: the content given when inserting an element is
+ *                         copied, \a size bytes of it, inside the same
+ *                         allocation as its node, so the caller may
+ *                         reuse or release its own copy right after.
+ *                         \a free_data, if any, receives the copy and
+ *                         must only release what it points to, and
+ *                         contents are never released otherwise. This
+ *                         can't be combined with CL_LIST_NODE_POOL.
+ *
+ * @param [in] free_data: The free_data function pointer.
+ * @param [in] compare_to: The compare_to function pointer.
+ * @param [in] filter: The filter function pointer.
+ * @param [in] equals: The equals function pointer.
+ * @param [in] flags: The queue options.
+ *
+ * @return On success a void object will be returned or NULL otherwise.
+ */
+cl_queue_t *cl_queue_create_ex(void (*free_data)(void *),
+                               int (*compare_to)(cl_queue_node_t *,
+                                                 cl_queue_node_t *),
+                               int (*filter)(cl_queue_node_t *, void *),
+                               int (*equals)(cl_queue_node_t *,
+                                             cl_queue_node_t *),
+                               unsigned int flags);
+
 /**
  * @name cl_queue_destroy
  * @brief Releases a void from memory.
@@ -182,6 +224,39 @@ cl_queue_node_t *cl_queue_dequeue(cl_queue_t *queue);
 int cl_queue_enqueue(cl_queue_t *queue, const void *node_content,
                      unsigned int size);
 
+/**
+ * @name cl_queue_enqueue_many
+ * @brief Inserts several elements into the queue at once.
+ *
+ * The elements are inserted in the array order, validating and locking the
+ * queue only once. If a node can't be created nothing is inserted.
+ *
+ * @param [in,out] queue: The queue object.
+ * @param [in] contents: The array with the contents of the new nodes.
+ * @param [in] size: The size in bytes of every content.
+ * @param [in] count: The number of elements of the array.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_queue_enqueue_many(cl_queue_t *queue, void **contents,
+                          unsigned int size, unsigned int count);
+
+/**
+ * @name cl_queue_dequeue_many
+ * @brief Retrieves and removes up to \a count nodes from the head of the
+ *        queue at once.
+ *
+ * @param [in,out] queue: The queue object.
+ * @param [out] nodes: An array to store the removed nodes, which the user is
+ *                     responsible for releasing.
+ * @param [in] count: The number of nodes the array can hold.
+ *
+ * @return On success returns the number of removed nodes, which may be 0,
+ *         or -1 otherwise.
+ */
+int cl_queue_dequeue_many(cl_queue_t *queue, cl_queue_node_t **nodes,
+                          unsigned int count);
+
 /**
  * @name cl_queue_map
  * @brief Maps a function to every node on a queue.
@@ -449,5 +524,19 @@ int cl_queue_set_filter(const cl_queue_t *queue,
 int cl_queue_set_equals(const cl_queue_t *queue,
                         int (*equals)(cl_queue_node_t *, cl_queue_node_t *));
 
-#endif
+/**
+ * @name cl_queue_pool_stats
+ * @brief Gets the counters of the node pool of a queue.
+ *
+ * A hit is a node reused from the pool and a miss is a node requested while
+ * the pool was empty, which makes it allocate a new set of nodes. All
+ * counters are zero if the queue was not created with CL_LIST_NODE_POOL.
+ *
+ * @param [in] queue: The queue object.
+ * @param [out] stats: The structure where the counters will be stored.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_queue_pool_stats(const cl_queue_t *queue, struct cl_list_pool_stats_s *stats);
 
+#endif
@@ -0,0 +1,254 @@
+
+/*
+ * Description: API to handle radix trees keyed by strings.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 19:12:40 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef _COLLECTIONS_API_RADIX_H
+#define _COLLECTIONS_API_RADIX_H          1
+
+#ifndef LIBCOLLECTIONS_COMPILE
+# ifndef _COLLECTIONS_H
+#  error "Never use <radix.h> directly; include <collections.h> instead."
+# endif
+#endif
+
+/** Lookups done by cl_radix_visit */
+enum cl_radix_seek {
+    CL_RADIX_EXACT,
+    CL_RADIX_LONGEST_PREFIX
+};
+
+/**
+ * @name cl_radix_ref
+ * @brief Increases the reference count of a cl_radix_t object.
+ *
+ * @param [in] radix: The cl_radix_t object.
+ *
+ * @return On success returns the item itself with its reference count
+ *         increased or NULL otherwise.
+ */
+cl_radix_t *cl_radix_ref(cl_radix_t *radix);
+
+/**
+ * @name cl_radix_unref
+ * @brief Decreases the reference count for a cl_radix_t object.
+ *
+ * When its reference count drops to 0, the item is finalized (its memory is
+ * freed).
+ *
+ * @param [in] radix: The cl_radix_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_radix_unref(cl_radix_t *radix);
+
+/**
+ * @name cl_radix_create
+ * @brief Creates a radix tree mapping strings to values.
+ *
+ * The tree is an adaptive radix tree: each node branches on one byte of the
+ * keys, skips the bytes its keys share, and grows or shrinks between four
+ * layouts as its children come and go, the smaller ones fitting in a cache
+ * line. Looking up, inserting and removing a key take O(length of the key),
+ * no matter how many keys are there, and the keys are kept in byte order,
+ * so those sharing a prefix can be found together.
+ *
+ * Keys are copied into the tree. Values belong to it once inserted and are
+ * released with \a free_value when removed, replaced or when the tree is
+ * released. When \a free_value is NULL the values are never released.
+ *
+ * A tree created with \a thread_safe may be used by several threads at once.
+ * Lookups and iterations share a read lock while insertions and removals
+ * take it exclusively. Functions of this object do not hold a reference to
+ * it while running, so the caller must keep one of its own while sharing it
+ * between threads.
+ *
+ * @param [in] free_value: An optional function to release the values.
+ * @param [in] thread_safe: A boolean flag to indicate if the tree will be
+ *                          shared between threads or not.
+ *
+ * @return On success returns a cl_radix_t object or NULL otherwise.
+ */
+cl_radix_t *cl_radix_create(void (*free_value)(void *), bool thread_safe);
+
+/**
+ * @name cl_radix_destroy
+ * @brief Releases a cl_radix_t object from memory.
+ *
+ * @param [in] radix: The cl_radix_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_radix_destroy(cl_radix_t *radix);
+
+/**
+ * @name cl_radix_put
+ * @brief Maps a key to a value.
+ *
+ * If the key already exists its previous value is released and replaced by
+ * \a value.
+ *
+ * @param [in] radix: The cl_radix_t object.
+ * @param [in] key: The key, which can't be NULL.
+ * @param [in] value: The value.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_radix_put(cl_radix_t *radix, const char *key, void *value);
+
+/**
+ * @name cl_radix_get
+ * @brief Gets the value to which a key is mapped.
+ *
+ * The value is valid only until the key is removed or mapped to another one.
+ * The tree is unlocked when this function returns, so it is only safe to
+ * use the value while no other thread changes the tree. Otherwise use
+ * cl_radix_visit.
+ *
+ * @param [in] radix: The cl_radix_t object.
+ * @param [in] key: The key whose value is to be returned.
+ *
+ * @return On success returns the value or NULL otherwise.
+ */
+void *cl_radix_get(cl_radix_t *radix, const char *key);
+
+/**
+ * @name cl_radix_delete
+ * @brief Removes a key, and its value, from the tree.
+ *
+ * @param [in] radix: The cl_radix_t object.
+ * @param [in] key: The key that needs to be removed.
+ *
+ * @return On success returns 0 or -1 if the key was not found.
+ */
+int cl_radix_delete(cl_radix_t *radix, const char *key);
+
+/**
+ * @name cl_radix_contains_key
+ * @brief Checks if a key is inside the tree.
+ *
+ * @param [in] radix: The cl_radix_t object.
+ * @param [in] key: The key.
+ *
+ * @return Returns true if the key is found or false otherwise.
+ */
+bool cl_radix_contains_key(cl_radix_t *radix, const char *key);
+
+/**
+ * @name cl_radix_size
+ * @brief Gets the number of keys inside the tree.
+ *
+ * @param [in] radix: The cl_radix_t object.
+ *
+ * @return On success returns the number of keys or -1 otherwise.
+ */
+int cl_radix_size(cl_radix_t *radix);
+
+/**
+ * @name cl_radix_is_empty
+ * @brief Checks if the tree has no keys.
+ *
+ * @param [in] radix: The cl_radix_t object.
+ *
+ * @return Returns true if the tree is empty or false otherwise.
+ */
+bool cl_radix_is_empty(cl_radix_t *radix);
+
+/**
+ * @name cl_radix_longest_prefix
+ * @brief Finds the longest key which is a prefix of a string.
+ *
+ * This is the lookup made by routing tables, where "svc.db" answers for
+ * "svc.db.pool.size" unless a longer key does. A key is a prefix of itself,
+ * and the empty key, if inserted, is a prefix of every string.
+ *
+ * The returned key, and its value, point to the tree internal storage and
+ * are valid only until the key is removed from it. The tree is unlocked when
+ * this function returns, so it is only safe to use them while no other
+ * thread changes the tree. Otherwise use cl_radix_visit.
+ *
+ * @param [in] radix: The cl_radix_t object.
+ * @param [in] key: The string to look for.
+ * @param [out] value: An optional pointer to store the found key value.
+ *
+ * @return On success returns the found key or NULL otherwise.
+ */
+const char *cl_radix_longest_prefix(cl_radix_t *radix, const char *key,
+                                    void **value);
+
+/**
+ * @name cl_radix_map_prefix
+ * @brief Maps a function to every key starting with a prefix, in order.
+ *
+ * The \a foo function receives as arguments a key, its value and some
+ * \a data. Its prototype must be something of this type:
+ * int foo(const char *, void *, void *);
+ *
+ * Keys are visited in byte order, so "svc.db" comes before "svc.db.pool".
+ * An empty \a prefix visits every key. The \a foo function runs while the
+ * tree is still locked, so it may safely read or copy the keys and values,
+ * but the tree must not be changed from inside it. The returned key is only
+ * safe to use while no other thread changes the tree.
+ *
+ * @param [in] radix: The cl_radix_t object.
+ * @param [in] prefix: The prefix.
+ * @param [in] foo: The function.
+ * @param [in] data: The custom data passed to the map function.
+ *
+ * @return If \a foo returns a non-zero returns the current key. If not
+ *         returns NULL.
+ */
+const char *cl_radix_map_prefix(cl_radix_t *radix, const char *prefix,
+                                int (*foo)(const char *, void *, void *),
+                                void *data);
+
+/**
+ * @name cl_radix_visit
+ * @brief Runs a function over the key found by a lookup.
+ *
+ * The \a foo function receives as arguments the found key, its value and
+ * some \a data, while the tree is still locked, so it may safely read or
+ * copy them even if other threads change the tree. Its prototype must be
+ * something of this type:
+ * void foo(const char *, void *, void *);
+ *
+ * With CL_RADIX_EXACT the key must be equal to \a key, while
+ * CL_RADIX_LONGEST_PREFIX finds the longest key which is a prefix of it, as
+ * cl_radix_longest_prefix does. The tree must not be changed from inside
+ * \a foo.
+ *
+ * @param [in] radix: The cl_radix_t object.
+ * @param [in] key: The key to look for.
+ * @param [in] seek: The kind of lookup.
+ * @param [in] foo: The function.
+ * @param [in] data: The custom data passed to the function.
+ *
+ * @return Returns 0 if a key was found and \a foo called or -1 otherwise.
+ */
+int cl_radix_visit(cl_radix_t *radix, const char *key,
+                   enum cl_radix_seek seek,
+                   void (*foo)(const char *, void *, void *), void *data);
+
+#endif
+
@@ -0,0 +1,244 @@
+
+/*
+ * Description: API to handle a ring shared between exactly one producer
+ *              thread and one consumer thread.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 17:05:12 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef _COLLECTIONS_API_SPSC_RING_H
+#define _COLLECTIONS_API_SPSC_RING_H          1
+
+#ifndef LIBCOLLECTIONS_COMPILE
+# ifndef _COLLECTIONS_H
+#  error "Never use <spsc_ring.h> directly; include <collections.h> instead."
+# endif
+#endif
+
+/** Options to create a ring */
+enum cl_spsc_ring_flags {
+    CL_SPSC_RING_EVENTFD    = (1 << 0)
+};
+
+/**
+ * @name cl_spsc_ring_ref
+ * @brief Increases the reference count of a cl_spsc_ring_t object.
+ *
+ * @param [in] ring: The cl_spsc_ring_t object.
+ *
+ * @return On success returns the item itself with its reference count
+ *         increased or NULL otherwise.
+ */
+cl_spsc_ring_t *cl_spsc_ring_ref(cl_spsc_ring_t *ring);
+
+/**
+ * @name cl_spsc_ring_unref
+ * @brief Decreases the reference count for a cl_spsc_ring_t object.
+ *
+ * When its reference count drops to 0, the item is finalized (its memory is
+ * freed).
+ *
+ * @param [in] ring: The cl_spsc_ring_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_spsc_ring_unref(cl_spsc_ring_t *ring);
+
+/**
+ * @name cl_spsc_ring_create
+ * @brief Creates a ring to hand elements from one thread to another.
+ *
+ * Unlike a cl_queue_t, the ring does not hold pointers but the elements
+ * themselves, copied into fixed size slots allocated only once. Every
+ * function is wait-free, as long as only one thread produces elements and
+ * only one thread consumes them.
+ *
+ * With the CL_SPSC_RING_EVENTFD flag the consumer may block inside
+ * cl_spsc_ring_wait until the producer commits something, instead of
+ * spinning or sleeping. The producer only makes a system call when the
+ * consumer is actually blocked.
+ *
+ * Functions of this object do not hold a reference to it while running, so
+ * the caller must keep one of its own while sharing it between threads.
+ *
+ * @param [in] capacity: The maximum number of elements, rounded up to a
+ *                       power of 2.
+ * @param [in] slot_size: The size of every element.
+ * @param [in] flags: Options to create the ring, from enum
+ *                    cl_spsc_ring_flags.
+ *
+ * @return On success returns a cl_spsc_ring_t object or NULL otherwise.
+ */
+cl_spsc_ring_t *cl_spsc_ring_create(unsigned int capacity,
+                                    unsigned int slot_size,
+                                    unsigned int flags);
+
+/**
+ * @name cl_spsc_ring_destroy
+ * @brief Releases a cl_spsc_ring_t object from memory.
+ *
+ * @param [in] ring: The cl_spsc_ring_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_spsc_ring_destroy(cl_spsc_ring_t *ring);
+
+/**
+ * @name cl_spsc_ring_reserve
+ * @brief Gives the producer the next free slot to be written directly.
+ *
+ * It may be called several times in a row, each one reserving the following
+ * slot. Reserved slots are only seen by the consumer after a call to
+ * cl_spsc_ring_commit. Producer only.
+ *
+ * @param [in] ring: The cl_spsc_ring_t object.
+ *
+ * @return Returns a pointer to the slot memory or NULL if the ring is full or
+ *         an error occurred.
+ */
+void *cl_spsc_ring_reserve(cl_spsc_ring_t *ring);
+
+/**
+ * @name cl_spsc_ring_commit
+ * @brief Publishes every slot reserved so far to the consumer.
+ *
+ * Producer only.
+ *
+ * @param [in] ring: The cl_spsc_ring_t object.
+ *
+ * @return On success returns the number of published elements or -1
+ *         otherwise.
+ */
+int cl_spsc_ring_commit(cl_spsc_ring_t *ring);
+
+/**
+ * @name cl_spsc_ring_push
+ * @brief Copies an element into the ring and publishes it.
+ *
+ * Slots reserved before and not yet committed are published too. Producer
+ * only.
+ *
+ * @param [in] ring: The cl_spsc_ring_t object.
+ * @param [in] data: The element, with the ring slot size.
+ *
+ * @return Returns true if the element was inserted or false if the ring is
+ *         full or an error occurred.
+ */
+bool cl_spsc_ring_push(cl_spsc_ring_t *ring, const void *data);
+
+/**
+ * @name cl_spsc_ring_front
+ * @brief Gives the consumer the oldest element without removing it.
+ *
+ * The element stays valid until cl_spsc_ring_consume is called. Consumer
+ * only.
+ *
+ * @param [in] ring: The cl_spsc_ring_t object.
+ *
+ * @return Returns a pointer to the slot memory or NULL if the ring is empty
+ *         or an error occurred.
+ */
+void *cl_spsc_ring_front(cl_spsc_ring_t *ring);
+
+/**
+ * @name cl_spsc_ring_consume
+ * @brief Removes the oldest element, giving its slot back to the producer.
+ *
+ * Consumer only.
+ *
+ * @param [in] ring: The cl_spsc_ring_t object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_spsc_ring_consume(cl_spsc_ring_t *ring);
+
+/**
+ * @name cl_spsc_ring_pop
+ * @brief Copies the oldest element out of the ring and removes it.
+ *
+ * Consumer only.
+ *
+ * @param [in] ring: The cl_spsc_ring_t object.
+ * @param [out] data: A buffer with the ring slot size to store the element.
+ *
+ * @return Returns true if an element was removed or false if the ring is
+ *         empty or an error occurred.
+ */
+bool cl_spsc_ring_pop(cl_spsc_ring_t *ring, void *data);
+
+/**
+ * @name cl_spsc_ring_pop_batch
+ * @brief Copies up to \a count of the oldest elements out of the ring and
+ *        removes them, at once.
+ *
+ * Consumer only.
+ *
+ * @param [in] ring: The cl_spsc_ring_t object.
+ * @param [out] data: An array of elements with the ring slot size.
+ * @param [in] count: The number of elements the array can hold.
+ *
+ * @return On success returns the number of removed elements, which may be 0,
+ *         or -1 otherwise.
+ */
+int cl_spsc_ring_pop_batch(cl_spsc_ring_t *ring, void *data,
+                           unsigned int count);
+
+/**
+ * @name cl_spsc_ring_wait
+ * @brief Blocks the consumer until the ring has something to be consumed.
+ *
+ * The ring must have been created with the CL_SPSC_RING_EVENTFD flag.
+ * Consumer only.
+ *
+ * @param [in] ring: The cl_spsc_ring_t object.
+ * @param [in] timeout: The maximum time to wait, in milliseconds, or -1 to
+ *                      wait forever.
+ *
+ * @return Returns 0 if the ring is not empty or -1 otherwise, including
+ *         when the timeout expired (with CL_ENDED_WITH_TIMEOUT as error).
+ */
+int cl_spsc_ring_wait(cl_spsc_ring_t *ring, int timeout);
+
+/**
+ * @name cl_spsc_ring_size
+ * @brief Gets the number of committed elements inside the ring.
+ *
+ * While the other thread is using the ring this is only a snapshot.
+ *
+ * @param [in] ring: The cl_spsc_ring_t object.
+ *
+ * @return On success returns the number of elements or -1 otherwise.
+ */
+int cl_spsc_ring_size(cl_spsc_ring_t *ring);
+
+/**
+ * @name cl_spsc_ring_is_empty
+ * @brief Checks if the ring is empty or not.
+ *
+ * @param [in] ring: The cl_spsc_ring_t object.
+ *
+ * @return Returns true if the ring is empty or false otherwise.
+ */
+bool cl_spsc_ring_is_empty(cl_spsc_ring_t *ring);
+
+#endif
+
@@ -121,6 +121,12 @@ int cl_stack_unref(cl_stack_t *stack);
  * pass the arguments \a free_data, \a compare_to and \a equals, since them can
  * exist inside a cobject_t object.
  *
+ * A stack may be shared between threads. Functions that only read it, like
+ * the _map_ ones, cl_stack_at or _contains, run at the same time and see the
+ * stack as it was when they started, while functions that change it run
+ * alone, ahead of any reader still waiting. So the functions called by the
+ * _map_ ones must not call any function of the stack they are walking.
+ *
  * @param [in] free_data: The free_data function pointer.
  * @param [in] compare_to: The compare_to function pointer.
  * @param [in] filter: The filter function pointer.
@@ -135,6 +141,42 @@ cl_stack_t *cl_stack_create(void (*free_data)(void *),
                             int (*equals)(cl_stack_node_t *,
                                           cl_stack_node_t *));
 
+/**
+ * @name cl_stack_create_ex
+ * @brief Creates a new stack object with extra options.
+ *
+ * This is the same as cl_stack_create, with \a flags to change how the stack
+ * works internally. It may be a combination of the following values:
+ *
+ * CL_LIST_NODE_POOL: nodes are taken from a pool owned by the stack, and
+ *                    given back to it when released, instead of being
+ *                    allocated one at a time.
+ *
+ * CL_LIST_INLINE_CONTENT: the content given when inserting an element is
+ *                         copied, \a size bytes of it, inside the same
+ *                         allocation as its node, so the caller may
+ *                         reuse or release its own copy right after.
+ *                         \a free_data, if any, receives the copy and
+ *                         must only release what it points to, and
+ *                         contents are never released otherwise. This
+ *                         can't be combined with CL_LIST_NODE_POOL.
+ *
+ * @param [in] free_data: The free_data function pointer.
+ * @param [in] compare_to: The compare_to function pointer.
+ * @param [in] filter: The filter function pointer.
+ * @param [in] equals: The equals function pointer.
+ * @param [in] flags: The stack options.
+ *
+ * @return On success a void object will be returned or NULL otherwise.
+ */
+cl_stack_t *cl_stack_create_ex(void (*free_data)(void *),
+                               int (*compare_to)(cl_stack_node_t *,
+                                                 cl_stack_node_t *),
+                               int (*filter)(cl_stack_node_t *, void *),
+                               int (*equals)(cl_stack_node_t *,
+                                             cl_stack_node_t *),
+                               unsigned int flags);
+
 /**
  * @name cl_stack_destroy
  * @brief Releases a void from memory.
@@ -448,5 +490,19 @@ int cl_stack_set_filter(const cl_stack_t *stack,
 int cl_stack_set_equals(const cl_stack_t *stack,
                         int (*equals)(cl_stack_node_t *, cl_stack_node_t *));
 
-#endif
+/**
+ * @name cl_stack_pool_stats
+ * @brief Gets the counters of the node pool of a stack.
+ *
+ * A hit is a node reused from the pool and a miss is a node requested while
+ * the pool was empty, which makes it allocate a new set of nodes. All
+ * counters are zero if the stack was not created with CL_LIST_NODE_POOL.
+ *
+ * @param [in] stack: The stack object.
+ * @param [out] stats: The structure where the counters will be stored.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_stack_pool_stats(const cl_stack_t *stack, struct cl_list_pool_stats_s *stats);
 
+#endif
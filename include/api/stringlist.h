@@ -121,5 +121,21 @@ cl_stringlist_t *cl_stringlist_dup(const cl_stringlist_t *list);
 bool cl_stringlist_contains(const cl_stringlist_t *list,
                             const cl_string_t *needle);
 
+/**
+ * @name cl_stringlist_set_bloom_filter
+ * @brief Enables or disables the membership filter of a string list.
+ *
+ * The filter is a Bloom filter of the strings inside the list, which lets
+ * cl_stringlist_contains answer for most absent strings without walking the
+ * list. It takes around 8 bytes of memory per string, and strings must not
+ * be changed while inside a filtered list.
+ *
+ * @param [in] list: The cl_stringlist_t object.
+ * @param [in] enabled: A boolean flag to enable or disable the filter.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_stringlist_set_bloom_filter(cl_stringlist_t *list, bool enabled);
+
 #endif
 
@@ -0,0 +1,851 @@
+
+/*
+ * Description: Macros to generate containers specialised for a single
+ *              element type.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 23:58:12 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef _COLLECTIONS_API_TYPED_H
+#define _COLLECTIONS_API_TYPED_H          1
+
+#ifndef LIBCOLLECTIONS_COMPILE
+# ifndef _COLLECTIONS_H
+#  error "Never use <typed.h> directly; include <collections.h> instead."
+# endif
+#endif
+
+#ifndef _STDINT_H
+# include <stdint.h>
+#endif
+
+#ifndef _STDLIB_H
+# include <stdlib.h>
+#endif
+
+#ifndef _STRING_H
+# include <string.h>
+#endif
+
+/*
+ * The cl_vector_t, cl_list_t and cl_hashtable_t objects keep every element
+ * behind a pointer and call the user comparison functions through pointers
+ * too. The macros below generate, for a single element type, containers
+ * that keep the elements by value and whose comparison functions can be
+ * inlined by the compiler, which pays off for small elements, like numbers
+ * or small structures.
+ *
+ * Each macro is used once, at file scope, and declares a structure and a
+ * set of static inline functions, all of them prefixed by \a name:
+ *
+ *      cl_typed_vector_declare(ivec, int64_t, cl_typed_scalar_compare)
+ *
+ *      struct ivec v;
+ *      ivec_init(&v);
+ *      ivec_push(&v, 42);
+ *      ivec_sort(&v);
+ *      ivec_release(&v);
+ *
+ * Comparison and hash functions, or macros, receive pointers to the
+ * elements:
+ *
+ * - compare: int compare(const type *a, const type *b), returning a value
+ *   lower than, equal to or greater than zero like strcmp.
+ * - equals: int equals(const type *a, const type *b), returning non-zero
+ *   when both are equal.
+ * - hash: uint64_t hash(const type *a).
+ *
+ * The elements are copied around like plain values and nothing is released
+ * with them, so elements holding memory of their own must be released by the
+ * caller. These containers are not thread safe, carry no object header and
+ * do not set the library error code; functions that fail return -1, NULL or
+ * false.
+ */
+
+/* Room allocated by the first insertion */
+#define CL_TYPED_INITIAL_CAPACITY       16
+
+/* Partitions this small are sorted by insertion */
+#define CL_TYPED_INSERTION_SORT_SIZE    16
+
+/* Comparison functions for numeric elements */
+#define cl_typed_scalar_compare(a, b)   \
+    ((*(a) > *(b)) - (*(a) < *(b)))
+
+#define cl_typed_scalar_equals(a, b)    \
+    (*(a) == *(b))
+
+#define cl_typed_scalar_hash(a)         \
+    cl_typed_mix64((uint64_t)*(a))
+
+/* Spreads the bits of an integer key, so it can be used as a hash */
+static inline uint64_t cl_typed_mix64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+
+    return x;
+}
+
+/*
+ * Declares 'struct name', a growable array of \a type, and its functions:
+ *
+ * - void name_init(struct name *v);
+ * - void name_release(struct name *v);
+ * - unsigned int name_size(const struct name *v);
+ * - int name_reserve(struct name *v, unsigned int capacity);
+ * - int name_push(struct name *v, type element);
+ * - int name_pop(struct name *v, type *element);
+ * - int name_insert(struct name *v, unsigned int index, type element);
+ * - int name_replace(struct name *v, unsigned int index, type element);
+ * - type *name_at(const struct name *v, unsigned int index);
+ * - int name_delete_indexed(struct name *v, unsigned int index);
+ * - void name_sort(struct name *v);
+ * - int name_search(const struct name *v, const type *element);
+ * - int name_indexof(const struct name *v, const type *element);
+ * - bool name_contains(const struct name *v, const type *element);
+ *
+ * They behave like their cl_vector_t counterparts. Pointers returned by
+ * name_at are valid until the vector changes its size.
+ */
+#define cl_typed_vector_declare(name, type, compare)                         \
+    struct name {                                                            \
+        type            *items;                                              \
+        unsigned int    size;                                                \
+        unsigned int    capacity;                                            \
+    };                                                                       \
+\
+    static inline void name##_init(struct name *v)                           \
+    {                                                                        \
+        v->items = NULL;                                                     \
+        v->size = 0;                                                         \
+        v->capacity = 0;                                                     \
+    }                                                                        \
+\
+    static inline void name##_release(struct name *v)                        \
+    {                                                                        \
+        free(v->items);                                                      \
+        name##_init(v);                                                      \
+    }                                                                        \
+\
+    static inline unsigned int name##_size(const struct name *v)             \
+    {                                                                        \
+        return v->size;                                                      \
+    }                                                                        \
+\
+    static inline int name##_reserve(struct name *v, unsigned int capacity)  \
+    {                                                                        \
+        type *items;                                                         \
+\
+        if (capacity <= v->capacity)                                         \
+            return 0;                                                        \
+\
+        items = (type *)realloc(v->items, (size_t)capacity * sizeof(type));  \
+\
+        if (NULL == items)                                                   \
+            return -1;                                                       \
+\
+        v->items = items;                                                    \
+        v->capacity = capacity;                                              \
+\
+        return 0;                                                            \
+    }                                                                        \
+\
+    static inline int name##__grow(struct name *v)                           \
+    {                                                                        \
+        if (v->size < v->capacity)                                           \
+            return 0;                                                        \
+\
+        if (v->capacity > (~0U >> 1))                                        \
+            return -1;                                                       \
+\
+        return name##_reserve(v, (v->capacity == 0)                          \
+                                    ? CL_TYPED_INITIAL_CAPACITY              \
+                                    : v->capacity * 2);                      \
+    }                                                                        \
+\
+    static inline int name##_push(struct name *v, type element)              \
+    {                                                                        \
+        if (name##__grow(v) < 0)                                             \
+            return -1;                                                       \
+\
+        v->items[v->size++] = element;                                       \
+\
+        return 0;                                                            \
+    }                                                                        \
+\
+    static inline int name##_pop(struct name *v, type *element)              \
+    {                                                                        \
+        if (v->size == 0)                                                    \
+            return -1;                                                       \
+\
+        v->size--;                                                           \
+\
+        if (element != NULL)                                                 \
+            *element = v->items[v->size];                                    \
+\
+        return 0;                                                            \
+    }                                                                        \
+\
+    static inline int name##_insert(struct name *v, unsigned int index,      \
+        type element)                                                        \
+    {                                                                        \
+        if ((index > v->size) || (name##__grow(v) < 0))                      \
+            return -1;                                                       \
+\
+        memmove(v->items + index + 1, v->items + index,                      \
+                (size_t)(v->size - index) * sizeof(type));                   \
+\
+        v->items[index] = element;                                           \
+        v->size++;                                                           \
+\
+        return 0;                                                            \
+    }                                                                        \
+\
+    static inline int name##_replace(struct name *v, unsigned int index,     \
+        type element)                                                        \
+    {                                                                        \
+        if (index >= v->size)                                                \
+            return -1;                                                       \
+\
+        v->items[index] = element;                                           \
+\
+        return 0;                                                            \
+    }                                                                        \
+\
+    static inline type *name##_at(const struct name *v, unsigned int index)  \
+    {                                                                        \
+        if (index >= v->size)                                                \
+            return NULL;                                                     \
+\
+        return v->items + index;                                             \
+    }                                                                        \
+\
+    static inline int name##_delete_indexed(struct name *v,                  \
+        unsigned int index)                                                  \
+    {                                                                        \
+        if (index >= v->size)                                                \
+            return -1;                                                       \
+\
+        memmove(v->items + index, v->items + index + 1,                      \
+                (size_t)(v->size - index - 1) * sizeof(type));               \
+\
+        v->size--;                                                           \
+\
+        return 0;                                                            \
+    }                                                                        \
+\
+    static inline void name##__swap(type *a, type *b)                        \
+    {                                                                        \
+        type tmp = *a;                                                       \
+\
+        *a = *b;                                                             \
+        *b = tmp;                                                            \
+    }                                                                        \
+\
+    static inline void name##__insertion_sort(type *v, unsigned int n)       \
+    {                                                                        \
+        type tmp;                                                            \
+        unsigned int i, j;                                                   \
+\
+        for (i = 1; i < n; i++) {                                            \
+            tmp = v[i];                                                      \
+\
+            for (j = i; (j > 0) && (compare(&tmp, &v[j - 1]) < 0); j--)      \
+                v[j] = v[j - 1];                                             \
+\
+            v[j] = tmp;                                                      \
+        }                                                                    \
+    }                                                                        \
+\
+    static inline void name##__sift_down(type *v, unsigned int root,         \
+        unsigned int n)                                                      \
+    {                                                                        \
+        unsigned int child;                                                  \
+\
+        while ((child = 2 * root + 1) < n) {                                 \
+            if ((child + 1 < n) && (compare(&v[child], &v[child + 1]) < 0))  \
+                child++;                                                     \
+\
+            if (compare(&v[root], &v[child]) >= 0)                           \
+                return;                                                      \
+\
+            name##__swap(&v[root], &v[child]);                               \
+            root = child;                                                    \
+        }                                                                    \
+    }                                                                        \
+\
+    static inline void name##__heap_sort(type *v, unsigned int n)            \
+    {                                                                        \
+        unsigned int i;                                                      \
+\
+        for (i = n / 2; i-- > 0; )                                           \
+            name##__sift_down(v, i, n);                                      \
+\
+        for (i = n - 1; i > 0; i--) {                                        \
+            name##__swap(&v[0], &v[i]);                                      \
+            name##__sift_down(v, 0, i);                                      \
+        }                                                                    \
+    }                                                                        \
+\
+    static inline unsigned int name##__partition(type *v, unsigned int n)    \
+    {                                                                        \
+        unsigned int i = 0, j = n, mid = n / 2;                              \
+\
+        if (compare(&v[mid], &v[0]) < 0)                                     \
+            name##__swap(&v[mid], &v[0]);                                    \
+\
+        if (compare(&v[n - 1], &v[mid]) < 0) {                               \
+            name##__swap(&v[n - 1], &v[mid]);                                \
+\
+            if (compare(&v[mid], &v[0]) < 0)                                 \
+                name##__swap(&v[mid], &v[0]);                                \
+        }                                                                    \
+\
+        name##__swap(&v[0], &v[mid]);                                        \
+\
+        while (1) {                                                          \
+            do {                                                             \
+                i++;                                                         \
+            } while ((i < n) && (compare(&v[i], &v[0]) < 0));                \
+\
+            do {                                                             \
+                j--;                                                         \
+            } while (compare(&v[j], &v[0]) > 0);                             \
+\
+            if (i >= j)                                                      \
+                break;                                                       \
+\
+            name##__swap(&v[i], &v[j]);                                      \
+        }                                                                    \
+\
+        name##__swap(&v[0], &v[j]);                                          \
+\
+        return j;                                                            \
+    }                                                                        \
+\
+    static inline void name##__introsort(type *v, unsigned int n,            \
+        unsigned int depth)                                                  \
+    {                                                                        \
+        unsigned int p;                                                      \
+\
+        while (n > CL_TYPED_INSERTION_SORT_SIZE) {                           \
+            if (depth == 0) {                                                \
+                name##__heap_sort(v, n);                                     \
+                return;                                                      \
+            }                                                                \
+\
+            depth--;                                                         \
+            p = name##__partition(v, n);                                     \
+\
+            if (p < n - p - 1) {                                             \
+                name##__introsort(v, p, depth);                              \
+                v += p + 1;                                                  \
+                n -= p + 1;                                                  \
+            } else {                                                         \
+                name##__introsort(v + p + 1, n - p - 1, depth);              \
+                n = p;                                                       \
+            }                                                                \
+        }                                                                    \
+\
+        name##__insertion_sort(v, n);                                        \
+    }                                                                        \
+\
+    static inline void name##_sort(struct name *v)                           \
+    {                                                                        \
+        unsigned int n, depth = 0;                                           \
+\
+        for (n = v->size; n > 1; n >>= 1)                                    \
+            depth += 2;                                                      \
+\
+        name##__introsort(v->items, v->size, depth);                         \
+    }                                                                        \
+\
+    static inline int name##_search(const struct name *v,                    \
+        const type *element)                                                 \
+    {                                                                        \
+        unsigned int lo = 0, hi = v->size, mid;                              \
+\
+        while (lo < hi) {                                                    \
+            mid = lo + (hi - lo) / 2;                                        \
+\
+            if (compare(&v->items[mid], element) < 0)                        \
+                lo = mid + 1;                                                \
+            else                                                             \
+                hi = mid;                                                    \
+        }                                                                    \
+\
+        if ((lo < v->size) && (compare(&v->items[lo], element) == 0))        \
+            return (int)lo;                                                  \
+\
+        return -1;                                                           \
+    }                                                                        \
+\
+    static inline int name##_indexof(const struct name *v,                   \
+        const type *element)                                                 \
+    {                                                                        \
+        unsigned int i;                                                      \
+\
+        for (i = 0; i < v->size; i++)                                        \
+            if (compare(&v->items[i], element) == 0)                         \
+                return (int)i;                                               \
+\
+        return -1;                                                           \
+    }                                                                        \
+\
+    static inline bool name##_contains(const struct name *v,                 \
+        const type *element)                                                 \
+    {                                                                        \
+        return name##_indexof(v, element) >= 0;                              \
+    }
+
+/*
+ * Declares 'struct name', a doubly linked list whose nodes, of type
+ * 'struct name_node', hold a \a type by value, and its functions:
+ *
+ * - void name_init(struct name *l);
+ * - void name_release(struct name *l);
+ * - unsigned int name_size(const struct name *l);
+ * - int name_push(struct name *l, type element);
+ * - int name_pop(struct name *l, type *element);
+ * - int name_unshift(struct name *l, type element);
+ * - int name_shift(struct name *l, type *element);
+ * - type *name_at(const struct name *l, unsigned int index);
+ * - int name_indexof(const struct name *l, const type *element);
+ * - bool name_contains(const struct name *l, const type *element);
+ * - int name_delete(struct name *l, const type *element);
+ *
+ * Like with cl_list_t, push and pop work on the front of the list while
+ * unshift and shift work on its far end. The nodes may be walked directly,
+ * from l->first through node->next, as long as the list is not changed.
+ */
+#define cl_typed_list_declare(name, type, compare)                           \
+    struct name##_node {                                                     \
+        struct name##_node  *prev;                                           \
+        struct name##_node  *next;                                           \
+        type                value;                                           \
+    };                                                                       \
+\
+    struct name {                                                            \
+        struct name##_node  *first;                                          \
+        struct name##_node  *last;                                           \
+        unsigned int        size;                                            \
+    };                                                                       \
+\
+    static inline void name##_init(struct name *l)                           \
+    {                                                                        \
+        l->first = NULL;                                                     \
+        l->last = NULL;                                                      \
+        l->size = 0;                                                         \
+    }                                                                        \
+\
+    static inline void name##_release(struct name *l)                        \
+    {                                                                        \
+        struct name##_node *node, *next;                                     \
+\
+        for (node = l->first; node != NULL; node = next) {                   \
+            next = node->next;                                               \
+            free(node);                                                      \
+        }                                                                    \
+\
+        name##_init(l);                                                      \
+    }                                                                        \
+\
+    static inline unsigned int name##_size(const struct name *l)             \
+    {                                                                        \
+        return l->size;                                                      \
+    }                                                                        \
+\
+    static inline int name##_push(struct name *l, type element)              \
+    {                                                                        \
+        struct name##_node *node;                                            \
+\
+        node = (struct name##_node *)malloc(sizeof(struct name##_node));     \
+\
+        if (NULL == node)                                                    \
+            return -1;                                                       \
+\
+        node->value = element;                                               \
+        node->prev = NULL;                                                   \
+        node->next = l->first;                                               \
+\
+        if (l->first != NULL)                                                \
+            l->first->prev = node;                                           \
+        else                                                                 \
+            l->last = node;                                                  \
+\
+        l->first = node;                                                     \
+        l->size++;                                                           \
+\
+        return 0;                                                            \
+    }                                                                        \
+\
+    static inline int name##_unshift(struct name *l, type element)           \
+    {                                                                        \
+        struct name##_node *node;                                            \
+\
+        node = (struct name##_node *)malloc(sizeof(struct name##_node));     \
+\
+        if (NULL == node)                                                    \
+            return -1;                                                       \
+\
+        node->value = element;                                               \
+        node->next = NULL;                                                   \
+        node->prev = l->last;                                                \
+\
+        if (l->last != NULL)                                                 \
+            l->last->next = node;                                            \
+        else                                                                 \
+            l->first = node;                                                 \
+\
+        l->last = node;                                                      \
+        l->size++;                                                           \
+\
+        return 0;                                                            \
+    }                                                                        \
+\
+    static inline void name##__unlink(struct name *l,                        \
+        struct name##_node *node)                                            \
+    {                                                                        \
+        if (node->prev != NULL)                                              \
+            node->prev->next = node->next;                                   \
+        else                                                                 \
+            l->first = node->next;                                           \
+\
+        if (node->next != NULL)                                              \
+            node->next->prev = node->prev;                                   \
+        else                                                                 \
+            l->last = node->prev;                                            \
+\
+        l->size--;                                                           \
+        free(node);                                                          \
+    }                                                                        \
+\
+    static inline int name##_pop(struct name *l, type *element)              \
+    {                                                                        \
+        if (NULL == l->first)                                                \
+            return -1;                                                       \
+\
+        if (element != NULL)                                                 \
+            *element = l->first->value;                                      \
+\
+        name##__unlink(l, l->first);                                         \
+\
+        return 0;                                                            \
+    }                                                                        \
+\
+    static inline int name##_shift(struct name *l, type *element)            \
+    {                                                                        \
+        if (NULL == l->last)                                                 \
+            return -1;                                                       \
+\
+        if (element != NULL)                                                 \
+            *element = l->last->value;                                       \
+\
+        name##__unlink(l, l->last);                                          \
+\
+        return 0;                                                            \
+    }                                                                        \
+\
+    static inline type *name##_at(const struct name *l, unsigned int index)  \
+    {                                                                        \
+        struct name##_node *node;                                            \
+        unsigned int i;                                                      \
+\
+        if (index >= l->size)                                                \
+            return NULL;                                                     \
+\
+        if (index < l->size / 2) {                                           \
+            for (node = l->first, i = 0; i < index; i++)                     \
+                node = node->next;                                           \
+        } else {                                                             \
+            for (node = l->last, i = l->size - 1; i > index; i--)            \
+                node = node->prev;                                           \
+        }                                                                    \
+\
+        return &node->value;                                                 \
+    }                                                                        \
+\
+    static inline int name##_indexof(const struct name *l,                   \
+        const type *element)                                                 \
+    {                                                                        \
+        struct name##_node *node;                                            \
+        int i = 0;                                                           \
+\
+        for (node = l->first; node != NULL; node = node->next, i++)          \
+            if (compare(&node->value, element) == 0)                         \
+                return i;                                                    \
+\
+        return -1;                                                           \
+    }                                                                        \
+\
+    static inline bool name##_contains(const struct name *l,                 \
+        const type *element)                                                 \
+    {                                                                        \
+        return name##_indexof(l, element) >= 0;                              \
+    }                                                                        \
+\
+    static inline int name##_delete(struct name *l, const type *element)     \
+    {                                                                        \
+        struct name##_node *node;                                            \
+\
+        for (node = l->first; node != NULL; node = node->next)               \
+            if (compare(&node->value, element) == 0) {                       \
+                name##__unlink(l, node);                                     \
+                return 0;                                                    \
+            }                                                                \
+\
+        return -1;                                                           \
+    }
+
+/*
+ * Declares 'struct name', a hash table mapping \a key_type to \a value_type,
+ * and its functions:
+ *
+ * - void name_init(struct name *m);
+ * - void name_release(struct name *m);
+ * - unsigned int name_size(const struct name *m);
+ * - int name_reserve(struct name *m, unsigned int entries);
+ * - int name_put(struct name *m, key_type key, value_type value);
+ * - value_type *name_get(const struct name *m, const key_type *key);
+ * - bool name_contains(const struct name *m, const key_type *key);
+ * - int name_delete(struct name *m, const key_type *key);
+ * - bool name_next(const struct name *m, unsigned int *position,
+ *                  key_type **key, value_type **value);
+ *
+ * Entries are kept inside a single array with open addressing and linear
+ * probing, so a lookup usually touches a single cache line. Each entry also
+ * keeps its key hash, which spares most calls to \a equals and rehashing
+ * when the table grows. Removed entries leave no tombstones behind.
+ *
+ * name_put replaces the value of a key that already exists. name_next walks
+ * every entry, starting with a zeroed \a position, while the table is not
+ * changed. Pointers returned by name_get and name_next are valid until an
+ * entry is inserted or removed.
+ */
+#define cl_typed_hashmap_declare(name, key_type, value_type, hash, equals)   \
+    struct name##_entry {                                                    \
+        uint64_t            hash;                                            \
+        key_type            key;                                             \
+        value_type          value;                                           \
+    };                                                                       \
+\
+    struct name {                                                            \
+        struct name##_entry *entries;                                        \
+        unsigned int        size;                                            \
+        unsigned int        capacity;                                        \
+    };                                                                       \
+\
+    static inline void name##_init(struct name *m)                           \
+    {                                                                        \
+        m->entries = NULL;                                                   \
+        m->size = 0;                                                         \
+        m->capacity = 0;                                                     \
+    }                                                                        \
+\
+    static inline void name##_release(struct name *m)                        \
+    {                                                                        \
+        free(m->entries);                                                    \
+        name##_init(m);                                                      \
+    }                                                                        \
+\
+    static inline unsigned int name##_size(const struct name *m)             \
+    {                                                                        \
+        return m->size;                                                      \
+    }                                                                        \
+\
+    /* The top bit tells used entries apart from empty ones */               \
+    static inline uint64_t name##__hash(const key_type *key)                 \
+    {                                                                        \
+        return (uint64_t)(hash(key)) | (1ULL << 63);                         \
+    }                                                                        \
+\
+    static inline struct name##_entry *name##__find(const struct name *m,    \
+        const key_type *key, uint64_t h)                                     \
+    {                                                                        \
+        struct name##_entry *e;                                              \
+        unsigned int i, mask;                                                \
+\
+        if (m->size == 0)                                                    \
+            return NULL;                                                     \
+\
+        mask = m->capacity - 1;                                              \
+\
+        for (i = h & mask; ; i = (i + 1) & mask) {                           \
+            e = &m->entries[i];                                              \
+\
+            if (e->hash == 0)                                                \
+                return NULL;                                                 \
+\
+            if ((e->hash == h) && equals(&e->key, key))                      \
+                return e;                                                    \
+        }                                                                    \
+    }                                                                        \
+\
+    static inline int name##_reserve(struct name *m, unsigned int entries)   \
+    {                                                                        \
+        struct name##_entry *old = m->entries, *e;                           \
+        unsigned int capacity = CL_TYPED_INITIAL_CAPACITY, i, j, mask;       \
+\
+        /* Keeps the table at most 3/4 full */                               \
+        while ((unsigned long long)capacity * 3 <                            \
+               (unsigned long long)entries * 4)                              \
+        {                                                                    \
+            if (capacity > (~0U >> 2))                                       \
+                return -1;                                                   \
+\
+            capacity <<= 1;                                                  \
+        }                                                                    \
+\
+        if (capacity <= m->capacity)                                         \
+            return 0;                                                        \
+\
+        e = (struct name##_entry *)calloc(capacity,                          \
+                                          sizeof(struct name##_entry));      \
+\
+        if (NULL == e)                                                       \
+            return -1;                                                       \
+\
+        mask = capacity - 1;                                                 \
+\
+        for (i = 0; i < m->capacity; i++) {                                  \
+            if (old[i].hash == 0)                                            \
+                continue;                                                    \
+\
+            for (j = old[i].hash & mask; e[j].hash != 0; j = (j + 1) & mask) \
+                ;                                                            \
+\
+            e[j] = old[i];                                                   \
+        }                                                                    \
+\
+        free(old);                                                           \
+        m->entries = e;                                                      \
+        m->capacity = capacity;                                              \
+\
+        return 0;                                                            \
+    }                                                                        \
+\
+    static inline int name##_put(struct name *m, key_type key,               \
+        value_type value)                                                    \
+    {                                                                        \
+        struct name##_entry *e;                                              \
+        uint64_t h = name##__hash(&key);                                     \
+        unsigned int i, mask;                                                \
+\
+        e = name##__find(m, &key, h);                                        \
+\
+        if (e != NULL) {                                                     \
+            e->value = value;                                                \
+            return 0;                                                        \
+        }                                                                    \
+\
+        if (name##_reserve(m, m->size + 1) < 0)                              \
+            return -1;                                                       \
+\
+        mask = m->capacity - 1;                                              \
+\
+        for (i = h & mask; m->entries[i].hash != 0; i = (i + 1) & mask)      \
+            ;                                                                \
+\
+        e = &m->entries[i];                                                  \
+        e->hash = h;                                                         \
+        e->key = key;                                                        \
+        e->value = value;                                                    \
+        m->size++;                                                           \
+\
+        return 0;                                                            \
+    }                                                                        \
+\
+    static inline value_type *name##_get(const struct name *m,               \
+        const key_type *key)                                                 \
+    {                                                                        \
+        struct name##_entry *e = name##__find(m, key, name##__hash(key));    \
+\
+        return (e != NULL) ? &e->value : NULL;                               \
+    }                                                                        \
+\
+    static inline bool name##_contains(const struct name *m,                 \
+        const key_type *key)                                                 \
+    {                                                                        \
+        return name##__find(m, key, name##__hash(key)) != NULL;              \
+    }                                                                        \
+\
+    /* Moves back the entries that probed past the removed one */            \
+    static inline int name##_delete(struct name *m, const key_type *key)     \
+    {                                                                        \
+        struct name##_entry *e = name##__find(m, key, name##__hash(key));    \
+        unsigned int i, j, home, mask = m->capacity - 1;                     \
+\
+        if (NULL == e)                                                       \
+            return -1;                                                       \
+\
+        i = e - m->entries;                                                  \
+\
+        for (j = (i + 1) & mask; m->entries[j].hash != 0;                    \
+             j = (j + 1) & mask)                                             \
+        {                                                                    \
+            home = m->entries[j].hash & mask;                                \
+\
+            if (((j > i) && ((home <= i) || (home > j))) ||                  \
+                ((j < i) && ((home <= i) && (home > j))))                    \
+            {                                                                \
+                m->entries[i] = m->entries[j];                               \
+                i = j;                                                       \
+            }                                                                \
+        }                                                                    \
+\
+        m->entries[i].hash = 0;                                              \
+        m->size--;                                                           \
+\
+        return 0;                                                            \
+    }                                                                        \
+\
+    static inline bool name##_next(const struct name *m,                     \
+        unsigned int *position, key_type **key, value_type **value)          \
+    {                                                                        \
+        struct name##_entry *e;                                              \
+\
+        for (; *position < m->capacity; (*position)++) {                     \
+            e = &m->entries[*position];                                      \
+\
+            if (e->hash == 0)                                                \
+                continue;                                                    \
+\
+            (*position)++;                                                   \
+\
+            if (key != NULL)                                                 \
+                *key = &e->key;                                              \
+\
+            if (value != NULL)                                               \
+                *value = &e->value;                                          \
+\
+            return true;                                                     \
+        }                                                                    \
+\
+        return false;                                                        \
+    }
+
+#endif
+
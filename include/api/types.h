@@ -174,6 +174,7 @@ typedef void                    cl_log_t;
 /** list type */
 typedef void                    cl_list_t;
 typedef void                    cl_list_node_t;
+typedef void                    cl_list_iter_t;
 
 /** image type */
 typedef void                    cl_image_t;
@@ -198,5 +199,36 @@ typedef void                    cl_cqueue_t;
 /** circular stack type */
 typedef void                    cl_cstack_t;
 
+/** concurrent hashtable type */
+typedef void                    cl_chashtable_t;
+
+/** concurrent bounded queue type */
+typedef void                    cl_mpmc_queue_t;
+
+/** single producer and single consumer ring type */
+typedef void                    cl_spsc_ring_t;
+
+/** lock-free stack type */
+typedef void                    cl_lfstack_t;
+
+/** vector type */
+typedef void                    cl_vector_t;
+
+/** ordered map type */
+typedef void                    cl_ordmap_t;
+
+/** priority queue type */
+typedef void                    cl_pqueue_t;
+typedef void                    cl_pqueue_node_t;
+
+/** cache type */
+typedef void                    cl_cache_t;
+
+/** radix tree type */
+typedef void                    cl_radix_t;
+
+/** bitset type */
+typedef void                    cl_bitset_t;
+
 #endif
 
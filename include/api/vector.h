@@ -0,0 +1,356 @@
+
+/*
+ * Description: API to handle growable arrays.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 19:02:48 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef _COLLECTIONS_API_VECTOR_H
+#define _COLLECTIONS_API_VECTOR_H          1
+
+#ifndef LIBCOLLECTIONS_COMPILE
+# ifndef _COLLECTIONS_H
+#  error "Never use <vector.h> directly; include <collections.h> instead."
+# endif
+#endif
+
+/**
+ * @name cl_vector_ref
+ * @brief Increases the reference count for a cl_vector_t item.
+ *
+ * @param [in,out] vector: The vector item.
+ *
+ * @return On success returns the item itself with its reference count
+ *         increased or NULL otherwise.
+ */
+cl_vector_t *cl_vector_ref(cl_vector_t *vector);
+
+/**
+ * @name cl_vector_unref
+ * @brief Decreases the reference count for a cl_vector_t item.
+ *
+ * When its reference count drops to 0, the item is finalized (its memory is
+ * freed).
+ *
+ * @param [in,out] vector: The vector item.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_vector_unref(cl_vector_t *vector);
+
+/**
+ * @name cl_vector_create
+ * @brief Creates a new vector object.
+ *
+ * A vector keeps its elements in a single array, so reaching any of them by
+ * its index takes constant time, and appending one takes constant time on
+ * average.
+ *
+ * Every element is kept in a cl_list_node_t, so the function pointers are
+ * the same ones received by cl_list_create and the nodes handed out are
+ * handled with cl_list_node_content and cl_list_node_unref:
+ *
+ * void free_data(void *);
+ * int compare_to(cl_list_node_t *, cl_list_node_t *);
+ * int filter(cl_list_node_t *, void *);
+ * int equals(cl_list_node_t *, cl_list_node_t *);
+ *
+ * The vector stays locked while compare_to, filter, equals and the functions
+ * passed to cl_vector_map run, so they must not call any cl_vector function
+ * on the same vector, which would never return. The free_data function is
+ * always called with the vector unlocked.
+ *
+ * @param [in] free_data: The free_data function pointer.
+ * @param [in] compare_to: The compare_to function pointer.
+ * @param [in] filter: The filter function pointer.
+ * @param [in] equals: The equals function pointer.
+ *
+ * @return On success a cl_vector_t object will be returned or NULL otherwise.
+ */
+cl_vector_t *cl_vector_create(void (*free_data)(void *),
+                              int (*compare_to)(cl_list_node_t *,
+                                                cl_list_node_t *),
+                              int (*filter)(cl_list_node_t *, void *),
+                              int (*equals)(cl_list_node_t *,
+                                            cl_list_node_t *));
+
+/**
+ * @name cl_vector_destroy
+ * @brief Releases a cl_vector_t from memory.
+ *
+ * Every element still inside the vector is released using the \a free_data
+ * function passed while creating it.
+ *
+ * @param [in,out] vector: The vector object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_vector_destroy(cl_vector_t *vector);
+
+/**
+ * @name cl_vector_size
+ * @brief Gets the number of elements of a vector.
+ *
+ * @param [in] vector: The vector object.
+ *
+ * @return On success returns the size of the vector or -1 otherwise.
+ */
+int cl_vector_size(const cl_vector_t *vector);
+
+/**
+ * @name cl_vector_reserve
+ * @brief Makes room for at least \a capacity elements at once.
+ *
+ * @param [in,out] vector: The vector object.
+ * @param [in] capacity: The number of elements.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_vector_reserve(cl_vector_t *vector, unsigned int capacity);
+
+/**
+ * @name cl_vector_push
+ * @brief Appends an element to the end of a vector.
+ *
+ * @param [in,out] vector: The vector object.
+ * @param [in] node_content: The element.
+ * @param [in] size: The element size.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_vector_push(cl_vector_t *vector, const void *node_content,
+                   unsigned int size);
+
+/**
+ * @name cl_vector_pop
+ * @brief Removes the last element of a vector.
+ *
+ * @param [in,out] vector: The vector object.
+ *
+ * @return On success returns the node of the element, and the user is
+ *         responsible for releasing it, or NULL otherwise.
+ */
+cl_list_node_t *cl_vector_pop(cl_vector_t *vector);
+
+/**
+ * @name cl_vector_insert
+ * @brief Inserts an element at a specific position of a vector.
+ *
+ * The elements from \a index onwards are moved one position ahead.
+ *
+ * @param [in,out] vector: The vector object.
+ * @param [in] index: The position, which may be the vector size.
+ * @param [in] node_content: The element.
+ * @param [in] size: The element size.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_vector_insert(cl_vector_t *vector, unsigned int index,
+                     const void *node_content, unsigned int size);
+
+/**
+ * @name cl_vector_replace
+ * @brief Replaces the element at a specific position of a vector.
+ *
+ * The previous element is released.
+ *
+ * @param [in,out] vector: The vector object.
+ * @param [in] index: The element position.
+ * @param [in] node_content: The new element.
+ * @param [in] size: The new element size.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_vector_replace(cl_vector_t *vector, unsigned int index,
+                      const void *node_content, unsigned int size);
+
+/**
+ * @name cl_vector_at
+ * @brief Gets the element at a specific position of a vector.
+ *
+ * @param [in] vector: The vector object.
+ * @param [in] index: The element position.
+ *
+ * @return On success returns a new reference to the node of the element,
+ *         which stays valid even if the element leaves the vector, or NULL
+ *         otherwise.
+ */
+cl_list_node_t *cl_vector_at(const cl_vector_t *vector, unsigned int index);
+
+/**
+ * @name cl_vector_delete_indexed
+ * @brief Deletes the element at a specific position of a vector.
+ *
+ * @param [in,out] vector: The vector object.
+ * @param [in] index: The element position.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_vector_delete_indexed(cl_vector_t *vector, unsigned int index);
+
+/**
+ * @name cl_vector_map
+ * @brief Maps a function to every element of a vector, in order.
+ *
+ * The \a foo function receives as arguments a node from the vector and some
+ * \a data. Its prototype must be something of this type:
+ * int foo(cl_list_node_t *, void *);
+ *
+ * @param [in] vector: The vector object.
+ * @param [in] foo: The function.
+ * @param [in] data: The custom data passed to the map function.
+ *
+ * @return If \a foo returns a non-zero returns a new reference to the current
+ *         node. If not returns NULL.
+ */
+cl_list_node_t *cl_vector_map(const cl_vector_t *vector,
+                              int (*foo)(cl_list_node_t *, void *),
+                              void *data);
+
+/**
+ * @name cl_vector_filter
+ * @brief Extracts elements from a vector according a specific filter.
+ *
+ * If the filter function returns a positive value the element will be
+ * extracted. A negative value also extracts it but stops the filter, keeping
+ * every element after it.
+ *
+ * @param [in,out] vector: The vector object.
+ * @param [in] data: Some custom data passed to the filter function.
+ *
+ * @return Returns a vector containing all extracted elements from the
+ *         original vector.
+ */
+cl_vector_t *cl_vector_filter(cl_vector_t *vector, void *data);
+
+/**
+ * @name cl_vector_sort
+ * @brief Sort all elements from a vector.
+ *
+ * This function uses the \a compare_to function and an introsort, which
+ * runs in O(n log n) even in the worst case but does not keep the order of
+ * equal elements.
+ *
+ * @param [in,out] vector: The vector object.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_vector_sort(cl_vector_t *vector);
+
+/**
+ * @name cl_vector_search
+ * @brief Finds an element inside a sorted vector with a binary search.
+ *
+ * This function uses the \a compare_to function, so the vector must be
+ * sorted by it.
+ *
+ * @param [in] vector: The vector object.
+ * @param [in] element: The element which will be sought through the vector.
+ * @param [in] size: The size in bytes of the element.
+ *
+ * @return Returns the index of the first element equal to \a element or -1
+ *         if it is not found.
+ */
+int cl_vector_search(const cl_vector_t *vector, void *element,
+                     unsigned int size);
+
+/**
+ * @name cl_vector_indexof
+ * @brief Gets the index of the first occurrence of an element inside the
+ *        vector.
+ *
+ * This function uses the \a equals function to compare elements.
+ *
+ * @param [in] vector: The vector object.
+ * @param [in] element: The element which will be sought through the vector.
+ * @param [in] size: The size in bytes of the element.
+ *
+ * @return Returns the element index or -1 if it is not found.
+ */
+int cl_vector_indexof(const cl_vector_t *vector, void *element,
+                      unsigned int size);
+
+/**
+ * @name cl_vector_contains
+ * @brief Checks if a vector contains a specific element.
+ *
+ * This function uses the \a equals function to compare elements.
+ *
+ * @param [in] vector: The vector object.
+ * @param [in] element: The element which will be sought through the vector.
+ * @param [in] size: The size in bytes of the element.
+ *
+ * @return Returns true if the element is found or false otherwise.
+ */
+bool cl_vector_contains(const cl_vector_t *vector, void *element,
+                        unsigned int size);
+
+/**
+ * @name cl_vector_is_empty
+ * @brief Checks if a vector is empty or not.
+ *
+ * @param [in] vector: The vector object.
+ *
+ * @return Returns true if the vector is empty or false otherwise.
+ */
+bool cl_vector_is_empty(const cl_vector_t *vector);
+
+/**
+ * @name cl_vector_set_compare_to
+ * @brief Updates the internal vector compare_to function.
+ *
+ * @param [in] vector: The vector object.
+ * @param [in] compare_to: The new compare_to function.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_vector_set_compare_to(const cl_vector_t *vector,
+                             int (*compare_to)(cl_list_node_t *,
+                                               cl_list_node_t *));
+
+/**
+ * @name cl_vector_set_filter
+ * @brief Updates the internal vector filter function.
+ *
+ * @param [in] vector: The vector object.
+ * @param [in] filter: The new filter function.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_vector_set_filter(const cl_vector_t *vector,
+                         int (*filter)(cl_list_node_t *, void *));
+
+/**
+ * @name cl_vector_set_equals
+ * @brief Updates the internal vector equals function.
+ *
+ * @param [in] vector: The vector object.
+ * @param [in] equals: The new equals function.
+ *
+ * @return On success returns 0 or -1 otherwise.
+ */
+int cl_vector_set_equals(const cl_vector_t *vector,
+                         int (*equals)(cl_list_node_t *,
+                                       cl_list_node_t *));
+
+#endif
+
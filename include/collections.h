@@ -38,7 +38,10 @@ extern "C" {
 #endif
 
 #include "api/types.h"
+#include "api/bitset.h"
+#include "api/cache.h"
 #include "api/cfg.h"
+#include "api/chashtable.h"
 #include "api/chat.h"
 #include "api/counter.h"
 #include "api/cqueue.h"
@@ -59,24 +62,32 @@ extern "C" {
 #include "api/intl.h"
 #include "api/io.h"
 #include "api/json.h"
+#include "api/lfstack.h"
 #include "api/list.h"
 #include "api/log.h"
 #include "api/mem.h"
+#include "api/mpmc_queue.h"
 #include "api/object.h"
+#include "api/ordmap.h"
 #include "api/queue.h"
 #include "api/plugin_macros.h"
 #include "api/plugin.h"
+#include "api/pqueue.h"
 #include "api/process.h"
+#include "api/radix.h"
 #include "api/random.h"
 #include "api/ref.h"
 #include "api/specs.h"
+#include "api/spsc_ring.h"
 #include "api/stack.h"
 #include "api/string.h"
 #include "api/stringlist.h"
 #include "api/thread.h"
 #include "api/timeout.h"
 #include "api/timer.h"
+#include "api/typed.h"
 #include "api/utils.h"
+#include "api/vector.h"
 
 #ifdef LIBCOLLECTIONS_COMPILE
 # include "internal/internal.h"
@@ -0,0 +1,63 @@
+/*
+ * Description: Internal counting Bloom filter, used by containers to answer
+ *              negative membership checks without walking their elements.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 23:02:18 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef _COLLECTIONS_INTERNAL_BLOOM_H
+#define _COLLECTIONS_INTERNAL_BLOOM_H
+
+#ifndef LIBCOLLECTIONS_COMPILE
+# ifndef _COLLECTIONS_H
+#  error "Never use <bloom.h> directly; include <collections.h> instead."
+# endif
+#endif
+
+#ifndef _STDINT_H
+# include <stdint.h>
+#endif
+
+/*
+ * A Bloom filter whose bits are 8 bit counters, so elements can be removed
+ * as well as added. The counters are split into cache line sized blocks and
+ * every element touches a single block, so a lookup costs one cache miss.
+ *
+ * A filter never gives a false negative. It only grows when asked to, since
+ * that requires adding every element again, which only its owner can do.
+ */
+struct cbloom {
+    unsigned char   *counters;
+    unsigned int    nblocks;
+    unsigned int    count;
+};
+
+struct cbloom *cbloom_create(unsigned int expected);
+void cbloom_destroy(struct cbloom *b);
+void cbloom_clear(struct cbloom *b);
+void cbloom_add(struct cbloom *b, uint64_t hash);
+void cbloom_remove(struct cbloom *b, uint64_t hash);
+bool cbloom_may_contain(const struct cbloom *b, uint64_t hash);
+bool cbloom_is_full(const struct cbloom *b);
+
+#endif
+
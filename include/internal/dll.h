@@ -0,0 +1,78 @@
+/*
+ * Description: Internal doubly linked list head, keeping track of both ends
+ *              of a list and its number of nodes.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 09:14:02 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#ifndef _COLLECTIONS_INTERNAL_DLL_H
+#define _COLLECTIONS_INTERNAL_DLL_H
+
+#ifndef LIBCOLLECTIONS_COMPILE
+# ifndef _COLLECTIONS_H
+#  error "Never use <dll.h> directly; include <collections.h> instead."
+# endif
+#endif
+
+/*
+ * The head of a doubly linked list. Nodes are the same ones used by the
+ * cl_dll_* API, i.e, structures starting with prev and next pointers, and
+ * the chain pointed by @first is always NULL terminated, so it can still be
+ * handed to the read only cl_dll_* functions.
+ *
+ * The last node found by cdll_at is remembered in @cursor, with its
+ * position, so walking a list by index only moves one node per call. Every
+ * function changing the list keeps it right or drops it. Readers sharing a
+ * list update it only after winning @cursor_busy, otherwise they start from
+ * one of the ends.
+ *
+ * A zeroed structure is a valid empty list.
+ */
+struct cdll_head {
+    cl_list_entry_t     *first;
+    cl_list_entry_t     *last;
+    unsigned int        count;
+    cl_list_entry_t     *cursor;
+    unsigned int        cursor_index;
+    bool                cursor_busy;
+};
+
+void cdll_init(struct cdll_head *head);
+unsigned int cdll_size(const struct cdll_head *head);
+void cdll_push(struct cdll_head *head, void *node);
+void *cdll_pop(struct cdll_head *head);
+void cdll_unshift(struct cdll_head *head, void *node);
+void *cdll_shift(struct cdll_head *head);
+void *cdll_at(struct cdll_head *head, unsigned int index);
+void *cdll_middle(struct cdll_head *head);
+void cdll_remove(struct cdll_head *head, void *node);
+void *cdll_delete_indexed(struct cdll_head *head, unsigned int index);
+void cdll_filter(struct cdll_head *head, struct cdll_head *extracted,
+                 int (*foo)(void *, void *), void *data);
+
+void cdll_move(struct cdll_head *from, struct cdll_head *to);
+void cdll_splice(struct cdll_head *head, struct cdll_head *from, bool front);
+void cdll_sort(struct cdll_head *head, int (*cmp)(void *, void *));
+void cdll_rotate(struct cdll_head *head, unsigned int n);
+void cdll_free(struct cdll_head *head, void (*foo)(void *));
+
+#endif
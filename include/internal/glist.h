@@ -36,12 +36,21 @@
 void *cglist_node_ref(void *node, enum cl_object object);
 int cglist_node_unref(void *node, enum cl_object object);
 void *cglist_node_content(const void *node, enum cl_object object);
+void *cglist_node_create(const void *content, unsigned int size,
+                         void (*free_data)(void *),
+                         enum cl_object node_object);
+
+void cglist_node_discard(void *node);
+bool cglist_node_holds_cobject(const void *node);
+int cglist_compare_cobjects(void *a, void *b);
+int cglist_cobjects_are_equal(void *a, void *b);
+
 void *cglist_ref(void *list, enum cl_object object);
 int cglist_unref(void *list, enum cl_object object);
 void *cglist_create(enum cl_object object, void (*free_data)(void *),
                     int (*compare_to)(void *, void *),
                     int (*filter)(void *, void *),
-                    int (*equals)(void *, void *));
+                    int (*equals)(void *, void *), unsigned int flags);
 
 int cglist_destroy(void *list, enum cl_object object);
 int cglist_size(const void *list, enum cl_object object);
@@ -53,6 +62,14 @@ void *cglist_shift(void *list, enum cl_object object);
 int cglist_unshift(void *list, enum cl_object object, const void *node_content,
                    unsigned int size, enum cl_object node_object);
 
+int cglist_push_many(void *list, enum cl_object object, void **contents,
+                     unsigned int size, unsigned int count,
+                     enum cl_object node_object, bool front);
+
+int cglist_pop_many(void *list, enum cl_object object, void **nodes,
+                    unsigned int count);
+
+int cglist_splice(void *list, enum cl_object object, void *other);
 void *cglist_map(const void *list, enum cl_object object,
                  enum cl_object node_object, int (*foo)(void *, void *),
                  void *data);
@@ -95,6 +112,12 @@ bool cglist_is_empty(const void *list, enum cl_object object);
 int cglist_set_compare_to(const void *list, enum cl_object object,
                           int (*compare_to)(void *, void *));
 
+int cglist_set_sort_threshold(const void *list, enum cl_object object,
+                               unsigned int threshold);
+
+int cglist_set_bloom_filter(const void *list, enum cl_object object,
+                            bool enabled, unsigned long long (*hash)(void *));
+
 int cglist_set_filter(const void *list, enum cl_object object,
                       int (*filter)(void *, void *));
 
@@ -103,5 +126,22 @@ int cglist_set_equals(const void *list, enum cl_object object,
 
 void *cglist_middle(const void *list, enum cl_object object);
 int cglist_rotate(void *list, enum cl_object object, unsigned int n);
+int cglist_pool_stats(const void *list, enum cl_object object,
+                      struct cl_list_pool_stats_s *stats);
+
+void *cglist_create_ring(enum cl_object object, unsigned int capacity,
+                         void (*free_data)(void *),
+                         int (*compare_to)(void *, void *),
+                         int (*filter)(void *, void *),
+                         int (*equals)(void *, void *));
+
+void *cglist_iter_begin(const void *list, enum cl_object object,
+                        enum cl_object iter_object);
+
+int cglist_iter_end(void *iter, enum cl_object iter_object);
+void *cglist_iter_next(void *iter, enum cl_object iter_object, bool forward);
+void *cglist_iter_content(const void *iter, enum cl_object iter_object);
+void *cglist_iter_retain(const void *iter, enum cl_object iter_object,
+                         enum cl_object node_object);
 
 #endif
@@ -49,6 +49,8 @@
 #include "utils.h"
 #include "plugin.h"
 #include "init.h"
+#include "dll.h"
+#include "bloom.h"
 #include "glist.h"
 #include "random.h"
 #include "intl.h"
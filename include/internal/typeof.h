@@ -66,7 +66,19 @@ enum cl_object {
     CL_OBJ_CAPTION,
     CL_OBJ_HASHTABLE,
     CL_OBJ_CIRCULAR_QUEUE,
-    CL_OBJ_CIRCULAR_STACK
+    CL_OBJ_CIRCULAR_STACK,
+    CL_OBJ_CHASHTABLE,
+    CL_OBJ_MPMC_QUEUE,
+    CL_OBJ_SPSC_RING,
+    CL_OBJ_LFSTACK,
+    CL_OBJ_VECTOR,
+    CL_OBJ_ORDMAP,
+    CL_OBJ_PQUEUE,
+    CL_OBJ_PQUEUE_NODE,
+    CL_OBJ_LIST_ITER,
+    CL_OBJ_CACHE,
+    CL_OBJ_RADIX,
+    CL_OBJ_BITSET
 };
 
 struct cl_object_hdr {
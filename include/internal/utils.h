@@ -33,8 +33,14 @@
 # endif
 #endif
 
+#ifndef _STDINT_H
+# include <stdint.h>
+#endif
+
 char *value_to_hex(void *p, unsigned int size);
 char *strip_filename(const char *pathname);
 char *file_extension(const char *pathname);
+uint64_t bytes_hash(const void *key, size_t size);
+uint64_t string_hash(const char *key);
 
 #endif
@@ -0,0 +1,1907 @@
+
+/*
+ * Description: Sets of unsigned integers kept as bits, plain or compressed.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 21:05:44 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+
+#include <pthread.h>
+
+#include "collections.h"
+
+/*
+ * Vector versions of the word loops are compiled for AVX2 whatever the
+ * build flags, and only called after the processor is known to support it.
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+# define BITSET_X86                 1
+# include <immintrin.h>
+#endif
+
+/* Every unsigned int may be a member of a growable set */
+#define BITSET_MAX_BITS             (1ULL << 32)
+#define BITSET_MAX_WORDS            (BITSET_MAX_BITS / 64)
+
+/* A compressed set is split in chunks of this many bits */
+#define CHUNK_BITS                  65536
+#define CHUNK_WORDS                 (CHUNK_BITS / 64)
+
+/*
+ * A chunk with more members than this keeps its bits, as an array of 16 bits
+ * members would be larger. Removing single members turns it back into an
+ * array only at half of it, so one member coming and going at the limit
+ * doesn't convert the chunk every time.
+ */
+#define CHUNK_ARRAY_MAX             4096
+#define CHUNK_ARRAY_MIN_CAPACITY    4
+
+enum bitset_op {
+    BITSET_AND,
+    BITSET_OR,
+    BITSET_XOR,
+    BITSET_ANDNOT
+};
+
+/* A chunk of a compressed set, holding the members starting at @key << 16 */
+struct bchunk {
+    union {
+        uint16_t    *values;
+        uint64_t    *words;
+    };
+
+    uint32_t        card;
+    uint32_t        capacity;
+    uint16_t        key;
+    bool            bitmap;
+};
+
+/*
+ * A plain set uses @words, which are always allocated up to its size when
+ * it is not growable. A compressed one uses @chunks, sorted by their keys.
+ * In both cases @limit is the first number which can't be a member.
+ */
+#define cl_bitset_members                                           \
+    cl_struct_member(uint64_t *, words)                             \
+    cl_struct_member(unsigned int, nwords)                          \
+    cl_struct_member(struct bchunk *, chunks)                       \
+    cl_struct_member(unsigned int, nchunks)                         \
+    cl_struct_member(unsigned int, chunks_capacity)                 \
+    cl_struct_member(unsigned long long, limit)                     \
+    cl_struct_member(unsigned int, flags)                           \
+    cl_struct_member(bool, thread_safe)                             \
+    cl_struct_member(pthread_rwlock_t, lock)                        \
+    cl_struct_member(struct cl_ref_s, ref)
+
+cl_struct_declare(bitset_s, cl_bitset_members);
+
+#define bitset_s        cl_struct(bitset_s)
+
+static void read_lock(bitset_s *b)
+{
+    if (b->thread_safe)
+        pthread_rwlock_rdlock(&b->lock);
+}
+
+static void write_lock(bitset_s *b)
+{
+    if (b->thread_safe)
+        pthread_rwlock_wrlock(&b->lock);
+}
+
+static void unlock(bitset_s *b)
+{
+    if (b->thread_safe)
+        pthread_rwlock_unlock(&b->lock);
+}
+
+/*
+ * Locks the set which is changed and the one which is only read by a set
+ * operation, always in the same order so two threads operating on the
+ * same pair, in opposite roles, can't wait for each other.
+ */
+static void lock_pair(bitset_s *dest, bitset_s *src)
+{
+    if (dest == src) {
+        write_lock(dest);
+        return;
+    }
+
+    if (dest < src) {
+        write_lock(dest);
+        read_lock(src);
+    } else {
+        read_lock(src);
+        write_lock(dest);
+    }
+}
+
+static void unlock_pair(bitset_s *dest, bitset_s *src)
+{
+    unlock(dest);
+
+    if (dest != src)
+        unlock(src);
+}
+
+static bool is_compressed(const bitset_s *b)
+{
+    return (b->flags & CL_BITSET_COMPRESSED) ? true : false;
+}
+
+static bool is_growable(const bitset_s *b)
+{
+    return (b->flags & CL_BITSET_GROWABLE) ? true : false;
+}
+
+static unsigned long long words_for(unsigned long long bits)
+{
+    return (bits + 63) / 64;
+}
+
+/*
+ *
+ * Word loops. These do the real work of every operation.
+ *
+ */
+
+static void words_op_generic(uint64_t *dest, const uint64_t *src, size_t n,
+    enum bitset_op op)
+{
+    size_t i;
+
+    switch (op) {
+        case BITSET_AND:
+            for (i = 0; i < n; i++)
+                dest[i] &= src[i];
+
+            break;
+
+        case BITSET_OR:
+            for (i = 0; i < n; i++)
+                dest[i] |= src[i];
+
+            break;
+
+        case BITSET_XOR:
+            for (i = 0; i < n; i++)
+                dest[i] ^= src[i];
+
+            break;
+
+        case BITSET_ANDNOT:
+            for (i = 0; i < n; i++)
+                dest[i] &= ~src[i];
+
+            break;
+    }
+}
+
+static unsigned long long words_count_generic(const uint64_t *words,
+    size_t n)
+{
+    unsigned long long total = 0;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        total += __builtin_popcountll(words[i]);
+
+    return total;
+}
+
+static size_t words_skip_zero_generic(const uint64_t *words, size_t i,
+    size_t n)
+{
+    while ((i < n) && (words[i] == 0))
+        i++;
+
+    return i;
+}
+
+#ifdef BITSET_X86
+__attribute__((target("avx2")))
+static void words_op_avx2(uint64_t *dest, const uint64_t *src, size_t n,
+    enum bitset_op op)
+{
+    size_t i;
+    __m256i a, b;
+
+    for (i = 0; i < n - n % 4; i += 4) {
+        a = _mm256_loadu_si256((const __m256i *)(dest + i));
+        b = _mm256_loadu_si256((const __m256i *)(src + i));
+
+        switch (op) {
+            case BITSET_AND:
+                a = _mm256_and_si256(a, b);
+                break;
+
+            case BITSET_OR:
+                a = _mm256_or_si256(a, b);
+                break;
+
+            case BITSET_XOR:
+                a = _mm256_xor_si256(a, b);
+                break;
+
+            case BITSET_ANDNOT:
+                a = _mm256_andnot_si256(b, a);
+                break;
+        }
+
+        _mm256_storeu_si256((__m256i *)(dest + i), a);
+    }
+
+    words_op_generic(dest + i, src + i, n - i, op);
+}
+
+/*
+ * Counts the bits of every byte with two lookups, one for each half, and
+ * sums the bytes of every 64 bits lane at once.
+ */
+__attribute__((target("avx2,popcnt")))
+static unsigned long long words_count_avx2(const uint64_t *words, size_t n)
+{
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3,
+                                           1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3,
+                                           1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i low_mask = _mm256_set1_epi8(0x0f);
+    __m256i v, lo, hi, acc = _mm256_setzero_si256();
+    uint64_t lanes[4];
+    unsigned long long total;
+    size_t i;
+
+    for (i = 0; i < n - n % 4; i += 4) {
+        v = _mm256_loadu_si256((const __m256i *)(words + i));
+        lo = _mm256_and_si256(v, low_mask);
+        hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+        v = _mm256_add_epi8(_mm256_shuffle_epi8(table, lo),
+                            _mm256_shuffle_epi8(table, hi));
+
+        acc = _mm256_add_epi64(acc,
+                               _mm256_sad_epu8(v, _mm256_setzero_si256()));
+    }
+
+    _mm256_storeu_si256((__m256i *)lanes, acc);
+    total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+
+    for (; i < n; i++)
+        total += __builtin_popcountll(words[i]);
+
+    return total;
+}
+
+__attribute__((target("popcnt")))
+static unsigned long long words_count_popcnt(const uint64_t *words, size_t n)
+{
+    unsigned long long total = 0;
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        total += __builtin_popcountll(words[i]);
+
+    return total;
+}
+
+__attribute__((target("avx2")))
+static size_t words_skip_zero_avx2(const uint64_t *words, size_t i, size_t n)
+{
+    __m256i v;
+
+    for (; n - i >= 4; i += 4) {
+        v = _mm256_loadu_si256((const __m256i *)(words + i));
+
+        if (_mm256_testz_si256(v, v) == 0)
+            break;
+    }
+
+    return words_skip_zero_generic(words, i, n);
+}
+#endif
+
+static void words_op(uint64_t *dest, const uint64_t *src, size_t n,
+    enum bitset_op op)
+{
+#ifdef BITSET_X86
+    if ((n >= 4) && __builtin_cpu_supports("avx2")) {
+        words_op_avx2(dest, src, n, op);
+        return;
+    }
+#endif
+
+    words_op_generic(dest, src, n, op);
+}
+
+static unsigned long long words_count(const uint64_t *words, size_t n)
+{
+#ifdef BITSET_X86
+    if ((n >= 8) && __builtin_cpu_supports("avx2"))
+        return words_count_avx2(words, n);
+
+    if (__builtin_cpu_supports("popcnt"))
+        return words_count_popcnt(words, n);
+#endif
+
+    return words_count_generic(words, n);
+}
+
+/*
+ * Gets the first set bit, at @from or after it, among @n words, or -1 if
+ * there is none.
+ */
+static long long words_next(const uint64_t *words, size_t n,
+    unsigned long long from)
+{
+    size_t i = from / 64;
+    uint64_t w;
+
+    if (i >= n)
+        return -1;
+
+    w = words[i] & (~0ULL << (from % 64));
+
+    if (w == 0) {
+#ifdef BITSET_X86
+        if (__builtin_cpu_supports("avx2"))
+            i = words_skip_zero_avx2(words, i + 1, n);
+        else
+#endif
+            i = words_skip_zero_generic(words, i + 1, n);
+
+        if (i == n)
+            return -1;
+
+        w = words[i];
+    }
+
+    return (long long)(i * 64 + __builtin_ctzll(w));
+}
+
+/*
+ * Gets the last set bit among @n words, or -1 if there is none.
+ */
+static long long words_last(const uint64_t *words, size_t n)
+{
+    while (n > 0) {
+        n--;
+
+        if (words[n] != 0)
+            return (long long)(n * 64 + 63 - __builtin_clzll(words[n]));
+    }
+
+    return -1;
+}
+
+/*
+ *
+ * Chunks of compressed sets.
+ *
+ */
+
+/*
+ * Gets the position of the first value of an array chunk which is not
+ * below @low.
+ */
+static uint32_t chunk_lower_bound(const struct bchunk *c, uint32_t low)
+{
+    uint32_t first = 0, last = c->card, middle;
+
+    while (first < last) {
+        middle = first + (last - first) / 2;
+
+        if (c->values[middle] < low)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    return first;
+}
+
+static bool chunk_test(const struct bchunk *c, uint32_t low)
+{
+    uint32_t i;
+
+    if (c->bitmap)
+        return (c->words[low / 64] >> (low % 64)) & 1;
+
+    i = chunk_lower_bound(c, low);
+
+    return (i < c->card) && (c->values[i] == low);
+}
+
+static void chunk_release(struct bchunk *c)
+{
+    if (c->bitmap)
+        free(c->words);
+    else
+        free(c->values);
+
+    c->values = NULL;
+}
+
+static int chunk_to_bitmap(struct bchunk *c)
+{
+    uint64_t *words;
+    uint32_t i;
+
+    words = calloc(CHUNK_WORDS, sizeof(uint64_t));
+
+    if (NULL == words) {
+        cset_errno(CL_NO_MEM);
+        return -1;
+    }
+
+    for (i = 0; i < c->card; i++)
+        words[c->values[i] / 64] |= 1ULL << (c->values[i] % 64);
+
+    free(c->values);
+    c->words = words;
+    c->bitmap = true;
+    c->capacity = 0;
+
+    return 0;
+}
+
+/*
+ * Both layouts are valid for any number of members, so failing to convert a
+ * chunk is not an error, it just keeps taking more memory than needed.
+ */
+static void chunk_to_array(struct bchunk *c)
+{
+    uint16_t *values;
+    uint32_t i, n = 0;
+    uint64_t w;
+
+    values = malloc(((c->card > 0) ? c->card : 1) * sizeof(uint16_t));
+
+    if (NULL == values)
+        return;
+
+    for (i = 0; i < CHUNK_WORDS; i++) {
+        for (w = c->words[i]; w != 0; w &= w - 1)
+            values[n++] = (uint16_t)(i * 64 + __builtin_ctzll(w));
+    }
+
+    free(c->words);
+    c->values = values;
+    c->bitmap = false;
+    c->capacity = n;
+}
+
+static void chunk_normalize(struct bchunk *c)
+{
+    if (c->bitmap && (c->card <= CHUNK_ARRAY_MAX))
+        chunk_to_array(c);
+}
+
+static int chunk_add(struct bchunk *c, uint32_t low)
+{
+    uint16_t *values;
+    uint32_t i, capacity;
+
+    if (!c->bitmap) {
+        i = chunk_lower_bound(c, low);
+
+        if ((i < c->card) && (c->values[i] == low))
+            return 0;
+
+        if (c->card == CHUNK_ARRAY_MAX) {
+            if (chunk_to_bitmap(c) < 0)
+                return -1;
+
+            return chunk_add(c, low);
+        }
+
+        if (c->card == c->capacity) {
+            capacity = (c->capacity > 0) ? c->capacity * 2
+                                         : CHUNK_ARRAY_MIN_CAPACITY;
+
+            if (capacity > CHUNK_ARRAY_MAX)
+                capacity = CHUNK_ARRAY_MAX;
+
+            values = realloc(c->values, capacity * sizeof(uint16_t));
+
+            if (NULL == values) {
+                cset_errno(CL_NO_MEM);
+                return -1;
+            }
+
+            c->values = values;
+            c->capacity = capacity;
+        }
+
+        memmove(c->values + i + 1, c->values + i,
+                (c->card - i) * sizeof(uint16_t));
+
+        c->values[i] = (uint16_t)low;
+        c->card++;
+
+        return 0;
+    }
+
+    if (!chunk_test(c, low)) {
+        c->words[low / 64] |= 1ULL << (low % 64);
+        c->card++;
+    }
+
+    return 0;
+}
+
+static void chunk_remove(struct bchunk *c, uint32_t low)
+{
+    uint32_t i;
+
+    if (!c->bitmap) {
+        i = chunk_lower_bound(c, low);
+
+        if ((i < c->card) && (c->values[i] == low)) {
+            memmove(c->values + i, c->values + i + 1,
+                    (c->card - i - 1) * sizeof(uint16_t));
+
+            c->card--;
+        }
+
+        return;
+    }
+
+    if (chunk_test(c, low)) {
+        c->words[low / 64] &= ~(1ULL << (low % 64));
+        c->card--;
+
+        if (c->card <= CHUNK_ARRAY_MAX / 2)
+            chunk_to_array(c);
+    }
+}
+
+static long long chunk_next(const struct bchunk *c, uint32_t low)
+{
+    uint32_t i;
+
+    if (c->bitmap)
+        return words_next(c->words, CHUNK_WORDS, low);
+
+    i = chunk_lower_bound(c, low);
+
+    return (i < c->card) ? c->values[i] : -1;
+}
+
+static uint32_t chunk_last(const struct bchunk *c)
+{
+    if (c->bitmap)
+        return (uint32_t)words_last(c->words, CHUNK_WORDS);
+
+    return c->values[c->card - 1];
+}
+
+static int chunk_dup(struct bchunk *dest, const struct bchunk *src)
+{
+    size_t size;
+
+    *dest = *src;
+    size = src->bitmap ? CHUNK_WORDS * sizeof(uint64_t)
+                       : src->card * sizeof(uint16_t);
+
+    dest->values = malloc((size > 0) ? size : 1);
+
+    if (NULL == dest->values) {
+        cset_errno(CL_NO_MEM);
+        return -1;
+    }
+
+    memcpy(dest->values, src->values, size);
+
+    if (!dest->bitmap)
+        dest->capacity = dest->card;
+
+    return 0;
+}
+
+/*
+ * Keeps, from the values of an array chunk, only the ones found, or not,
+ * in another chunk.
+ */
+static void chunk_filter(struct bchunk *c, const struct bchunk *other,
+    bool found)
+{
+    uint32_t i, n = 0;
+
+    for (i = 0; i < c->card; i++)
+        if (chunk_test(other, c->values[i]) == found)
+            c->values[n++] = c->values[i];
+
+    c->card = n;
+}
+
+/*
+ * Merges two array chunks, keeping the values found in any of them, or in
+ * just one of them when @exclusive is set.
+ */
+static int chunk_merge(struct bchunk *c, const struct bchunk *other,
+    bool exclusive)
+{
+    uint16_t *values;
+    uint64_t *words;
+    uint32_t i = 0, j = 0, n = 0, capacity = c->card + other->card;
+
+    values = malloc(capacity * sizeof(uint16_t));
+
+    if (NULL == values) {
+        cset_errno(CL_NO_MEM);
+        return -1;
+    }
+
+    while ((i < c->card) || (j < other->card)) {
+        if ((j == other->card) ||
+            ((i < c->card) && (c->values[i] < other->values[j])))
+        {
+            values[n++] = c->values[i++];
+        } else if ((i == c->card) || (other->values[j] < c->values[i]))
+            values[n++] = other->values[j++];
+        else {
+            if (!exclusive)
+                values[n++] = c->values[i];
+
+            i++;
+            j++;
+        }
+    }
+
+    /*
+     * An array chunk can't hold more than CHUNK_ARRAY_MAX values, so a larger
+     * result becomes a bitmap at once, leaving the chunk untouched if that
+     * fails.
+     */
+    if (n > CHUNK_ARRAY_MAX) {
+        words = calloc(CHUNK_WORDS, sizeof(uint64_t));
+
+        if (NULL == words) {
+            free(values);
+            cset_errno(CL_NO_MEM);
+            return -1;
+        }
+
+        for (i = 0; i < n; i++)
+            words[values[i] / 64] |= 1ULL << (values[i] % 64);
+
+        free(values);
+        free(c->values);
+        c->words = words;
+        c->bitmap = true;
+        c->card = n;
+        c->capacity = 0;
+
+        return 0;
+    }
+
+    free(c->values);
+    c->values = values;
+    c->card = n;
+    c->capacity = capacity;
+
+    return 0;
+}
+
+/*
+ * Applies an operation between two chunks with the same key, storing the
+ * result in the first one. Results of AND are never larger than any of its
+ * operands, so an array chunk is only filtered, while the others use the
+ * chunk bits, when there are, with the same word loops of plain sets.
+ */
+static int chunk_op(struct bchunk *c, const struct bchunk *other,
+    enum bitset_op op)
+{
+    struct bchunk tmp;
+    uint32_t i, low;
+    bool found;
+
+    if (!c->bitmap) {
+        if ((op == BITSET_AND) || (op == BITSET_ANDNOT)) {
+            chunk_filter(c, other, op == BITSET_AND);
+            return 0;
+        }
+
+        if (!other->bitmap)
+            return chunk_merge(c, other, op == BITSET_XOR);
+
+        if (chunk_to_bitmap(c) < 0)
+            return -1;
+    }
+
+    if (other->bitmap) {
+        words_op(c->words, other->words, CHUNK_WORDS, op);
+        c->card = words_count(c->words, CHUNK_WORDS);
+        chunk_normalize(c);
+
+        return 0;
+    }
+
+    if (op == BITSET_AND) {
+        if (chunk_dup(&tmp, other) < 0)
+            return -1;
+
+        chunk_filter(&tmp, c, true);
+        chunk_release(c);
+        *c = tmp;
+
+        return 0;
+    }
+
+    /* Members of an array chunk are set, flipped or cleared one by one */
+    for (i = 0; i < other->card; i++) {
+        low = other->values[i];
+        found = chunk_test(c, low);
+
+        if (!found && (op != BITSET_ANDNOT)) {
+            c->words[low / 64] |= 1ULL << (low % 64);
+            c->card++;
+        } else if (found && (op != BITSET_OR)) {
+            c->words[low / 64] &= ~(1ULL << (low % 64));
+            c->card--;
+        }
+    }
+
+    chunk_normalize(c);
+
+    return 0;
+}
+
+/*
+ *
+ * Compressed sets.
+ *
+ */
+
+/*
+ * Gets the position of the first chunk whose key is not below @key.
+ */
+static unsigned int chunks_lower_bound(const bitset_s *b, uint32_t key)
+{
+    unsigned int first = 0, last = b->nchunks, middle;
+
+    while (first < last) {
+        middle = first + (last - first) / 2;
+
+        if (b->chunks[middle].key < key)
+            first = middle + 1;
+        else
+            last = middle;
+    }
+
+    return first;
+}
+
+static struct bchunk *find_chunk(const bitset_s *b, uint32_t key)
+{
+    unsigned int i = chunks_lower_bound(b, key);
+
+    if ((i < b->nchunks) && (b->chunks[i].key == key))
+        return &b->chunks[i];
+
+    return NULL;
+}
+
+static int reserve_chunks(bitset_s *b, unsigned int count)
+{
+    struct bchunk *chunks;
+    unsigned int capacity;
+
+    if (count <= b->chunks_capacity)
+        return 0;
+
+    capacity = (b->chunks_capacity > 0) ? b->chunks_capacity * 2 : 4;
+
+    if (capacity < count)
+        capacity = count;
+
+    chunks = realloc(b->chunks, capacity * sizeof(struct bchunk));
+
+    if (NULL == chunks) {
+        cset_errno(CL_NO_MEM);
+        return -1;
+    }
+
+    b->chunks = chunks;
+    b->chunks_capacity = capacity;
+
+    return 0;
+}
+
+static struct bchunk *insert_chunk(bitset_s *b, unsigned int i, uint32_t key)
+{
+    struct bchunk *c;
+
+    if (reserve_chunks(b, b->nchunks + 1) < 0)
+        return NULL;
+
+    memmove(b->chunks + i + 1, b->chunks + i,
+            (b->nchunks - i) * sizeof(struct bchunk));
+
+    b->nchunks++;
+    c = &b->chunks[i];
+    memset(c, 0, sizeof(struct bchunk));
+    c->key = (uint16_t)key;
+
+    return c;
+}
+
+static void remove_chunk(bitset_s *b, unsigned int i)
+{
+    chunk_release(&b->chunks[i]);
+    memmove(b->chunks + i, b->chunks + i + 1,
+            (b->nchunks - i - 1) * sizeof(struct bchunk));
+
+    b->nchunks--;
+}
+
+static int compressed_set(bitset_s *b, unsigned int bit)
+{
+    unsigned int i = chunks_lower_bound(b, bit >> 16);
+    struct bchunk *c;
+    int ret;
+
+    if ((i < b->nchunks) && (b->chunks[i].key == (bit >> 16)))
+        return chunk_add(&b->chunks[i], bit & 0xffff);
+
+    c = insert_chunk(b, i, bit >> 16);
+
+    if (NULL == c)
+        return -1;
+
+    ret = chunk_add(c, bit & 0xffff);
+
+    if (c->card == 0)
+        remove_chunk(b, i);
+
+    return ret;
+}
+
+static void compressed_clear(bitset_s *b, unsigned int bit)
+{
+    unsigned int i = chunks_lower_bound(b, bit >> 16);
+
+    if ((i == b->nchunks) || (b->chunks[i].key != (bit >> 16)))
+        return;
+
+    chunk_remove(&b->chunks[i], bit & 0xffff);
+
+    if (b->chunks[i].card == 0)
+        remove_chunk(b, i);
+}
+
+static long long compressed_next(const bitset_s *b, unsigned long long from)
+{
+    unsigned int i;
+    uint32_t low;
+    long long v;
+
+    if (from >= BITSET_MAX_BITS)
+        return -1;
+
+    i = chunks_lower_bound(b, from >> 16);
+
+    for (; i < b->nchunks; i++) {
+        low = (b->chunks[i].key == (from >> 16)) ? (from & 0xffff) : 0;
+        v = chunk_next(&b->chunks[i], low);
+
+        if (v >= 0)
+            return ((long long)b->chunks[i].key << 16) | v;
+    }
+
+    return -1;
+}
+
+static void release_chunks(bitset_s *b)
+{
+    unsigned int i;
+
+    for (i = 0; i < b->nchunks; i++)
+        chunk_release(&b->chunks[i]);
+
+    free(b->chunks);
+    b->chunks = NULL;
+    b->nchunks = 0;
+    b->chunks_capacity = 0;
+}
+
+/*
+ * Removes every member which is not below the set limit.
+ */
+static void compressed_truncate(bitset_s *b)
+{
+    struct bchunk *c;
+    unsigned long long low;
+    uint32_t i;
+
+    while ((b->nchunks > 0) &&
+           (((unsigned long long)b->chunks[b->nchunks - 1].key << 16)
+                >= b->limit))
+    {
+        remove_chunk(b, b->nchunks - 1);
+    }
+
+    if (b->nchunks == 0)
+        return;
+
+    c = &b->chunks[b->nchunks - 1];
+    low = b->limit - ((unsigned long long)c->key << 16);
+
+    if (low >= CHUNK_BITS)
+        return;
+
+    if (!c->bitmap)
+        c->card = chunk_lower_bound(c, (uint32_t)low);
+    else {
+        if (low % 64)
+            c->words[low / 64] &= (1ULL << (low % 64)) - 1;
+
+        for (i = (low + 63) / 64; i < CHUNK_WORDS; i++)
+            c->words[i] = 0;
+
+        c->card = words_count(c->words, CHUNK_WORDS);
+        chunk_normalize(c);
+    }
+
+    if (c->card == 0)
+        remove_chunk(b, b->nchunks - 1);
+}
+
+/*
+ * Applies an operation between two compressed sets, chunk by chunk, as
+ * their keys are merged. On failure the set is left valid, with part of the
+ * operation done.
+ */
+static int compressed_op(bitset_s *b, const bitset_s *other,
+    enum bitset_op op)
+{
+    struct bchunk *chunks;
+    unsigned int i = 0, j = 0, n = 0;
+    unsigned int capacity = b->nchunks + other->nchunks + 1;
+    int ret = 0;
+
+    chunks = malloc(capacity * sizeof(struct bchunk));
+
+    if (NULL == chunks) {
+        cset_errno(CL_NO_MEM);
+        return -1;
+    }
+
+    while ((i < b->nchunks) || (j < other->nchunks)) {
+        if (ret < 0) {
+            /* Keeps what is left, untouched */
+            memcpy(chunks + n, b->chunks + i,
+                   (b->nchunks - i) * sizeof(struct bchunk));
+
+            n += b->nchunks - i;
+            break;
+        }
+
+        if ((j == other->nchunks) ||
+            ((i < b->nchunks) && (b->chunks[i].key < other->chunks[j].key)))
+        {
+            if (op == BITSET_AND)
+                chunk_release(&b->chunks[i]);
+            else
+                chunks[n++] = b->chunks[i];
+
+            i++;
+        } else if ((i == b->nchunks) ||
+                   (other->chunks[j].key < b->chunks[i].key))
+        {
+            if ((op == BITSET_OR) || (op == BITSET_XOR)) {
+                ret = chunk_dup(&chunks[n], &other->chunks[j]);
+
+                if (ret == 0)
+                    n++;
+            }
+
+            j++;
+        } else {
+            ret = chunk_op(&b->chunks[i], &other->chunks[j], op);
+
+            if (b->chunks[i].card == 0)
+                chunk_release(&b->chunks[i]);
+            else
+                chunks[n++] = b->chunks[i];
+
+            i++;
+            j++;
+        }
+    }
+
+    free(b->chunks);
+    b->chunks = chunks;
+    b->nchunks = n;
+    b->chunks_capacity = capacity;
+
+    if (!is_growable(b))
+        compressed_truncate(b);
+
+    return ret;
+}
+
+/*
+ *
+ * Plain sets.
+ *
+ */
+
+static int reserve_words(bitset_s *b, unsigned long long nwords)
+{
+    uint64_t *words;
+    unsigned long long capacity;
+
+    if (nwords <= b->nwords)
+        return 0;
+
+    capacity = (b->nwords > 0) ? (unsigned long long)b->nwords * 2 : 1;
+
+    if (capacity < nwords)
+        capacity = nwords;
+
+    if (capacity > BITSET_MAX_WORDS)
+        capacity = BITSET_MAX_WORDS;
+
+    words = realloc(b->words, capacity * sizeof(uint64_t));
+
+    if (NULL == words) {
+        cset_errno(CL_NO_MEM);
+        return -1;
+    }
+
+    memset(words + b->nwords, 0, (capacity - b->nwords) * sizeof(uint64_t));
+    b->words = words;
+    b->nwords = (unsigned int)capacity;
+
+    return 0;
+}
+
+/*
+ * Clears the bits of the last word beyond the limit of a set which is not
+ * growable, where they may be left by an operation.
+ */
+static void mask_last_word(bitset_s *b)
+{
+    if (!is_growable(b) && (b->limit % 64) && (b->nwords > 0))
+        b->words[b->nwords - 1] &= (1ULL << (b->limit % 64)) - 1;
+}
+
+static void plain_op(bitset_s *b, const uint64_t *words, size_t nwords,
+    enum bitset_op op)
+{
+    size_t n = (nwords < b->nwords) ? nwords : b->nwords;
+
+    words_op(b->words, words, n, op);
+
+    if ((op == BITSET_AND) && (n < b->nwords))
+        memset(b->words + n, 0, (b->nwords - n) * sizeof(uint64_t));
+
+    mask_last_word(b);
+}
+
+/*
+ *
+ * Sets, whatever their representation.
+ *
+ */
+
+static long long next_bit(const bitset_s *b, unsigned long long from)
+{
+    if (is_compressed(b))
+        return compressed_next(b, from);
+
+    return words_next(b->words, b->nwords, from);
+}
+
+static long long last_bit(const bitset_s *b)
+{
+    if (is_compressed(b)) {
+        if (b->nchunks == 0)
+            return -1;
+
+        return ((long long)b->chunks[b->nchunks - 1].key << 16) |
+               chunk_last(&b->chunks[b->nchunks - 1]);
+    }
+
+    return words_last(b->words, b->nwords);
+}
+
+static int set_bit(bitset_s *b, unsigned int bit)
+{
+    if (bit >= b->limit) {
+        cset_errno(CL_NUMBER_RANGE);
+        return -1;
+    }
+
+    if (is_compressed(b))
+        return compressed_set(b, bit);
+
+    if (reserve_words(b, (unsigned long long)bit / 64 + 1) < 0)
+        return -1;
+
+    b->words[bit / 64] |= 1ULL << (bit % 64);
+
+    return 0;
+}
+
+static void clear_bit(bitset_s *b, unsigned int bit)
+{
+    if (is_compressed(b))
+        compressed_clear(b, bit);
+    else if (bit / 64 < b->nwords)
+        b->words[bit / 64] &= ~(1ULL << (bit % 64));
+}
+
+static bool test_bit(const bitset_s *b, unsigned int bit)
+{
+    struct bchunk *c;
+
+    if (is_compressed(b)) {
+        c = find_chunk(b, bit >> 16);
+        return (c != NULL) && chunk_test(c, bit & 0xffff);
+    }
+
+    if (bit / 64 >= b->nwords)
+        return false;
+
+    return (b->words[bit / 64] >> (bit % 64)) & 1;
+}
+
+static unsigned long long count_bits(const bitset_s *b)
+{
+    unsigned long long total = 0;
+    unsigned int i;
+
+    if (!is_compressed(b))
+        return words_count(b->words, b->nwords);
+
+    for (i = 0; i < b->nchunks; i++)
+        total += b->chunks[i].card;
+
+    return total;
+}
+
+static void release_bits(bitset_s *b)
+{
+    release_chunks(b);
+    free(b->words);
+    b->words = NULL;
+    b->nwords = 0;
+}
+
+/*
+ * Fills a plain set, without its lock, with the members of a compressed one
+ * found among its first @nwords words.
+ */
+static int plain_from_compressed(bitset_s *tmp, const bitset_s *b,
+    size_t nwords)
+{
+    const struct bchunk *c;
+    size_t first, n;
+    unsigned int i, k;
+
+    memset(tmp, 0, sizeof(bitset_s));
+    tmp->limit = BITSET_MAX_BITS;
+    tmp->flags = CL_BITSET_GROWABLE;
+
+    if (reserve_words(tmp, nwords) < 0)
+        return -1;
+
+    for (i = 0; i < b->nchunks; i++) {
+        c = &b->chunks[i];
+        first = (size_t)c->key * CHUNK_WORDS;
+
+        if (first >= nwords)
+            break;
+
+        if (c->bitmap) {
+            n = nwords - first;
+            memcpy(tmp->words + first, c->words,
+                   ((n < CHUNK_WORDS) ? n : CHUNK_WORDS) * sizeof(uint64_t));
+
+            continue;
+        }
+
+        for (k = 0; k < c->card; k++)
+            if (first + c->values[k] / 64 < nwords)
+                tmp->words[first + c->values[k] / 64] |=
+                    1ULL << (c->values[k] % 64);
+    }
+
+    return 0;
+}
+
+/*
+ * Fills a compressed set, without its lock, with the members of a plain one.
+ */
+static int compressed_from_plain(bitset_s *tmp, const bitset_s *b)
+{
+    struct bchunk *c;
+    uint64_t w;
+    size_t first, n, k;
+    unsigned long long card;
+
+    memset(tmp, 0, sizeof(bitset_s));
+    tmp->limit = BITSET_MAX_BITS;
+    tmp->flags = CL_BITSET_GROWABLE | CL_BITSET_COMPRESSED;
+
+    for (first = 0; first < b->nwords; first += CHUNK_WORDS) {
+        n = b->nwords - first;
+
+        if (n > CHUNK_WORDS)
+            n = CHUNK_WORDS;
+
+        card = words_count(b->words + first, n);
+
+        if (card == 0)
+            continue;
+
+        c = insert_chunk(tmp, tmp->nchunks, first / CHUNK_WORDS);
+
+        if (NULL == c)
+            goto error_block;
+
+        if (card > CHUNK_ARRAY_MAX) {
+            if (chunk_to_bitmap(c) < 0)
+                goto error_block;
+
+            memcpy(c->words, b->words + first, n * sizeof(uint64_t));
+            c->card = card;
+            continue;
+        }
+
+        c->values = malloc(card * sizeof(uint16_t));
+
+        if (NULL == c->values) {
+            cset_errno(CL_NO_MEM);
+            goto error_block;
+        }
+
+        c->capacity = card;
+
+        for (k = 0; k < n; k++)
+            for (w = b->words[first + k]; w != 0; w &= w - 1)
+                c->values[c->card++] = (uint16_t)(k * 64 +
+                                                  __builtin_ctzll(w));
+    }
+
+    return 0;
+
+error_block:
+    release_chunks(tmp);
+
+    return -1;
+}
+
+/*
+ * Applies an operation between two sets, converting the second one to the
+ * representation of the first when they differ. Only the part of it which
+ * may change the result is converted.
+ */
+static int apply_op(bitset_s *b, const bitset_s *other, enum bitset_op op)
+{
+    bitset_s tmp;
+    unsigned long long nwords;
+    long long last;
+    int ret;
+
+    if (b == other) {
+        if ((op == BITSET_XOR) || (op == BITSET_ANDNOT)) {
+            release_chunks(b);
+
+            if (b->words != NULL)
+                memset(b->words, 0, b->nwords * sizeof(uint64_t));
+        }
+
+        return 0;
+    }
+
+    if (is_compressed(b)) {
+        if (is_compressed(other))
+            return compressed_op(b, other, op);
+
+        if (compressed_from_plain(&tmp, other) < 0)
+            return -1;
+
+        ret = compressed_op(b, &tmp, op);
+        release_chunks(&tmp);
+
+        return ret;
+    }
+
+    if (((op == BITSET_OR) || (op == BITSET_XOR)) && is_growable(b)) {
+        last = last_bit(other);
+
+        if ((last >= 0) && (reserve_words(b, last / 64 + 1) < 0))
+            return -1;
+    }
+
+    if (!is_compressed(other)) {
+        plain_op(b, other->words, other->nwords, op);
+        return 0;
+    }
+
+    nwords = b->nwords;
+
+    if (plain_from_compressed(&tmp, other, nwords) < 0)
+        return -1;
+
+    plain_op(b, tmp.words, nwords, op);
+    free(tmp.words);
+
+    return 0;
+}
+
+static int dup_bits(bitset_s *dest, const bitset_s *src)
+{
+    unsigned int i;
+
+    if (src->nwords > 0) {
+        dest->words = malloc(src->nwords * sizeof(uint64_t));
+
+        if (NULL == dest->words) {
+            cset_errno(CL_NO_MEM);
+            return -1;
+        }
+
+        memcpy(dest->words, src->words, src->nwords * sizeof(uint64_t));
+        dest->nwords = src->nwords;
+    }
+
+    if (reserve_chunks(dest, src->nchunks) < 0)
+        return -1;
+
+    for (i = 0; i < src->nchunks; i++) {
+        if (chunk_dup(&dest->chunks[i], &src->chunks[i]) < 0)
+            return -1;
+
+        dest->nchunks++;
+    }
+
+    return 0;
+}
+
+static void destroy_bitset(const struct cl_ref_s *ref)
+{
+    bitset_s *b = cl_container_of(ref, bitset_s, ref);
+
+    if (NULL == b)
+        return;
+
+    release_bits(b);
+    pthread_rwlock_destroy(&b->lock);
+    free(b);
+    b = NULL;
+}
+
+static bitset_s *new_bitset(unsigned int size, unsigned int flags,
+    bool thread_safe)
+{
+    bitset_s *b = NULL;
+
+    if (flags & ~(CL_BITSET_GROWABLE | CL_BITSET_COMPRESSED)) {
+        cset_errno(CL_INVALID_VALUE);
+        return NULL;
+    }
+
+    b = calloc(1, sizeof(bitset_s));
+
+    if (NULL == b) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    b->flags = flags;
+    b->limit = (flags & CL_BITSET_GROWABLE) ? BITSET_MAX_BITS : size;
+
+    if (!(flags & CL_BITSET_COMPRESSED) &&
+        (reserve_words(b, words_for(size)) < 0))
+    {
+        free(b);
+        return NULL;
+    }
+
+    b->thread_safe = thread_safe;
+    pthread_rwlock_init(&b->lock, NULL);
+    typeof_set(CL_OBJ_BITSET, b);
+
+    b->ref.free = destroy_bitset;
+    b->ref.count = 1;
+
+    return b;
+}
+
+/*
+ * Gives to a set, which was filled while growable, the size requested by
+ * @flags: the one of its largest member plus one.
+ */
+static int fit_bitset(bitset_s *b, unsigned int flags)
+{
+    uint64_t *words;
+    unsigned long long nwords;
+
+    if (flags & CL_BITSET_GROWABLE)
+        return 0;
+
+    b->flags = flags;
+    b->limit = last_bit(b) + 1;
+    nwords = words_for(b->limit);
+
+    if (is_compressed(b) || (nwords == b->nwords))
+        return 0;
+
+    if (nwords == 0) {
+        free(b->words);
+        b->words = NULL;
+        b->nwords = 0;
+
+        return 0;
+    }
+
+    words = realloc(b->words, nwords * sizeof(uint64_t));
+
+    if (NULL == words) {
+        cset_errno(CL_NO_MEM);
+        return -1;
+    }
+
+    b->words = words;
+    b->nwords = nwords;
+
+    return 0;
+}
+
+/*
+ * Gets the number held by a cl_object_t, which must be an integer fitting
+ * in an unsigned int.
+ */
+static int object_to_bit(const cl_object_t *object, unsigned int *bit)
+{
+    long long v;
+
+    switch (cl_object_type(object)) {
+        case CL_CHAR:
+            v = CL_OBJECT_AS_CHAR(object);
+            break;
+
+        case CL_UCHAR:
+            v = CL_OBJECT_AS_UCHAR(object);
+            break;
+
+        case CL_INT:
+            v = CL_OBJECT_AS_INT(object);
+            break;
+
+        case CL_UINT:
+            v = CL_OBJECT_AS_UINT(object);
+            break;
+
+        case CL_SINT:
+            v = CL_OBJECT_AS_SINT(object);
+            break;
+
+        case CL_USINT:
+            v = CL_OBJECT_AS_USINT(object);
+            break;
+
+        case CL_LONG:
+            v = CL_OBJECT_AS_LONG(object);
+            break;
+
+        case CL_ULONG:
+            if (CL_OBJECT_AS_ULONG(object) > UINT_MAX)
+                v = -1;
+            else
+                v = CL_OBJECT_AS_ULONG(object);
+
+            break;
+
+        case CL_LLONG:
+            v = CL_OBJECT_AS_LLONG(object);
+            break;
+
+        case CL_ULLONG:
+            if (CL_OBJECT_AS_ULLONG(object) > UINT_MAX)
+                v = -1;
+            else
+                v = CL_OBJECT_AS_ULLONG(object);
+
+            break;
+
+        default:
+            cset_errno(CL_UNSUPPORTED_TYPE);
+            return -1;
+    }
+
+    if ((v < 0) || (v > UINT_MAX)) {
+        cset_errno(CL_NUMBER_RANGE);
+        return -1;
+    }
+
+    *bit = (unsigned int)v;
+
+    return 0;
+}
+
+static int json_to_bit(const cl_json_t *item, unsigned int *bit)
+{
+    cl_string_t *value;
+    long long v;
+
+    if (cl_json_get_object_type(item) != CL_JSON_NUMBER) {
+        cset_errno(CL_UNSUPPORTED_TYPE);
+        return -1;
+    }
+
+    value = cl_json_get_object_value(item);
+    v = cl_string_to_long_long(value);
+
+    if ((v < 0) || (v > UINT_MAX)) {
+        cset_errno(CL_NUMBER_RANGE);
+        return -1;
+    }
+
+    *bit = (unsigned int)v;
+
+    return 0;
+}
+
+/*
+ *
+ * API
+ *
+ */
+
+__PUB_API__ cl_bitset_t *cl_bitset_ref(cl_bitset_t *bitset)
+{
+    bitset_s *b = (bitset_s *)bitset;
+
+    __clib_function_init__(true, bitset, CL_OBJ_BITSET, NULL);
+    cl_ref_inc(&b->ref);
+
+    return bitset;
+}
+
+__PUB_API__ int cl_bitset_unref(cl_bitset_t *bitset)
+{
+    bitset_s *b = (bitset_s *)bitset;
+
+    __clib_function_init__(true, bitset, CL_OBJ_BITSET, -1);
+    cl_ref_dec(&b->ref);
+
+    return 0;
+}
+
+__PUB_API__ cl_bitset_t *cl_bitset_create(unsigned int size,
+    unsigned int flags, bool thread_safe)
+{
+    __clib_function_init__(false, NULL, -1, NULL);
+
+    return new_bitset(size, flags, thread_safe);
+}
+
+__PUB_API__ int cl_bitset_destroy(cl_bitset_t *bitset)
+{
+    return cl_bitset_unref(bitset);
+}
+
+__PUB_API__ cl_bitset_t *cl_bitset_dup(cl_bitset_t *bitset)
+{
+    bitset_s *b = (bitset_s *)bitset, *d;
+    int ret;
+
+    __clib_function_init__(true, bitset, CL_OBJ_BITSET, NULL);
+    d = new_bitset(0, b->flags | CL_BITSET_COMPRESSED, b->thread_safe);
+
+    if (NULL == d)
+        return NULL;
+
+    read_lock(b);
+    d->flags = b->flags;
+    d->limit = b->limit;
+    ret = dup_bits(d, b);
+    unlock(b);
+
+    if (ret < 0) {
+        cl_ref_dec(&d->ref);
+        return NULL;
+    }
+
+    return d;
+}
+
+__PUB_API__ int cl_bitset_set(cl_bitset_t *bitset, unsigned int bit)
+{
+    bitset_s *b = (bitset_s *)bitset;
+    int ret;
+
+    __clib_function_init__(true, bitset, CL_OBJ_BITSET, -1);
+    write_lock(b);
+    ret = set_bit(b, bit);
+    unlock(b);
+
+    return ret;
+}
+
+__PUB_API__ int cl_bitset_clear(cl_bitset_t *bitset, unsigned int bit)
+{
+    bitset_s *b = (bitset_s *)bitset;
+
+    __clib_function_init__(true, bitset, CL_OBJ_BITSET, -1);
+    write_lock(b);
+    clear_bit(b, bit);
+    unlock(b);
+
+    return 0;
+}
+
+__PUB_API__ bool cl_bitset_test(cl_bitset_t *bitset, unsigned int bit)
+{
+    bitset_s *b = (bitset_s *)bitset;
+    bool ret;
+
+    __clib_function_init__(true, bitset, CL_OBJ_BITSET, false);
+    read_lock(b);
+    ret = test_bit(b, bit);
+    unlock(b);
+
+    return ret;
+}
+
+__PUB_API__ int cl_bitset_clear_all(cl_bitset_t *bitset)
+{
+    bitset_s *b = (bitset_s *)bitset;
+
+    __clib_function_init__(true, bitset, CL_OBJ_BITSET, -1);
+    write_lock(b);
+    release_chunks(b);
+
+    if (b->words != NULL)
+        memset(b->words, 0, b->nwords * sizeof(uint64_t));
+
+    unlock(b);
+
+    return 0;
+}
+
+__PUB_API__ long long cl_bitset_count(cl_bitset_t *bitset)
+{
+    bitset_s *b = (bitset_s *)bitset;
+    long long count;
+
+    __clib_function_init__(true, bitset, CL_OBJ_BITSET, -1);
+    read_lock(b);
+    count = (long long)count_bits(b);
+    unlock(b);
+
+    return count;
+}
+
+__PUB_API__ long long cl_bitset_next_set(cl_bitset_t *bitset,
+    unsigned int from)
+{
+    bitset_s *b = (bitset_s *)bitset;
+    long long bit;
+
+    __clib_function_init__(true, bitset, CL_OBJ_BITSET, -1);
+    read_lock(b);
+    bit = next_bit(b, from);
+    unlock(b);
+
+    if (bit < 0)
+        cset_errno(CL_OBJECT_NOT_FOUND);
+
+    return bit;
+}
+
+static int bitset_op(cl_bitset_t *bitset, cl_bitset_t *other,
+    enum bitset_op op)
+{
+    bitset_s *b = (bitset_s *)bitset;
+    bitset_s *o = (bitset_s *)other;
+    int ret;
+
+    __clib_function_init__(true, bitset, CL_OBJ_BITSET, -1);
+
+    if (typeof_validate_object(other, CL_OBJ_BITSET) == false)
+        return -1;
+
+    lock_pair(b, o);
+    ret = apply_op(b, o, op);
+    unlock_pair(b, o);
+
+    return ret;
+}
+
+__PUB_API__ int cl_bitset_and(cl_bitset_t *bitset, cl_bitset_t *other)
+{
+    return bitset_op(bitset, other, BITSET_AND);
+}
+
+__PUB_API__ int cl_bitset_or(cl_bitset_t *bitset, cl_bitset_t *other)
+{
+    return bitset_op(bitset, other, BITSET_OR);
+}
+
+__PUB_API__ int cl_bitset_xor(cl_bitset_t *bitset, cl_bitset_t *other)
+{
+    return bitset_op(bitset, other, BITSET_XOR);
+}
+
+__PUB_API__ int cl_bitset_andnot(cl_bitset_t *bitset, cl_bitset_t *other)
+{
+    return bitset_op(bitset, other, BITSET_ANDNOT);
+}
+
+__PUB_API__ cl_list_t *cl_bitset_to_list(cl_bitset_t *bitset)
+{
+    bitset_s *b = (bitset_s *)bitset;
+    cl_list_t *list = NULL;
+    cl_object_t *o;
+    long long bit;
+
+    __clib_function_init__(true, bitset, CL_OBJ_BITSET, NULL);
+    list = cl_list_create(NULL, NULL, NULL, NULL);
+
+    if (NULL == list)
+        return NULL;
+
+    read_lock(b);
+
+    for (bit = next_bit(b, 0); bit >= 0; bit = next_bit(b, bit + 1)) {
+        o = cl_object_create(CL_UINT, (unsigned int)bit, NULL);
+
+        if ((NULL == o) || (cl_list_unshift(list, o, -1) < 0)) {
+            if (o != NULL)
+                cl_object_destroy(o);
+
+            cl_list_destroy(list);
+            list = NULL;
+            break;
+        }
+    }
+
+    unlock(b);
+
+    return list;
+}
+
+__PUB_API__ cl_bitset_t *cl_bitset_from_list(const cl_list_t *list,
+    unsigned int flags, bool thread_safe)
+{
+    cl_list_iter_t *iter;
+    bitset_s *b;
+    enum cl_error_code error;
+    unsigned int bit;
+    int ret = 0;
+
+    __clib_function_init__(true, list, CL_OBJ_LIST, NULL);
+    b = new_bitset(0, flags | CL_BITSET_GROWABLE, thread_safe);
+
+    if (NULL == b)
+        return NULL;
+
+    iter = cl_list_iter_begin(list);
+
+    if (NULL == iter) {
+        cl_ref_dec(&b->ref);
+        return NULL;
+    }
+
+    while ((ret == 0) && (cl_list_iter_next(iter) != NULL)) {
+        ret = object_to_bit(cl_list_iter_content(iter), &bit);
+
+        if (ret == 0)
+            ret = set_bit(b, bit);
+    }
+
+    error = cl_get_last_error();
+    cl_list_iter_end(iter);
+    cset_errno(error);
+
+    if ((ret < 0) || (fit_bitset(b, flags) < 0)) {
+        cl_ref_dec(&b->ref);
+        return NULL;
+    }
+
+    return b;
+}
+
+__PUB_API__ cl_json_t *cl_bitset_to_json(cl_bitset_t *bitset)
+{
+    bitset_s *b = (bitset_s *)bitset;
+    cl_json_t *array = NULL, *item;
+    long long bit;
+
+    __clib_function_init__(true, bitset, CL_OBJ_BITSET, NULL);
+    array = cl_json_create_array();
+
+    if (NULL == array)
+        return NULL;
+
+    read_lock(b);
+
+    for (bit = next_bit(b, 0); bit >= 0; bit = next_bit(b, bit + 1)) {
+        item = cl_json_create_node(CL_JSON_NUMBER, "%llu",
+                                   (unsigned long long)bit);
+
+        if ((NULL == item) || (cl_json_add_item_to_array(array, item) < 0)) {
+            if (item != NULL)
+                cl_json_delete(item);
+
+            cl_json_delete(array);
+            array = NULL;
+            break;
+        }
+    }
+
+    unlock(b);
+
+    return array;
+}
+
+__PUB_API__ cl_bitset_t *cl_bitset_from_json(const cl_json_t *array,
+    unsigned int flags, bool thread_safe)
+{
+    bitset_s *b;
+    unsigned int bit;
+    int i, size, ret = 0;
+
+    __clib_function_init__(false, NULL, -1, NULL);
+
+    if (NULL == array) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    size = cl_json_get_array_size(array);
+
+    if (size < 0) {
+        cset_errno(CL_WRONG_TYPE);
+        return NULL;
+    }
+
+    b = new_bitset(0, flags | CL_BITSET_GROWABLE, thread_safe);
+
+    if (NULL == b)
+        return NULL;
+
+    /* Items are walked in order, which the array finds in constant time */
+    for (i = 0; (i < size) && (ret == 0); i++) {
+        ret = json_to_bit(cl_json_get_array_item(array, i), &bit);
+
+        if (ret == 0)
+            ret = set_bit(b, bit);
+    }
+
+    if ((ret < 0) || (fit_bitset(b, flags) < 0)) {
+        cl_ref_dec(&b->ref);
+        return NULL;
+    }
+
+    return b;
+}
+
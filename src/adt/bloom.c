@@ -0,0 +1,166 @@
+
+/*
+ * Description: Counting Bloom filter used internally by the containers.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 23:04:51 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "collections.h"
+
+/* Counters of a block, one cache line */
+#define CBLOOM_BLOCK_SIZE           64
+
+/* Counters set by each element */
+#define CBLOOM_HASHES               4
+
+/*
+ * Counters reserved for each element. With 4 hashes this keeps false
+ * positives around 2.5%.
+ */
+#define CBLOOM_COUNTERS_PER_ITEM    8
+
+#define CBLOOM_MIN_BLOCKS           4
+
+/* A counter that reached it is never decremented again */
+#define CBLOOM_MAX_COUNT            255
+
+/*
+ * The low half of the hash chooses the block and each group of 6 bits of
+ * the high half one counter inside it.
+ */
+static unsigned char *block_of(const struct cbloom *b, uint64_t hash)
+{
+    unsigned int block = (uint32_t)hash & (b->nblocks - 1);
+
+    return b->counters + (size_t)block * CBLOOM_BLOCK_SIZE;
+}
+
+static unsigned int counter_of(uint64_t hash, unsigned int i)
+{
+    return (hash >> (32 + 6 * i)) & (CBLOOM_BLOCK_SIZE - 1);
+}
+
+struct cbloom *cbloom_create(unsigned int expected)
+{
+    struct cbloom *b = NULL;
+    unsigned long long wanted;
+    unsigned int nblocks = CBLOOM_MIN_BLOCKS;
+
+    wanted = (unsigned long long)expected * CBLOOM_COUNTERS_PER_ITEM /
+             CBLOOM_BLOCK_SIZE;
+
+    while ((nblocks < wanted) && (nblocks < (1U << 31)))
+        nblocks <<= 1;
+
+    b = calloc(1, sizeof(struct cbloom));
+
+    if (NULL == b)
+        return NULL;
+
+    b->counters = calloc(nblocks, CBLOOM_BLOCK_SIZE);
+
+    if (NULL == b->counters) {
+        free(b);
+        return NULL;
+    }
+
+    b->nblocks = nblocks;
+
+    return b;
+}
+
+void cbloom_destroy(struct cbloom *b)
+{
+    if (NULL == b)
+        return;
+
+    free(b->counters);
+    free(b);
+}
+
+void cbloom_clear(struct cbloom *b)
+{
+    memset(b->counters, 0, (size_t)b->nblocks * CBLOOM_BLOCK_SIZE);
+    b->count = 0;
+}
+
+void cbloom_add(struct cbloom *b, uint64_t hash)
+{
+    unsigned char *block = block_of(b, hash);
+    unsigned int i, c;
+
+    for (i = 0; i < CBLOOM_HASHES; i++) {
+        c = counter_of(hash, i);
+
+        if (block[c] < CBLOOM_MAX_COUNT)
+            block[c]++;
+    }
+
+    b->count++;
+}
+
+/*
+ * The element must have been added before. Saturated counters are left
+ * alone since we no longer know how many elements share them.
+ */
+void cbloom_remove(struct cbloom *b, uint64_t hash)
+{
+    unsigned char *block = block_of(b, hash);
+    unsigned int i, c;
+
+    for (i = 0; i < CBLOOM_HASHES; i++) {
+        c = counter_of(hash, i);
+
+        if ((block[c] > 0) && (block[c] < CBLOOM_MAX_COUNT))
+            block[c]--;
+    }
+
+    if (b->count > 0)
+        b->count--;
+}
+
+bool cbloom_may_contain(const struct cbloom *b, uint64_t hash)
+{
+    const unsigned char *block = block_of(b, hash);
+    unsigned int i;
+
+    for (i = 0; i < CBLOOM_HASHES; i++)
+        if (block[counter_of(hash, i)] == 0)
+            return false;
+
+    return true;
+}
+
+/*
+ * Tells if the filter holds more elements than it was sized for, in which
+ * case its false positive rate starts to climb.
+ */
+bool cbloom_is_full(const struct cbloom *b)
+{
+    return b->count >
+        (unsigned long long)b->nblocks * CBLOOM_BLOCK_SIZE /
+        CBLOOM_COUNTERS_PER_ITEM;
+}
+
@@ -0,0 +1,710 @@
+
+/*
+ * Description: API to handle caches with a bounded capacity.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 23:44:32 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <pthread.h>
+
+#include "collections.h"
+
+/* Initial size of the hash table, which grows by itself */
+#define CACHE_TABLE_SIZE                64
+
+/* Share of the capacity, in percent, used by the TinyLFU window */
+#define CACHE_WINDOW_PERCENT            1
+
+/* Rows of the frequency sketch, each one indexed by a different hash */
+#define CACHE_SKETCH_ROWS               4
+
+/* Counters of every sketch row when it is created */
+#define CACHE_SKETCH_MIN_WIDTH          64
+
+/* Counters saturate here, an estimate doesn't need more than 4 bits */
+#define CACHE_SKETCH_MAX_COUNT          15
+
+/* Additions, per counter of a row, before every counter is halved */
+#define CACHE_SKETCH_SAMPLE_FACTOR      10
+
+/*
+ * An entry lives inside one of the recency lists, most recently used
+ * first. Its key is kept here too, so an evicted entry can be removed from
+ * the hash table.
+ */
+struct centry {
+    cl_list_entry_t     *prev;
+    cl_list_entry_t     *next;
+    void                *value;
+    cl_timeout_t        *timeout;
+    uint64_t            hash;
+    unsigned int        weight;
+    bool                in_window;
+    char                key[];
+};
+
+/*
+ * A count-min sketch estimating how many times each key was seen lately.
+ * Every counter is halved after a while, so old popularity fades away.
+ */
+struct csketch {
+    unsigned char       *counters;
+    unsigned int        width;
+    unsigned int        additions;
+};
+
+/*
+ * An LRU cache keeps every entry inside @main. A TinyLFU one puts new
+ * entries inside @window and moves them to @main when they leave it, if the
+ * sketch says they are used more often than the entry they would evict.
+ */
+#define cl_cache_members                                    \
+    cl_struct_member(cl_hashtable_t *, entries)             \
+    cl_struct_member(struct cdll_head, window)              \
+    cl_struct_member(struct cdll_head, main)                \
+    cl_struct_member(struct csketch, sketch)                \
+    cl_struct_member(enum cl_cache_policy, policy)          \
+    cl_struct_member(enum cl_cache_limit, limit)            \
+    cl_struct_member(unsigned long long, capacity)          \
+    cl_struct_member(unsigned long long, window_capacity)   \
+    cl_struct_member(unsigned long long, window_weight)     \
+    cl_struct_member(unsigned long long, main_weight)       \
+    cl_struct_member(unsigned int, count)                   \
+    cl_struct_member(void, (*release)(void *))              \
+    cl_struct_member(struct cl_cache_stats_s, stats)        \
+    cl_struct_member(bool, thread_safe)                     \
+    cl_struct_member(pthread_mutex_t, lock)                 \
+    cl_struct_member(struct cl_ref_s, ref)
+
+cl_struct_declare(cache_s, cl_cache_members);
+
+#define cache_s         cl_struct(cache_s)
+
+static void lock(cache_s *c)
+{
+    if (c->thread_safe)
+        pthread_mutex_lock(&c->lock);
+}
+
+static void unlock(cache_s *c)
+{
+    if (c->thread_safe)
+        pthread_mutex_unlock(&c->lock);
+}
+
+/*
+ *
+ * Frequency sketch.
+ *
+ */
+
+static int sketch_init(struct csketch *s, unsigned int width)
+{
+    unsigned char *counters;
+
+    counters = calloc((size_t)width * CACHE_SKETCH_ROWS, 1);
+
+    if (NULL == counters)
+        return -1;
+
+    free(s->counters);
+    s->counters = counters;
+    s->width = width;
+    s->additions = 0;
+
+    return 0;
+}
+
+static unsigned char *sketch_counter(const struct csketch *s, uint64_t hash,
+    unsigned int row)
+{
+    uint32_t h1 = (uint32_t)hash, h2 = (uint32_t)(hash >> 32) | 1;
+
+    return s->counters + (size_t)row * s->width +
+           ((h1 + row * h2) & (s->width - 1));
+}
+
+static void sketch_add(struct csketch *s, uint64_t hash)
+{
+    unsigned char *counter;
+    unsigned int i;
+
+    for (i = 0; i < CACHE_SKETCH_ROWS; i++) {
+        counter = sketch_counter(s, hash, i);
+
+        if (*counter < CACHE_SKETCH_MAX_COUNT)
+            (*counter)++;
+    }
+
+    if (++s->additions < s->width * CACHE_SKETCH_SAMPLE_FACTOR)
+        return;
+
+    for (i = 0; i < s->width * CACHE_SKETCH_ROWS; i++)
+        s->counters[i] >>= 1;
+
+    s->additions /= 2;
+}
+
+static unsigned int sketch_estimate(const struct csketch *s, uint64_t hash)
+{
+    unsigned int i, n, min = CACHE_SKETCH_MAX_COUNT;
+
+    for (i = 0; i < CACHE_SKETCH_ROWS; i++) {
+        n = *sketch_counter(s, hash, i);
+
+        if (n < min)
+            min = n;
+    }
+
+    return min;
+}
+
+/*
+ * Keeps the sketch rows at least as wide as the number of entries. The
+ * history is lost, but it only happens a few times while the cache fills.
+ */
+static void sketch_fit(cache_s *c)
+{
+    if ((c->policy == CL_CACHE_TINYLFU) && (c->count > c->sketch.width))
+        sketch_init(&c->sketch, c->sketch.width << 1);
+}
+
+/*
+ *
+ * Entries.
+ *
+ */
+
+static struct centry *new_entry(const char *key, void *value,
+    unsigned int weight, uint64_t hash, cl_timeout_t *timeout)
+{
+    struct centry *e = NULL;
+    size_t length = strlen(key);
+
+    e = calloc(1, sizeof(struct centry) + length + 1);
+
+    if (NULL == e) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    memcpy(e->key, key, length + 1);
+    e->value = value;
+    e->weight = weight;
+    e->hash = hash;
+    e->timeout = timeout;
+
+    return e;
+}
+
+static void destroy_entry(cache_s *c, struct centry *e)
+{
+    if (c->release != NULL)
+        (c->release)(e->value);
+
+    if (e->timeout != NULL)
+        cl_timeout_destroy(e->timeout);
+
+    free(e);
+}
+
+static bool is_expired(const struct centry *e)
+{
+    return (e->timeout != NULL) && cl_timeout_expired(e->timeout);
+}
+
+static void link_entry(cache_s *c, struct centry *e, bool in_window)
+{
+    e->in_window = in_window;
+
+    if (in_window == true) {
+        cdll_push(&c->window, e);
+        c->window_weight += e->weight;
+    } else {
+        cdll_push(&c->main, e);
+        c->main_weight += e->weight;
+    }
+}
+
+static void unlink_entry(cache_s *c, struct centry *e)
+{
+    if (e->in_window == true) {
+        cdll_remove(&c->window, e);
+        c->window_weight -= e->weight;
+    } else {
+        cdll_remove(&c->main, e);
+        c->main_weight -= e->weight;
+    }
+}
+
+/* Makes an entry the most recently used one of its list */
+static void touch_entry(cache_s *c, struct centry *e)
+{
+    struct cdll_head *head = (e->in_window == true) ? &c->window : &c->main;
+
+    if ((struct centry *)head->first == e)
+        return;
+
+    cdll_remove(head, e);
+    cdll_push(head, e);
+}
+
+static void drop_entry(cache_s *c, struct centry *e)
+{
+    unlink_entry(c, e);
+    cl_hashtable_delete(c->entries, e->key);
+    c->count--;
+    destroy_entry(c, e);
+}
+
+static void evict_entry(cache_s *c, struct centry *e)
+{
+    if (is_expired(e) == true)
+        c->stats.expirations++;
+    else
+        c->stats.evictions++;
+
+    drop_entry(c, e);
+}
+
+/*
+ * Evicts entries until the cache is back within its capacity. With TinyLFU
+ * the entries leaving the window are the candidates to enter the main list,
+ * and each one is compared with the main list victim, the loser being
+ * evicted.
+ */
+static void make_room(cache_s *c)
+{
+    unsigned long long main_capacity = c->capacity - c->window_capacity;
+    struct centry *candidate, *victim;
+
+    while (c->window_weight > c->window_capacity) {
+        candidate = (struct centry *)c->window.last;
+        unlink_entry(c, candidate);
+        link_entry(c, candidate, false);
+
+        while (c->main_weight > main_capacity) {
+            victim = (struct centry *)c->main.last;
+
+            if ((victim == candidate) || (is_expired(candidate) == true) ||
+                ((is_expired(victim) == false) &&
+                 (sketch_estimate(&c->sketch, candidate->hash) <=
+                  sketch_estimate(&c->sketch, victim->hash))))
+            {
+                evict_entry(c, candidate);
+                break;
+            }
+
+            evict_entry(c, victim);
+        }
+    }
+
+    while (c->main_weight > main_capacity)
+        evict_entry(c, (struct centry *)c->main.last);
+}
+
+static void destroy_list(cache_s *c, struct cdll_head *head)
+{
+    struct centry *e;
+
+    while ((e = cdll_pop(head)) != NULL)
+        destroy_entry(c, e);
+}
+
+static void destroy_cache(const struct cl_ref_s *ref)
+{
+    cache_s *c = cl_container_of(ref, cache_s, ref);
+
+    if (NULL == c)
+        return;
+
+    destroy_list(c, &c->window);
+    destroy_list(c, &c->main);
+
+    if (c->entries != NULL)
+        cl_hashtable_uninit(c->entries);
+
+    free(c->sketch.counters);
+    pthread_mutex_destroy(&c->lock);
+    free(c);
+    c = NULL;
+}
+
+static cache_s *new_cache(enum cl_cache_policy policy,
+    enum cl_cache_limit limit, unsigned long long capacity,
+    void (*release)(void *), bool thread_safe)
+{
+    cache_s *c = NULL;
+
+    c = calloc(1, sizeof(cache_s));
+
+    if (NULL == c) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    c->policy = policy;
+    c->limit = limit;
+    c->capacity = capacity;
+    c->release = release;
+    c->thread_safe = thread_safe;
+    cdll_init(&c->window);
+    cdll_init(&c->main);
+    pthread_mutex_init(&c->lock, NULL);
+    typeof_set(CL_OBJ_CACHE, c);
+
+    c->ref.free = destroy_cache;
+    c->ref.count = 1;
+
+    if (policy == CL_CACHE_TINYLFU) {
+        c->window_capacity = capacity * CACHE_WINDOW_PERCENT / 100;
+
+        /* The main list must keep some room, or every entry is refused */
+        if ((c->window_capacity == 0) && (capacity > 1))
+            c->window_capacity = 1;
+
+        if (sketch_init(&c->sketch, CACHE_SKETCH_MIN_WIDTH) < 0) {
+            cl_ref_dec(&c->ref);
+            cset_errno(CL_NO_MEM);
+            return NULL;
+        }
+    }
+
+    c->entries = cl_hashtable_init(CACHE_TABLE_SIZE, false, NULL, NULL);
+
+    if (NULL == c->entries) {
+        cl_ref_dec(&c->ref);
+        return NULL;
+    }
+
+    return c;
+}
+
+/*
+ * Looks for a key the way a reader does, removing it if expired and making
+ * it the most recently used entry otherwise. Must be called with the cache
+ * locked.
+ */
+static struct centry *lookup_entry(cache_s *c, const char *key)
+{
+    struct centry *e = NULL;
+
+    if (c->policy == CL_CACHE_TINYLFU)
+        sketch_add(&c->sketch, string_hash(key));
+
+    e = cl_hashtable_get(c->entries, key);
+
+    if ((e != NULL) && (is_expired(e) == true)) {
+        c->stats.expirations++;
+        drop_entry(c, e);
+        e = NULL;
+    }
+
+    if (NULL == e)
+        c->stats.misses++;
+    else {
+        c->stats.hits++;
+        touch_entry(c, e);
+    }
+
+    return e;
+}
+
+/*
+ *
+ * API
+ *
+ */
+
+__PUB_API__ cl_cache_t *cl_cache_ref(cl_cache_t *cache)
+{
+    cache_s *c = (cache_s *)cache;
+
+    __clib_function_init__(true, cache, CL_OBJ_CACHE, NULL);
+    cl_ref_inc(&c->ref);
+
+    return cache;
+}
+
+__PUB_API__ int cl_cache_unref(cl_cache_t *cache)
+{
+    cache_s *c = (cache_s *)cache;
+
+    __clib_function_init__(true, cache, CL_OBJ_CACHE, -1);
+    cl_ref_dec(&c->ref);
+
+    return 0;
+}
+
+__PUB_API__ cl_cache_t *cl_cache_create(enum cl_cache_policy policy,
+    enum cl_cache_limit limit, unsigned long long capacity,
+    void (*release)(void *), bool thread_safe)
+{
+    __clib_function_init__(false, NULL, -1, NULL);
+
+    if ((capacity == 0) ||
+        ((policy != CL_CACHE_LRU) && (policy != CL_CACHE_TINYLFU)) ||
+        ((limit != CL_CACHE_LIMIT_ENTRIES) && (limit != CL_CACHE_LIMIT_BYTES)))
+    {
+        cset_errno(CL_INVALID_VALUE);
+        return NULL;
+    }
+
+    return new_cache(policy, limit, capacity, release, thread_safe);
+}
+
+__PUB_API__ int cl_cache_destroy(cl_cache_t *cache)
+{
+    return cl_cache_unref(cache);
+}
+
+__PUB_API__ int cl_cache_put(cl_cache_t *cache, const char *key, void *value,
+    unsigned int size, unsigned int ttl)
+{
+    cache_s *c = (cache_s *)cache;
+    struct centry *e = NULL;
+    cl_timeout_t *timeout = NULL;
+    unsigned int weight;
+    uint64_t hash;
+
+    __clib_function_init__(true, cache, CL_OBJ_CACHE, -1);
+
+    if ((NULL == key) || (NULL == value)) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    weight = (c->limit == CL_CACHE_LIMIT_BYTES) ? size : 1;
+
+    /*
+     * Entries heavier than the main list would be evicted by make_room
+     * during their own insertion.
+     */
+    if (weight > c->capacity - c->window_capacity) {
+        cset_errno(CL_INVALID_VALUE);
+        return -1;
+    }
+
+    if (ttl > 0) {
+        timeout = cl_timeout_create(ttl, CL_TM_MSECONDS);
+
+        if (NULL == timeout)
+            return -1;
+    }
+
+    hash = string_hash(key);
+    lock(c);
+
+    if (c->policy == CL_CACHE_TINYLFU)
+        sketch_add(&c->sketch, hash);
+
+    e = cl_hashtable_get(c->entries, key);
+
+    if (e != NULL) {
+        if ((c->release != NULL) && (e->value != value))
+            (c->release)(e->value);
+
+        if (e->timeout != NULL)
+            cl_timeout_destroy(e->timeout);
+
+        unlink_entry(c, e);
+        e->value = value;
+        e->weight = weight;
+        e->timeout = timeout;
+        link_entry(c, e, e->in_window);
+    } else {
+        e = new_entry(key, value, weight, hash, timeout);
+
+        if (NULL == e)
+            goto error_block;
+
+        cl_hashtable_put(c->entries, e->key, e);
+
+        if (cl_get_last_error() != CL_NO_ERROR) {
+            free(e);
+            goto error_block;
+        }
+
+        link_entry(c, e, (c->policy == CL_CACHE_TINYLFU));
+        c->count++;
+        sketch_fit(c);
+    }
+
+    make_room(c);
+    unlock(c);
+
+    return 0;
+
+error_block:
+    unlock(c);
+
+    if (timeout != NULL)
+        cl_timeout_destroy(timeout);
+
+    return -1;
+}
+
+__PUB_API__ void *cl_cache_get(cl_cache_t *cache, const char *key)
+{
+    cache_s *c = (cache_s *)cache;
+    struct centry *e = NULL;
+    void *value = NULL;
+
+    __clib_function_init__(true, cache, CL_OBJ_CACHE, NULL);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    lock(c);
+    e = lookup_entry(c, key);
+
+    if (e != NULL)
+        value = e->value;
+
+    unlock(c);
+
+    return value;
+}
+
+__PUB_API__ int cl_cache_visit(cl_cache_t *cache, const char *key,
+    void (*foo)(const char *, void *, void *), void *data)
+{
+    cache_s *c = (cache_s *)cache;
+    struct centry *e = NULL;
+
+    __clib_function_init__(true, cache, CL_OBJ_CACHE, -1);
+
+    if ((NULL == key) || (NULL == foo)) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    lock(c);
+    e = lookup_entry(c, key);
+
+    if (e != NULL)
+        foo(e->key, e->value, data);
+    else
+        cset_errno(CL_OBJECT_NOT_FOUND);
+
+    unlock(c);
+
+    return (NULL == e) ? -1 : 0;
+}
+
+__PUB_API__ int cl_cache_delete(cl_cache_t *cache, const char *key)
+{
+    cache_s *c = (cache_s *)cache;
+    struct centry *e = NULL;
+
+    __clib_function_init__(true, cache, CL_OBJ_CACHE, -1);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    lock(c);
+    e = cl_hashtable_get(c->entries, key);
+
+    if (e != NULL)
+        drop_entry(c, e);
+
+    unlock(c);
+
+    if (NULL == e) {
+        cset_errno(CL_OBJECT_NOT_FOUND);
+        return -1;
+    }
+
+    return 0;
+}
+
+__PUB_API__ int cl_cache_expire(cl_cache_t *cache)
+{
+    cache_s *c = (cache_s *)cache;
+    struct cdll_head *heads[2];
+    struct centry *e, *next;
+    unsigned int i;
+    int n = 0;
+
+    __clib_function_init__(true, cache, CL_OBJ_CACHE, -1);
+    heads[0] = &c->window;
+    heads[1] = &c->main;
+    lock(c);
+
+    for (i = 0; i < 2; i++) {
+        for (e = (struct centry *)heads[i]->first; e != NULL; e = next) {
+            next = (struct centry *)e->next;
+
+            if (is_expired(e) == true) {
+                c->stats.expirations++;
+                drop_entry(c, e);
+                n++;
+            }
+        }
+    }
+
+    unlock(c);
+
+    return n;
+}
+
+__PUB_API__ int cl_cache_size(cl_cache_t *cache)
+{
+    cache_s *c = (cache_s *)cache;
+    int size;
+
+    __clib_function_init__(true, cache, CL_OBJ_CACHE, -1);
+    lock(c);
+    size = c->count;
+    unlock(c);
+
+    return size;
+}
+
+__PUB_API__ int cl_cache_stats(cl_cache_t *cache,
+    struct cl_cache_stats_s *stats)
+{
+    cache_s *c = (cache_s *)cache;
+
+    __clib_function_init__(true, cache, CL_OBJ_CACHE, -1);
+
+    if (NULL == stats) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    lock(c);
+    *stats = c->stats;
+    stats->entries = c->count;
+    stats->weight = c->window_weight + c->main_weight;
+    unlock(c);
+
+    return 0;
+}
+
@@ -0,0 +1,729 @@
+
+/*
+ * Description: Hash table API to be shared between threads.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 10:41:27 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+#include <pthread.h>
+
+#include "collections.h"
+
+/*
+ * The keys are split between several shards, chosen by the high bits of the
+ * key hash. Each shard is a chained hash table protected by its own mutex,
+ * which is only taken by writers.
+ *
+ * Readers walk the chains without any lock. Writers never change a node
+ * that is already reachable, except for its data pointer: a new node is
+ * linked at the head of its chain, a removed one is unlinked and the bucket
+ * array is copied, nodes included, when a shard grows.
+ *
+ * Nothing unlinked is released right away. It goes to a garbage list of the
+ * shard, tagged with the current epoch, and is only released once every
+ * reader that started before it was unlinked has finished (epoch based
+ * reclamation). A reader only publishes the epoch it started at in its own
+ * cache line, so lookups do not write to any shared memory.
+ */
+
+/* The default number of shards of a table */
+#define CHASHTABLE_DEFAULT_SHARDS           64
+
+/* The minimum number of buckets of a shard */
+#define CHASHTABLE_MIN_BUCKETS              8
+
+/* How many unlinked items a shard keeps before trying to release them */
+#define CHASHTABLE_GARBAGE_LIMIT            64
+
+#define CHASHTABLE_CACHE_LINE               64
+
+struct chashtable_garbage {
+    struct chashtable_garbage   *next;
+    unsigned long               epoch;
+};
+
+struct chashtable_node {
+    struct chashtable_garbage   gc;
+    struct chashtable_node      *next;
+    void                        *data;
+    uint64_t                    hash;
+    char                        key[];
+};
+
+struct chashtable_buckets {
+    struct chashtable_garbage   gc;
+    unsigned int                mask;
+    struct chashtable_node      *b[];
+};
+
+struct chashtable_shard {
+    pthread_mutex_t             lock;
+    struct chashtable_buckets   *buckets;
+    unsigned int                count;
+    struct chashtable_garbage   *garbage;
+    unsigned int                garbage_count;
+} __attribute__((aligned(CHASHTABLE_CACHE_LINE)));
+
+#define cl_chashtable_members                                   \
+    cl_struct_member(struct chashtable_shard *, shards)         \
+    cl_struct_member(unsigned int, nshards)                     \
+    cl_struct_member(unsigned int, shard_shift)                 \
+    cl_struct_member(bool, replace_data)                        \
+    cl_struct_member(void, (*release)(void *))                  \
+    cl_struct_member(struct cl_ref_s, ref)
+
+cl_struct_declare(chashtable_s, cl_chashtable_members);
+
+#define chashtable_s        cl_struct(chashtable_s)
+
+/*
+ *
+ * Readers registry.
+ *
+ * Every thread that reads from a cl_chashtable_t gets a record, kept until
+ * it exits and then reused by another thread. Records are never released.
+ *
+ */
+
+struct chashtable_reader {
+    unsigned long               epoch;  /* 0 while outside a lookup */
+    bool                        in_use;
+    struct chashtable_reader    *next;
+} __attribute__((aligned(CHASHTABLE_CACHE_LINE)));
+
+static struct chashtable_reader *__readers = NULL;
+static unsigned long __epoch = 1;
+static pthread_key_t __reader_key;
+static pthread_once_t __reader_once = PTHREAD_ONCE_INIT;
+static __thread struct chashtable_reader *__self = NULL;
+
+static void release_reader(void *p)
+{
+    struct chashtable_reader *r = (struct chashtable_reader *)p;
+
+    __atomic_store_n(&r->epoch, 0, __ATOMIC_RELEASE);
+    __atomic_store_n(&r->in_use, false, __ATOMIC_RELEASE);
+}
+
+static void create_reader_key(void)
+{
+    pthread_key_create(&__reader_key, release_reader);
+}
+
+static struct chashtable_reader *new_reader(void)
+{
+    struct chashtable_reader *r = NULL;
+    bool expected;
+
+    pthread_once(&__reader_once, create_reader_key);
+
+    /* Tries to reuse the record of a thread that has already finished */
+    for (r = __atomic_load_n(&__readers, __ATOMIC_ACQUIRE); r != NULL;
+         r = r->next)
+    {
+        expected = false;
+
+        if (__atomic_compare_exchange_n(&r->in_use, &expected, true, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+        {
+            goto end_block;
+        }
+    }
+
+    if (posix_memalign((void **)&r, CHASHTABLE_CACHE_LINE,
+                       sizeof(struct chashtable_reader)) != 0)
+    {
+        return NULL;
+    }
+
+    r->epoch = 0;
+    r->in_use = true;
+    r->next = __atomic_load_n(&__readers, __ATOMIC_RELAXED);
+
+    while (!__atomic_compare_exchange_n(&__readers, &r->next, r, true,
+                                        __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        ;
+
+end_block:
+    pthread_setspecific(__reader_key, r);
+
+    return r;
+}
+
+static struct chashtable_reader *reader_enter(void)
+{
+    struct chashtable_reader *r = __self;
+
+    if (NULL == r) {
+        r = new_reader();
+
+        if (NULL == r)
+            return NULL;
+
+        __self = r;
+    }
+
+    __atomic_store_n(&r->epoch, __atomic_load_n(&__epoch, __ATOMIC_ACQUIRE),
+                     __ATOMIC_RELAXED);
+
+    /* Pairs with the fence inside release_garbage */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    return r;
+}
+
+static void reader_leave(struct chashtable_reader *r)
+{
+    __atomic_store_n(&r->epoch, 0, __ATOMIC_RELEASE);
+}
+
+/*
+ * Gets the oldest epoch where a reader is still inside a lookup.
+ */
+static unsigned long oldest_reader_epoch(void)
+{
+    struct chashtable_reader *r;
+    unsigned long epoch, oldest = ULONG_MAX;
+
+    for (r = __atomic_load_n(&__readers, __ATOMIC_ACQUIRE); r != NULL;
+         r = r->next)
+    {
+        epoch = __atomic_load_n(&r->epoch, __ATOMIC_ACQUIRE);
+
+        if ((epoch != 0) && (epoch < oldest))
+            oldest = epoch;
+    }
+
+    return oldest;
+}
+
+/*
+ *
+ * Shards internal API. Every function here must be called with the shard
+ * lock held.
+ *
+ */
+
+static void release_garbage(struct chashtable_shard *shard)
+{
+    struct chashtable_garbage *g, **prev;
+    unsigned long oldest;
+
+    __atomic_add_fetch(&__epoch, 1, __ATOMIC_SEQ_CST);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    oldest = oldest_reader_epoch();
+    prev = &shard->garbage;
+
+    while (*prev != NULL) {
+        g = *prev;
+
+        if (g->epoch < oldest) {
+            *prev = g->next;
+            free(g);
+            shard->garbage_count--;
+        } else
+            prev = &g->next;
+    }
+}
+
+static void retire(struct chashtable_shard *shard,
+    struct chashtable_garbage *g)
+{
+    /*
+     * Keeps the epoch load from being done before the store which unlinked
+     * the item, otherwise a reader entering in between could still reach it
+     * with an epoch already older than the one it gets tagged with.
+     */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    g->epoch = __atomic_load_n(&__epoch, __ATOMIC_ACQUIRE);
+    g->next = shard->garbage;
+    shard->garbage = g;
+    shard->garbage_count++;
+
+    if (shard->garbage_count >= CHASHTABLE_GARBAGE_LIMIT)
+        release_garbage(shard);
+}
+
+static struct chashtable_buckets *new_buckets(unsigned int size)
+{
+    struct chashtable_buckets *b = NULL;
+    unsigned int n = CHASHTABLE_MIN_BUCKETS;
+
+    while ((n < size) && (n < (1U << 30)))
+        n <<= 1;
+
+    b = calloc(1, sizeof(struct chashtable_buckets) +
+                  n * sizeof(struct chashtable_node *));
+
+    if (NULL == b)
+        return NULL;
+
+    b->mask = n - 1;
+
+    return b;
+}
+
+static struct chashtable_node *new_node(const char *key, size_t key_size,
+    uint64_t hash, void *data)
+{
+    struct chashtable_node *n = NULL;
+
+    n = malloc(sizeof(struct chashtable_node) + key_size + 1);
+
+    if (NULL == n)
+        return NULL;
+
+    memcpy(n->key, key, key_size + 1);
+    n->hash = hash;
+    n->data = data;
+    n->next = NULL;
+
+    return n;
+}
+
+static struct chashtable_node **find_node(struct chashtable_buckets *b,
+    const char *key, uint64_t hash)
+{
+    struct chashtable_node **prev = &b->b[hash & b->mask];
+
+    for (; *prev != NULL; prev = &(*prev)->next)
+        if (((*prev)->hash == hash) && (strcmp((*prev)->key, key) == 0))
+            return prev;
+
+    return NULL;
+}
+
+static void link_node(struct chashtable_buckets *b, struct chashtable_node *n)
+{
+    struct chashtable_node **head = &b->b[n->hash & b->mask];
+
+    n->next = *head;
+    __atomic_store_n(head, n, __ATOMIC_RELEASE);
+}
+
+/*
+ * Doubles the number of buckets of a shard. Since readers may be walking the
+ * current chains, every node is copied into the new array and the old ones
+ * are retired. On failure the shard is left untouched.
+ */
+static void grow_shard(struct chashtable_shard *shard)
+{
+    struct chashtable_buckets *old = shard->buckets, *b;
+    struct chashtable_node *n, *next, *copy;
+    unsigned int i;
+
+    b = new_buckets((old->mask + 1) << 1);
+
+    if (NULL == b)
+        return;
+
+    for (i = 0; i <= old->mask; i++) {
+        for (n = old->b[i]; n != NULL; n = n->next) {
+            copy = new_node(n->key, strlen(n->key), n->hash, n->data);
+
+            if (NULL == copy)
+                goto error_block;
+
+            link_node(b, copy);
+        }
+    }
+
+    __atomic_store_n(&shard->buckets, b, __ATOMIC_RELEASE);
+
+    /* Retiring may already release a node, so its next is read before */
+    for (i = 0; i <= old->mask; i++) {
+        for (n = old->b[i]; n != NULL; n = next) {
+            next = n->next;
+            retire(shard, &n->gc);
+        }
+    }
+
+    retire(shard, &old->gc);
+
+    return;
+
+error_block:
+    /* Nobody has seen the new array yet, so it may be released right now */
+    for (i = 0; i <= b->mask; i++) {
+        while (b->b[i] != NULL) {
+            n = b->b[i];
+            b->b[i] = n->next;
+            free(n);
+        }
+    }
+
+    free(b);
+}
+
+static void destroy_shard(struct chashtable_shard *shard,
+    void (*release)(void *))
+{
+    struct chashtable_garbage *g;
+    struct chashtable_node *n;
+    unsigned int i;
+
+    if (shard->buckets != NULL) {
+        for (i = 0; i <= shard->buckets->mask; i++) {
+            while (shard->buckets->b[i] != NULL) {
+                n = shard->buckets->b[i];
+                shard->buckets->b[i] = n->next;
+
+                if (release != NULL)
+                    (release)(n->data);
+
+                free(n);
+            }
+        }
+
+        free(shard->buckets);
+    }
+
+    while (shard->garbage != NULL) {
+        g = shard->garbage;
+        shard->garbage = g->next;
+        free(g);
+    }
+
+    pthread_mutex_destroy(&shard->lock);
+}
+
+/*
+ *
+ * Internal API
+ *
+ */
+
+static void destroy_chashtable_s(const struct cl_ref_s *ref)
+{
+    chashtable_s *h = cl_container_of(ref, chashtable_s, ref);
+    unsigned int i;
+
+    if (NULL == h)
+        return;
+
+    for (i = 0; i < h->nshards; i++)
+        destroy_shard(&h->shards[i], h->release);
+
+    free(h->shards);
+    free(h);
+    h = NULL;
+}
+
+static chashtable_s *new_chashtable_s(unsigned int size, unsigned int shards,
+    bool replace_data, void (*release)(void *))
+{
+    chashtable_s *h = NULL;
+    unsigned int i, bits = 0;
+
+    h = calloc(1, sizeof(chashtable_s));
+
+    if (NULL == h) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    if (shards == 0)
+        shards = CHASHTABLE_DEFAULT_SHARDS;
+
+    while (((1U << bits) < shards) && (bits < 16))
+        bits++;
+
+    h->nshards = 1U << bits;
+    h->shard_shift = 64 - bits;
+
+    if (posix_memalign((void **)&h->shards, CHASHTABLE_CACHE_LINE,
+                       h->nshards * sizeof(struct chashtable_shard)) != 0)
+    {
+        free(h);
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    memset(h->shards, 0, h->nshards * sizeof(struct chashtable_shard));
+
+    for (i = 0; i < h->nshards; i++) {
+        pthread_mutex_init(&h->shards[i].lock, NULL);
+        h->shards[i].buckets = new_buckets(size / h->nshards);
+
+        if (NULL == h->shards[i].buckets) {
+            h->nshards = i + 1;
+            destroy_chashtable_s(&h->ref);
+            cset_errno(CL_NO_MEM);
+            return NULL;
+        }
+    }
+
+    h->replace_data = replace_data;
+    h->release = release;
+
+    /* Reference count */
+    h->ref.count = 1;
+    h->ref.free = destroy_chashtable_s;
+
+    typeof_set(CL_OBJ_CHASHTABLE, h);
+
+    return h;
+}
+
+static struct chashtable_shard *shard_of(chashtable_s *h, uint64_t hash)
+{
+    /* A shift by 64 is undefined, so a single shard is handled apart */
+    if (h->nshards == 1)
+        return &h->shards[0];
+
+    return &h->shards[hash >> h->shard_shift];
+}
+
+/*
+ * Looks for a key without any lock. Must be called between reader_enter and
+ * reader_leave.
+ */
+static struct chashtable_node *lookup(chashtable_s *h, const char *key,
+    uint64_t hash)
+{
+    struct chashtable_buckets *b;
+    struct chashtable_node *n;
+
+    b = __atomic_load_n(&shard_of(h, hash)->buckets, __ATOMIC_ACQUIRE);
+    n = __atomic_load_n(&b->b[hash & b->mask], __ATOMIC_ACQUIRE);
+
+    while (n != NULL) {
+        if ((n->hash == hash) && (strcmp(n->key, key) == 0))
+            return n;
+
+        n = __atomic_load_n(&n->next, __ATOMIC_ACQUIRE);
+    }
+
+    return NULL;
+}
+
+/*
+ *
+ * API
+ *
+ */
+
+__PUB_API__ cl_chashtable_t *cl_chashtable_ref(cl_chashtable_t *hashtable)
+{
+    chashtable_s *h = (chashtable_s *)hashtable;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_CHASHTABLE, NULL);
+    cl_ref_inc(&h->ref);
+
+    return hashtable;
+}
+
+__PUB_API__ int cl_chashtable_unref(cl_chashtable_t *hashtable)
+{
+    chashtable_s *h = (chashtable_s *)hashtable;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_CHASHTABLE, -1);
+    cl_ref_dec(&h->ref);
+
+    return 0;
+}
+
+__PUB_API__ cl_chashtable_t *cl_chashtable_init(unsigned int size,
+    unsigned int shards, bool replace_data, void (*release)(void *))
+{
+    __clib_function_init__(false, NULL, -1, NULL);
+
+    if (size == 0) {
+        cset_errno(CL_INVALID_VALUE);
+        return NULL;
+    }
+
+    return new_chashtable_s(size, shards, replace_data, release);
+}
+
+__PUB_API__ int cl_chashtable_uninit(cl_chashtable_t *hashtable)
+{
+    return cl_chashtable_unref(hashtable);
+}
+
+__PUB_API__ void *cl_chashtable_put(cl_chashtable_t *hashtable,
+    const char *key, void *data)
+{
+    chashtable_s *h = (chashtable_s *)hashtable;
+    struct chashtable_shard *shard;
+    struct chashtable_node **prev, *n;
+    uint64_t hash;
+    void *ret = NULL;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_CHASHTABLE, NULL);
+
+    if ((NULL == key) || (NULL == data)) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    hash = string_hash(key);
+    shard = shard_of(h, hash);
+    pthread_mutex_lock(&shard->lock);
+    prev = find_node(shard->buckets, key, hash);
+
+    if (prev != NULL) {
+        if (h->replace_data == false) {
+            /* The key is already being used */
+            cset_errno(CL_HASHTABLE_COLLISION);
+            goto end_block;
+        }
+
+        ret = __atomic_exchange_n(&(*prev)->data, data, __ATOMIC_ACQ_REL);
+        goto end_block;
+    }
+
+    n = new_node(key, strlen(key), hash, data);
+
+    if (NULL == n) {
+        cset_errno(CL_NO_MEM);
+        goto end_block;
+    }
+
+    if (shard->count >= shard->buckets->mask + 1)
+        grow_shard(shard);
+
+    link_node(shard->buckets, n);
+    __atomic_store_n(&shard->count, shard->count + 1, __ATOMIC_RELAXED);
+
+end_block:
+    pthread_mutex_unlock(&shard->lock);
+
+    return ret;
+}
+
+__PUB_API__ void *cl_chashtable_get(cl_chashtable_t *hashtable,
+    const char *key)
+{
+    chashtable_s *h = (chashtable_s *)hashtable;
+    struct chashtable_reader *r;
+    struct chashtable_node *n;
+    void *ptr = NULL;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_CHASHTABLE, NULL);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    r = reader_enter();
+
+    if (NULL == r) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    n = lookup(h, key, string_hash(key));
+
+    if (n != NULL)
+        ptr = __atomic_load_n(&n->data, __ATOMIC_ACQUIRE);
+
+    reader_leave(r);
+
+    return ptr;
+}
+
+__PUB_API__ int cl_chashtable_delete(cl_chashtable_t *hashtable,
+    const char *key)
+{
+    chashtable_s *h = (chashtable_s *)hashtable;
+    struct chashtable_shard *shard;
+    struct chashtable_node **prev, *n;
+    uint64_t hash;
+    int ret = -1;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_CHASHTABLE, -1);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    hash = string_hash(key);
+    shard = shard_of(h, hash);
+    pthread_mutex_lock(&shard->lock);
+    prev = find_node(shard->buckets, key, hash);
+
+    if (prev != NULL) {
+        n = *prev;
+
+        /* Readers standing at the node may still follow its next pointer */
+        __atomic_store_n(prev, n->next, __ATOMIC_RELEASE);
+        __atomic_store_n(&shard->count, shard->count - 1, __ATOMIC_RELAXED);
+        retire(shard, &n->gc);
+        ret = 0;
+    } else
+        cset_errno(CL_OBJECT_NOT_FOUND);
+
+    pthread_mutex_unlock(&shard->lock);
+
+    return ret;
+}
+
+__PUB_API__ bool cl_chashtable_contains_key(cl_chashtable_t *hashtable,
+    const char *key)
+{
+    chashtable_s *h = (chashtable_s *)hashtable;
+    struct chashtable_reader *r;
+    bool ret = false;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_CHASHTABLE, false);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return false;
+    }
+
+    r = reader_enter();
+
+    if (NULL == r) {
+        cset_errno(CL_NO_MEM);
+        return false;
+    }
+
+    if (lookup(h, key, string_hash(key)) != NULL)
+        ret = true;
+
+    reader_leave(r);
+
+    return ret;
+}
+
+__PUB_API__ int cl_chashtable_size(cl_chashtable_t *hashtable)
+{
+    chashtable_s *h = (chashtable_s *)hashtable;
+    unsigned int i;
+    int size = 0;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_CHASHTABLE, -1);
+
+    for (i = 0; i < h->nshards; i++)
+        size += __atomic_load_n(&h->shards[i].count, __ATOMIC_RELAXED);
+
+    return size;
+}
+
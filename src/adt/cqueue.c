@@ -26,15 +26,11 @@
 
 #include <stdlib.h>
 
-#include <pthread.h>
-
 #include "collections.h"
 
 #define cl_cqueue_members                      \
     cl_struct_member(unsigned int, max_size)        \
-    cl_struct_member(unsigned int, size)            \
     cl_struct_member(cl_queue_t *, queue)           \
-    cl_struct_member(pthread_mutex_t, lock)         \
     cl_struct_member(struct cl_ref_s, ref)
 
 cl_struct_declare(cl_cqueue_s, cl_cqueue_members);
@@ -67,7 +63,6 @@ static cl_cqueue_s *new_circular_queue_s(unsigned int max_size)
     }
 
     q->max_size = max_size;
-    pthread_mutex_init(&q->lock, NULL);
     typeof_set(CL_OBJ_CIRCULAR_QUEUE, q);
 
     /* Reference count */
@@ -123,7 +118,8 @@ __PUB_API__ cl_cqueue_t *cl_cqueue_create(unsigned int size,
     if (NULL == q)
         return NULL;
 
-    q->queue = cl_queue_create(unref_node, compare_to, filter, equals);
+    q->queue = cglist_create_ring(CL_OBJ_QUEUE, size, unref_node, compare_to,
+                                  filter, equals);
 
     if (NULL == q->queue) {
         cl_cqueue_unref(q);
@@ -145,7 +141,7 @@ __PUB_API__ int cl_cqueue_size(cl_cqueue_t *cqueue)
     int size;
 
     __clib_function_init__(true, cqueue, CL_OBJ_CIRCULAR_QUEUE, -1);
-    size = q->size;
+    size = cl_queue_size(q->queue);
     cl_cqueue_unref(q);
 
     return size;
@@ -156,20 +152,11 @@ __PUB_API__ int cl_cqueue_enqueue(cl_cqueue_t *cqueue,
 {
     cl_cqueue_s *q = cl_cqueue_ref(cqueue);
     int ret = -1;
-    cl_queue_node_t *node;
 
     __clib_function_init__(true, cqueue, CL_OBJ_CIRCULAR_QUEUE, -1);
-    pthread_mutex_lock(&q->lock);
-
-    if (q->size >= q->max_size) {
-        node = cl_queue_dequeue(q->queue);
-        cl_queue_node_unref(node);
-        q->size--;
-    }
 
+    /* When full, the ring itself drops the oldest element */
     ret = cl_queue_enqueue(q->queue, data, data_size);
-    q->size++;
-    pthread_mutex_unlock(&q->lock);
     cl_cqueue_unref(q);
 
     return ret;
@@ -181,16 +168,7 @@ __PUB_API__ cl_queue_node_t *cl_cqueue_dequeue(cl_cqueue_t *cqueue)
     cl_queue_node_t *node = NULL;
 
     __clib_function_init__(true, cqueue, CL_OBJ_CIRCULAR_QUEUE, NULL);
-    pthread_mutex_lock(&q->lock);
-
-    if (q->size == 0)
-        goto end_block;
-
     node = cl_queue_dequeue(q->queue);
-    q->size--;
-
-end_block:
-    pthread_mutex_unlock(&q->lock);
     cl_cqueue_unref(q);
 
     return node;
@@ -320,7 +298,7 @@ __PUB_API__ cl_cqueue_t *cl_cqueue_move(cl_cqueue_t *cqueue)
     cl_cqueue_s *n = NULL;
 
     __clib_function_init__(true, cqueue, CL_OBJ_CIRCULAR_QUEUE, NULL);
-    n = new_circular_queue_s(q->size);
+    n = new_circular_queue_s(q->max_size);
 
     if (NULL == n) {
         cl_cqueue_unref(q);
@@ -345,7 +323,7 @@ __PUB_API__ cl_cqueue_t *cl_cqueue_filter(cl_cqueue_t *cqueue,
     cl_cqueue_s *n = NULL;
 
     __clib_function_init__(true, cqueue, CL_OBJ_CIRCULAR_QUEUE, NULL);
-    n = new_circular_queue_s(q->size);
+    n = new_circular_queue_s(q->max_size);
 
     if (NULL == n) {
         cl_cqueue_unref(q);
@@ -432,7 +410,7 @@ __PUB_API__ bool cl_cqueue_is_empty(cl_cqueue_t *cqueue)
     int size;
 
     __clib_function_init__(true, cqueue, CL_OBJ_CIRCULAR_QUEUE, false);
-    size = q->size;
+    size = cl_queue_size(q->queue);
     cl_cqueue_unref(q);
 
     return (size > 0) ? true : false;
@@ -26,15 +26,11 @@
 
 #include <stdlib.h>
 
-#include <pthread.h>
-
 #include "collections.h"
 
 #define cl_cstack_members                           \
     cl_struct_member(unsigned int, max_size)        \
-    cl_struct_member(unsigned int, size)            \
     cl_struct_member(cl_stack_t *, stack)           \
-    cl_struct_member(pthread_mutex_t, lock)         \
     cl_struct_member(struct cl_ref_s, ref)
 
 cl_struct_declare(cl_cstack_s, cl_cstack_members);
@@ -67,7 +63,6 @@ static cl_cstack_s *new_circular_stack_s(unsigned int max_size)
     }
 
     q->max_size = max_size;
-    pthread_mutex_init(&q->lock, NULL);
     typeof_set(CL_OBJ_CIRCULAR_STACK, q);
 
     /* Reference count */
@@ -123,7 +118,8 @@ __PUB_API__ cl_cstack_t *cl_cstack_create(unsigned int size,
     if (NULL == q)
         return NULL;
 
-    q->stack = cl_stack_create(unref_node, compare_to, filter, equals);
+    q->stack = cglist_create_ring(CL_OBJ_STACK, size, unref_node, compare_to,
+                                  filter, equals);
 
     if (NULL == q->stack) {
         cl_cstack_unref(q);
@@ -145,7 +141,7 @@ __PUB_API__ int cl_cstack_size(cl_cstack_t *cstack)
     int size;
 
     __clib_function_init__(true, cstack, CL_OBJ_CIRCULAR_STACK, -1);
-    size = q->size;
+    size = cl_stack_size(q->stack);
     cl_cstack_unref(q);
 
     return size;
@@ -156,20 +152,11 @@ __PUB_API__ int cl_cstack_push(cl_cstack_t *cstack,
 {
     cl_cstack_s *q = cl_cstack_ref(cstack);
     int ret = -1;
-    cl_stack_node_t *node;
 
     __clib_function_init__(true, cstack, CL_OBJ_CIRCULAR_STACK, -1);
-    pthread_mutex_lock(&q->lock);
-
-    if (q->size >= q->max_size) {
-        node = cglist_shift(q->stack, CL_OBJ_STACK);
-        cl_stack_node_unref(node);
-        q->size--;
-    }
 
+    /* When full, the ring itself drops the oldest element */
     ret = cl_stack_push(q->stack, data, data_size);
-    q->size++;
-    pthread_mutex_unlock(&q->lock);
     cl_cstack_unref(q);
 
     return ret;
@@ -181,16 +168,7 @@ __PUB_API__ cl_stack_node_t *cl_cstack_pop(cl_cstack_t *cstack)
     cl_stack_node_t *node = NULL;
 
     __clib_function_init__(true, cstack, CL_OBJ_CIRCULAR_STACK, NULL);
-    pthread_mutex_lock(&q->lock);
-
-    if (q->size == 0)
-        goto end_block;
-
     node = cl_stack_pop(q->stack);
-    q->size--;
-
-end_block:
-    pthread_mutex_unlock(&q->lock);
     cl_cstack_unref(q);
 
     return node;
@@ -320,7 +298,7 @@ __PUB_API__ cl_cstack_t *cl_cstack_move(cl_cstack_t *cstack)
     cl_cstack_s *n = NULL;
 
     __clib_function_init__(true, cstack, CL_OBJ_CIRCULAR_STACK, NULL);
-    n = new_circular_stack_s(q->size);
+    n = new_circular_stack_s(q->max_size);
 
     if (NULL == n) {
         cl_cstack_unref(q);
@@ -345,7 +323,7 @@ __PUB_API__ cl_cstack_t *cl_cstack_filter(cl_cstack_t *cstack,
     cl_cstack_s *n = NULL;
 
     __clib_function_init__(true, cstack, CL_OBJ_CIRCULAR_STACK, NULL);
-    n = new_circular_stack_s(q->size);
+    n = new_circular_stack_s(q->max_size);
 
     if (NULL == n) {
         cl_cstack_unref(q);
@@ -432,7 +410,7 @@ __PUB_API__ bool cl_cstack_is_empty(cl_cstack_t *cstack)
     int size;
 
     __clib_function_init__(true, cstack, CL_OBJ_CIRCULAR_STACK, false);
-    size = q->size;
+    size = cl_stack_size(q->stack);
     cl_cstack_unref(q);
 
     return (size > 0) ? true : false;
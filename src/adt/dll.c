@@ -430,33 +430,45 @@ static void *cl_dll_split(void *root)
     return tmp;
 }
 
+/*
+ * Merges two sorted lists iteratively, so long lists don't exhaust the
+ * stack.
+ */
 static void *cl_dll_merge(void *p1, void *p2, int (*cmp)(void *, void*))
 {
-    struct cl_dll_node *f = p1, *s = p2, *q;
-    int ret;
-
-    if (NULL == p1)
-        return p2;
+    struct cl_dll_node *f = p1, *s = p2, *head = NULL, *tail = NULL, *q;
+
+    while ((f != NULL) && (s != NULL)) {
+        /* The cmp function must return < 0 if @p1 is less than @p2 */
+        if (cmp(f, s) < 0) {
+            q = f;
+            f = f->next;
+        } else {
+            q = s;
+            s = s->next;
+        }
 
-    if (NULL == p2)
-        return p1;
+        q->prev = tail;
 
-    /* The cmp function must return < 0 if @p1 is less than @p2 */
-    ret = cmp(p1, p2);
+        if (NULL == tail)
+            head = q;
+        else
+            tail->next = q;
 
-    if (ret < 0) {
-        f->next = cl_dll_merge(f->next, s, cmp);
-        f->next->prev = f;
-        f->prev = NULL;
-        q = f;
-    } else {
-        s->next = cl_dll_merge(f, s->next, cmp);
-        s->next->prev = s;
-        s->prev = NULL;
-        q = s;
+        tail = q;
     }
 
-    return q;
+    q = (f != NULL) ? f : s;
+
+    if (NULL == tail)
+        return q;
+
+    tail->next = q;
+
+    if (q != NULL)
+        q->prev = tail;
+
+    return head;
 }
 
 /*
@@ -579,3 +591,349 @@ __PUB_API__ void *cl_dll_rotate(void *root, unsigned int n)
     return l;
 }
 
+
+/*
+ *
+ * Internal API, handling lists through a struct cdll_head.
+ *
+ */
+
+void cdll_init(struct cdll_head *head)
+{
+    head->first = NULL;
+    head->last = NULL;
+    head->count = 0;
+    head->cursor = NULL;
+    head->cursor_index = 0;
+    head->cursor_busy = false;
+}
+
+unsigned int cdll_size(const struct cdll_head *head)
+{
+    return head->count;
+}
+
+/*
+ * Pushes a new node at the beginning of the list.
+ */
+void cdll_push(struct cdll_head *head, void *node)
+{
+    struct cl_dll_node *p = node;
+
+    p->prev = NULL;
+    p->next = head->first;
+
+    if (head->first != NULL)
+        ((struct cl_dll_node *)head->first)->prev = p;
+    else
+        head->last = p;
+
+    head->first = p;
+    head->count++;
+
+    if (head->cursor != NULL)
+        head->cursor_index++;
+}
+
+/*
+ * Removes the node at the beginning of the list.
+ */
+void *cdll_pop(struct cdll_head *head)
+{
+    struct cl_dll_node *p = head->first;
+
+    if (NULL == p)
+        return NULL;
+
+    head->first = p->next;
+
+    if (p->next != NULL)
+        p->next->prev = NULL;
+    else
+        head->last = NULL;
+
+    if (head->cursor == p)
+        head->cursor = NULL;
+    else if (head->cursor != NULL)
+        head->cursor_index--;
+
+    head->count--;
+    p->next = NULL;
+    p->prev = NULL;
+
+    return p;
+}
+
+/*
+ * Appends a new node at the far end of the list.
+ */
+void cdll_unshift(struct cdll_head *head, void *node)
+{
+    struct cl_dll_node *p = node;
+
+    p->next = NULL;
+    p->prev = head->last;
+
+    if (head->last != NULL)
+        ((struct cl_dll_node *)head->last)->next = p;
+    else
+        head->first = p;
+
+    head->last = p;
+    head->count++;
+}
+
+/*
+ * Removes the node at the far end of the list.
+ */
+void *cdll_shift(struct cdll_head *head)
+{
+    struct cl_dll_node *p = head->last;
+
+    if (NULL == p)
+        return NULL;
+
+    head->last = p->prev;
+
+    if (p->prev != NULL)
+        p->prev->next = NULL;
+    else
+        head->first = NULL;
+
+    if (head->cursor == p)
+        head->cursor = NULL;
+
+    head->count--;
+    p->next = NULL;
+    p->prev = NULL;
+
+    return p;
+}
+
+/*
+ * Gets a node from a specific position, starting from whichever is closer:
+ * one of the ends of the list or the cursor. The cursor is left at the
+ * found node, unless another reader is using it.
+ */
+void *cdll_at(struct cdll_head *head, unsigned int index)
+{
+    struct cl_dll_node *p;
+    unsigned int i, distance, gap;
+    bool owner;
+
+    if (index >= head->count)
+        return NULL;
+
+    if (index <= head->count / 2) {
+        p = head->first;
+        i = 0;
+        distance = index;
+    } else {
+        p = head->last;
+        i = head->count - 1;
+        distance = i - index;
+    }
+
+    owner = !__atomic_test_and_set(&head->cursor_busy, __ATOMIC_ACQUIRE);
+
+    if ((owner == true) && (head->cursor != NULL)) {
+        gap = (head->cursor_index > index) ? head->cursor_index - index
+                                           : index - head->cursor_index;
+
+        if (gap < distance) {
+            p = head->cursor;
+            i = head->cursor_index;
+        }
+    }
+
+    for (; i < index; i++)
+        p = p->next;
+
+    for (; i > index; i--)
+        p = p->prev;
+
+    if (owner == true) {
+        head->cursor = p;
+        head->cursor_index = index;
+        __atomic_clear(&head->cursor_busy, __ATOMIC_RELEASE);
+    }
+
+    return p;
+}
+
+void *cdll_middle(struct cdll_head *head)
+{
+    return cdll_at(head, head->count / 2);
+}
+
+static void unlink_node(struct cdll_head *head, struct cl_dll_node *p)
+{
+    if (p->prev != NULL)
+        p->prev->next = p->next;
+    else
+        head->first = p->next;
+
+    if (p->next != NULL)
+        p->next->prev = p->prev;
+    else
+        head->last = p->prev;
+
+    head->count--;
+    p->next = NULL;
+    p->prev = NULL;
+}
+
+/*
+ * Unlinks a node, which must belong to @head, from the list. Since its
+ * position is unknown, the cursor is dropped.
+ */
+void cdll_remove(struct cdll_head *head, void *node)
+{
+    unlink_node(head, node);
+    head->cursor = NULL;
+}
+
+/*
+ * Unlinks the node at @index. The cursor moves to the node taking its
+ * place, so deleting nodes one after another from the same position does
+ * not walk the list again.
+ */
+void *cdll_delete_indexed(struct cdll_head *head, unsigned int index)
+{
+    struct cl_dll_node *p;
+
+    p = cdll_at(head, index);
+
+    if (NULL == p)
+        return NULL;
+
+    if (head->cursor == p)
+        head->cursor = p->next;
+    else if ((head->cursor != NULL) && (head->cursor_index > index))
+        head->cursor_index--;
+
+    unlink_node(head, p);
+
+    return p;
+}
+
+/*
+ * Moves every node for which @foo returns a non-zero value into the list
+ * @extracted. If @foo returns a negative value the search stops.
+ */
+void cdll_filter(struct cdll_head *head, struct cdll_head *extracted,
+    int (*foo)(void *, void *), void *data)
+{
+    struct cl_dll_node *p, *next;
+    int v;
+
+    for (p = head->first; p != NULL; p = next) {
+        next = p->next;
+        v = foo(p, data);
+
+        if (v == 0)
+            continue;
+
+        cdll_remove(head, p);
+        cdll_unshift(extracted, p);
+
+        if (v < 0)
+            break;
+    }
+}
+
+void cdll_move(struct cdll_head *from, struct cdll_head *to)
+{
+    *to = *from;
+    cdll_init(from);
+}
+
+/*
+ * Links all nodes of @from at the beginning, if @front is true, or at the
+ * far end of @head, leaving @from empty.
+ */
+void cdll_splice(struct cdll_head *head, struct cdll_head *from, bool front)
+{
+    struct cl_dll_node *first = from->first, *last = from->last;
+
+    if (NULL == first)
+        return;
+
+    if (NULL == head->first) {
+        head->first = first;
+        head->last = last;
+    } else if (front == true) {
+        last->next = head->first;
+        ((struct cl_dll_node *)head->first)->prev = last;
+        head->first = first;
+
+        if (head->cursor != NULL)
+            head->cursor_index += from->count;
+    } else {
+        first->prev = head->last;
+        ((struct cl_dll_node *)head->last)->next = first;
+        head->last = last;
+    }
+
+    head->count += from->count;
+    cdll_init(from);
+}
+
+void cdll_sort(struct cdll_head *head, int (*cmp)(void *, void *))
+{
+    struct cl_dll_node *p;
+
+    if (head->count < 2)
+        return;
+
+    head->cursor = NULL;
+    head->first = cl_dll_mergesort(head->first, cmp);
+
+    /* The merge does not give us the new tail */
+    for (p = head->first; p->next != NULL; p = p->next)
+        ;
+
+    head->last = p;
+}
+
+/*
+ * Rotates the list by @n positions, moving its last @n nodes to the
+ * beginning.
+ */
+void cdll_rotate(struct cdll_head *head, unsigned int n)
+{
+    struct cl_dll_node *p, *q, *first, *last;
+
+    if (head->count < 2)
+        return;
+
+    n %= head->count;
+
+    if (n == 0)
+        return;
+
+    p = cdll_at(head, head->count - n - 1);
+    q = p->next;
+    first = head->first;
+    last = head->last;
+
+    p->next = NULL;
+    q->prev = NULL;
+    last->next = first;
+    first->prev = last;
+
+    head->first = q;
+    head->last = p;
+    head->cursor = NULL;
+}
+
+void cdll_free(struct cdll_head *head, void (*foo)(void *))
+{
+    void *p;
+
+    if (NULL == foo)
+        foo = free;
+
+    while ((p = cdll_pop(head)) != NULL)
+        foo(p);
+}
@@ -25,11 +25,24 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
 #include <pthread.h>
 
 #include "collections.h"
 
+/* How many nodes a pool allocates at once */
+#define GNODE_POOL_SLAB_SIZE        64
+
+/* Runs sorted by insertion before merging */
+#define GLIST_SORT_RUN              32
+
+/* Most threads used by a parallel sort */
+#define GLIST_SORT_MAX_THREADS      8
+
+struct gnode_pool;
+
 struct gnode_s {
     cl_list_entry_t         *prev;
     cl_list_entry_t         *next;
@@ -39,171 +52,1159 @@ struct gnode_s {
     enum cl_object          content_type;
     struct cl_ref_s         ref;
 
+    /* The content is a copy kept right after the node */
+    bool                    inline_content;
+
     /*
      * We save the pointer to the node free function here so we don't need
      * the list when release one.
      */
     void                (*free_data)(void *);
+
+    /* Where the node came from, if its list was created with a pool */
+    struct gnode_pool   *pool;
+};
+
+struct gnode_slab {
+    struct gnode_slab   *next;
+    struct gnode_s      nodes[GNODE_POOL_SLAB_SIZE];
+};
+
+/*
+ * A pool of reusable nodes. Since a node may outlive its list, the pool is
+ * only released when its lists are gone and every node is back to it.
+ */
+struct gnode_pool {
+    pthread_mutex_t     lock;
+    struct gnode_s      *free_nodes;
+    struct gnode_slab   *slabs;
+    unsigned int        users;
+    unsigned int        nfree;
+    unsigned int        nslabs;
+    unsigned long long  hits;
+    unsigned long long  misses;
+};
+
+/*
+ * Bounded storage used, instead of the linked list, by the circular queue
+ * and stack. @slots is a contiguous array of node pointers, the list starting
+ * at @head and wrapping around the end of the array. The nodes themselves are
+ * still allocated one by one, as in the linked list.
+ */
+struct gring {
+    struct gnode_s      **slots;
+    unsigned int        capacity;
+    unsigned int        head;
+    unsigned int        count;
 };
 
 #define CLIST_NODE_OFFSET           \
     (sizeof(cl_list_entry_t *) + sizeof(cl_list_entry_t *))
 
 #define clist_members                                       \
-    cl_struct_member(struct gnode_s *, list)                \
-    cl_struct_member(unsigned int, size)                    \
+    cl_struct_member(struct cdll_head, list)                \
     cl_struct_member(struct cl_ref_s, ref)                  \
     cl_struct_member(void, (*free_data)(void *))            \
     cl_struct_member(int, (*compare_to)(void *, void *))    \
     cl_struct_member(int, (*filter)(void *, void *))        \
     cl_struct_member(int, (*equals)(void *, void *))        \
-    cl_struct_member(pthread_mutex_t, lock)
+    cl_struct_member(struct gnode_pool *, pool)             \
+    cl_struct_member(struct gring *, ring)                  \
+    cl_struct_member(unsigned int, sort_threshold)          \
+    cl_struct_member(struct cbloom *, bloom)                \
+    cl_struct_member(unsigned long long, (*hash)(void *))   \
+    cl_struct_member(bool, inline_content)                  \
+    cl_struct_member(pthread_rwlock_t, lock)
+
+cl_struct_declare(glist_s, clist_members);
+
+#define glist_s     cl_struct(glist_s)
+
+/*
+ * A cursor over the nodes a list held when it was created, each one kept
+ * alive by a reference until the cursor ends, so the list itself is not
+ * locked while it walks. With no current node it sits before the first
+ * node or, if @past_end is true, after the last one.
+ */
+#define giter_members                                       \
+    cl_struct_member(struct gnode_s **, nodes)              \
+    cl_struct_member(unsigned int, count)                   \
+    cl_struct_member(struct gnode_s *, node)                \
+    cl_struct_member(unsigned int, index)                   \
+    cl_struct_member(bool, past_end)
+
+cl_struct_declare(giter_s, giter_members);
+
+#define giter_s     cl_struct(giter_s)
+
+/*
+ *
+ * Node pool.
+ *
+ */
+
+static struct gnode_pool *new_pool(void)
+{
+    struct gnode_pool *p = NULL;
+
+    p = calloc(1, sizeof(struct gnode_pool));
+
+    if (NULL == p) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    pthread_mutex_init(&p->lock, NULL);
+    p->users = 1;
+
+    return p;
+}
+
+static void destroy_pool(struct gnode_pool *pool)
+{
+    struct gnode_slab *s;
+
+    while (pool->slabs != NULL) {
+        s = pool->slabs;
+        pool->slabs = s->next;
+        free(s);
+    }
+
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+static void pool_ref(struct gnode_pool *pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->users++;
+    pthread_mutex_unlock(&pool->lock);
+}
+
+static void pool_unref(struct gnode_pool *pool)
+{
+    unsigned int users;
+
+    pthread_mutex_lock(&pool->lock);
+    users = --pool->users;
+    pthread_mutex_unlock(&pool->lock);
+
+    if (users == 0)
+        destroy_pool(pool);
+}
+
+/*
+ * Takes @count zeroed nodes from the pool, carving new slabs when it's empty,
+ * under a single lock. Returns how many nodes were taken, which is less than
+ * @count only if a slab could not be allocated.
+ */
+static unsigned int pool_get_many(struct gnode_pool *pool,
+    struct gnode_s **nodes, unsigned int count)
+{
+    struct gnode_slab *s;
+    struct gnode_s *n;
+    unsigned int i, taken;
+
+    pthread_mutex_lock(&pool->lock);
+
+    for (taken = 0; taken < count; taken++) {
+        if (NULL == pool->free_nodes) {
+            s = malloc(sizeof(struct gnode_slab));
+
+            if (NULL == s)
+                break;
+
+            for (i = 0; i < GNODE_POOL_SLAB_SIZE; i++) {
+                s->nodes[i].next = pool->free_nodes;
+                pool->free_nodes = &s->nodes[i];
+            }
+
+            s->next = pool->slabs;
+            pool->slabs = s;
+            pool->nslabs++;
+            pool->nfree += GNODE_POOL_SLAB_SIZE;
+            pool->misses++;
+        } else
+            pool->hits++;
+
+        n = pool->free_nodes;
+        pool->free_nodes = n->next;
+        pool->nfree--;
+        pool->users++;
+        nodes[taken] = n;
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+
+    for (i = 0; i < taken; i++) {
+        memset(nodes[i], 0, sizeof(struct gnode_s));
+        nodes[i]->pool = pool;
+    }
+
+    return taken;
+}
+
+static struct gnode_s *pool_get(struct gnode_pool *pool)
+{
+    struct gnode_s *n = NULL;
+
+    pool_get_many(pool, &n, 1);
+
+    return n;
+}
+
+static void pool_put(struct gnode_pool *pool, struct gnode_s *node)
+{
+    unsigned int users;
+
+    /* So a stale reference to the node is not taken as a valid one */
+    memset(&node->hdr, 0, sizeof(struct cl_object_hdr));
+    pthread_mutex_lock(&pool->lock);
+    node->next = pool->free_nodes;
+    pool->free_nodes = node;
+    pool->nfree++;
+    users = --pool->users;
+    pthread_mutex_unlock(&pool->lock);
+
+    if (users == 0)
+        destroy_pool(pool);
+}
+
+/*
+ * Duplicate internal glist_s members to another one.
+ */
+static void dup_internal_data(glist_s *orig, glist_s *dest)
+{
+    if ((NULL == orig) || (NULL == dest))
+        return;
+
+    dest->free_data = orig->free_data;
+    dest->filter = orig->filter;
+    dest->compare_to = orig->compare_to;
+    dest->equals = orig->equals;
+    dest->sort_threshold = orig->sort_threshold;
+    dest->hash = orig->hash;
+    dest->inline_content = orig->inline_content;
+
+    if (orig->pool != NULL) {
+        pool_ref(orig->pool);
+        dest->pool = orig->pool;
+    }
+}
+
+static bool is_cl_object(struct gnode_s *node)
+{
+    if (NULL == node)
+        return false;
+
+    /*
+     * If we're holding information smaller than a cl_object_hdr structure we
+     * don't even need to validate it.
+     */
+    if (node->content_size < CL_OBJECT_HEADER_ID_SIZE)
+        return false;
+
+    return typeof_validate_object(node->content, CL_OBJ_OBJECT);
+}
+
+/*
+ * Checks if we're holding cobjects inside the list. Returns true if does.
+ */
+static bool is_list_of_cobjects(glist_s *list)
+{
+    struct gnode_s *node = NULL;
+
+    if (list->ring != NULL) {
+        if (list->ring->count > 0)
+            node = list->ring->slots[list->ring->head];
+    } else
+        node = list->list.first;
+
+    return is_cl_object(node);
+}
+
+/*
+ * If we have a list of cobjects, this function uses its compare_to function
+ * to compare two cobjects.
+ */
+static int compare_cobjects(void *a, void *b)
+{
+    struct gnode_s *node_a = (struct gnode_s *)a;
+    struct gnode_s *node_b = (struct gnode_s *)b;
+    cl_object_t *ob1 = (cl_object_t *)node_a->content;
+    cl_object_t *ob2 = (cl_object_t *)node_b->content;
+
+    return cl_object_compare_to(ob1, ob2);
+}
+
+/*
+ * If we have a list of cobjects, this functions uses its equals function to
+ * compare two cobjects.
+ */
+static int cobjects_are_equal(void *a, void *b)
+{
+    struct gnode_s *node_a = (struct gnode_s *)a;
+    struct gnode_s *node_b = (struct gnode_s *)b;
+    cl_object_t *ob1 = (cl_object_t *)node_a->content;
+    cl_object_t *ob2 = (cl_object_t *)node_b->content;
+
+    return cl_object_equals(ob1, ob2);
+}
+
+/* Where the content of a list created with CL_LIST_INLINE_CONTENT is kept */
+static void *node_payload(struct gnode_s *node)
+{
+    return node + 1;
+}
+
+/*
+ * Releases the content of a node, checking which _free_ function will be used
+ * according the type of it.
+ */
+static void release_node_content(struct gnode_s *node)
+{
+    if (node->inline_content == true) {
+        if (node->free_data != NULL)
+            (node->free_data)(node->content);
+
+        return;
+    }
+
+    if (node->free_data != NULL)
+        (node->free_data)(node->content);
+    else {
+        /*
+         * If we're holding information smaller than a cl_object_hdr structure
+         * we don't even need to validate it and call free on it.
+         */
+        if (node->content_size < CL_OBJECT_HEADER_ID_SIZE)
+            free(node->content);
+        else {
+            /*
+             * If we're holding cl_object_t pointers we know how to destroy
+             * them.
+             */
+            if (typeof_validate_object(node->content, CL_OBJ_OBJECT) == true)
+                cl_object_destroy(node->content);
+        }
+    }
+}
+
+/*
+ * Releases a struct gnode_s from memory. Its content will also be released
+ * if @free_content is true.
+ */
+static void destroy_node(struct gnode_s *node, bool free_content)
+{
+    if (NULL == node)
+        return;
+
+    if (free_content == true)
+        release_node_content(node);
+
+    if (node->pool != NULL)
+        pool_put(node->pool, node);
+    else
+        free(node);
+
+    node = NULL;
+}
+
+/*
+ * The function to release a node called when a reference count from them drops
+ * to 0.
+ */
+static void __destroy_node(const struct cl_ref_s *ref)
+{
+    struct gnode_s *node = cl_container_of(ref, struct gnode_s, ref);
+
+    destroy_node(node, true);
+}
+
+static void init_node(struct gnode_s *n, const void *content,
+    unsigned int content_size, void (*free_data)(void *),
+    enum cl_object object)
+{
+    n->content = (void *)content;
+    n->content_size = content_size;
+    n->content_type = typeof_guess_object(content);
+    n->free_data = free_data;
+    n->inline_content = false;
+    n->ref.free = __destroy_node;
+    n->ref.count = 1;
+
+    typeof_set_with_offset(object, n, CLIST_NODE_OFFSET);
+}
+
+/*
+ * Allocates a node for a content of @content_size bytes, with room for a
+ * copy of it if the list keeps its contents inline.
+ */
+static struct gnode_s *alloc_node(glist_s *list, unsigned int content_size)
+{
+    if (list->inline_content == true)
+        return calloc(1, sizeof(struct gnode_s) + content_size);
+
+    if (list->pool != NULL)
+        return pool_get(list->pool);
+
+    return calloc(1, sizeof(struct gnode_s));
+}
+
+static void fill_node(struct gnode_s *n, const void *content,
+    unsigned int content_size, glist_s *list, enum cl_object object)
+{
+    if (list->inline_content == true) {
+        memcpy(node_payload(n), content, content_size);
+        content = node_payload(n);
+    }
+
+    init_node(n, content, content_size, list->free_data, object);
+    n->inline_content = list->inline_content;
+}
+
+/*
+ * Creates a new struct gnode_s with @content inside.
+ */
+static struct gnode_s *new_node(const void *content, unsigned int content_size,
+    glist_s *list, enum cl_object object)
+{
+    struct gnode_s *n = NULL;
+
+    n = alloc_node(list, content_size);
+
+    if (NULL == n) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    fill_node(n, content, content_size, list, object);
+
+    return n;
+}
+
+/*
+ *
+ * Ring storage.
+ *
+ */
+
+/* Translates a position inside the list into a slot of the ring */
+static unsigned int ring_slot(const struct gring *r, unsigned int index)
+{
+    index += r->head;
+
+    return (index >= r->capacity) ? index - r->capacity : index;
+}
+
+static struct gnode_s *ring_at(const struct gring *r, unsigned int index)
+{
+    return r->slots[ring_slot(r, index)];
+}
+
+static struct gring *new_ring(unsigned int capacity)
+{
+    struct gring *r = NULL;
+
+    r = calloc(1, sizeof(struct gring));
+
+    if (NULL == r) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    r->slots = calloc(capacity, sizeof(struct gnode_s *));
+
+    if (NULL == r->slots) {
+        free(r);
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    r->capacity = capacity;
+
+    return r;
+}
+
+static void destroy_ring(struct gring *r)
+{
+    unsigned int i;
+
+    for (i = 0; i < r->count; i++)
+        cl_ref_dec(&ring_at(r, i)->ref);
+
+    free(r->slots);
+    free(r);
+}
+
+/*
+ * Stores @node at the beginning of the ring, if @front is true, or at its
+ * end. The ring must not be full.
+ */
+static void ring_insert(struct gring *r, struct gnode_s *node, bool front)
+{
+    if (front == true) {
+        r->head = (r->head == 0) ? r->capacity - 1 : r->head - 1;
+        r->slots[r->head] = node;
+    } else
+        r->slots[ring_slot(r, r->count)] = node;
+
+    r->count++;
+}
+
+static struct gnode_s *ring_remove(struct gring *r, bool front)
+{
+    struct gnode_s *node = NULL;
+
+    if (r->count == 0)
+        return NULL;
+
+    if (front == true) {
+        node = r->slots[r->head];
+        r->head = ring_slot(r, 1);
+    } else
+        node = ring_at(r, r->count - 1);
+
+    r->count--;
+
+    return node;
+}
+
+/*
+ * Removes the node at @index, closing the gap with whichever side of the ring
+ * has fewer nodes to be moved.
+ */
+static struct gnode_s *ring_delete_at(struct gring *r, unsigned int index)
+{
+    struct gnode_s *node = NULL;
+    unsigned int i;
+
+    if (index >= r->count)
+        return NULL;
+
+    node = ring_at(r, index);
+
+    if (index < r->count / 2) {
+        for (i = index; i > 0; i--)
+            r->slots[ring_slot(r, i)] = ring_at(r, i - 1);
+
+        r->head = ring_slot(r, 1);
+    } else {
+        for (i = index + 1; i < r->count; i++)
+            r->slots[ring_slot(r, i - 1)] = ring_at(r, i);
+    }
+
+    r->count--;
+
+    return node;
+}
+
+/*
+ * Moves every node for which @foo returns a non-zero value into the list
+ * @extracted, keeping the order of the remaining ones. If @foo returns a
+ * negative value the search stops.
+ */
+static void ring_filter(struct gring *r, struct cdll_head *extracted,
+    int (*foo)(void *, void *), void *data)
+{
+    struct gnode_s *node = NULL;
+    unsigned int i, kept = 0;
+    bool stop = false;
+    int v;
+
+    for (i = 0; i < r->count; i++) {
+        node = ring_at(r, i);
+        v = (stop == true) ? 0 : foo(node, data);
+
+        if (v == 0) {
+            r->slots[ring_slot(r, kept++)] = node;
+            continue;
+        }
+
+        cdll_unshift(extracted, node);
+
+        if (v < 0)
+            stop = true;
+    }
+
+    r->count = kept;
+}
+
+/*
+ * Merges the sorted ranges [@lo, @mid) and [@mid, @hi) of @src into the same
+ * positions of @dst.
+ */
+static void merge_nodes(struct gnode_s **src, struct gnode_s **dst,
+    unsigned int lo, unsigned int mid, unsigned int hi,
+    int (*cmp)(void *, void *))
+{
+    unsigned int i = lo, j = mid, k = lo;
+
+    /* Already in order, which makes sorted input cost a single pass */
+    if ((mid == lo) || (mid == hi) || (cmp(src[mid - 1], src[mid]) <= 0)) {
+        memcpy(dst + lo, src + lo, (hi - lo) * sizeof(struct gnode_s *));
+        return;
+    }
+
+    while ((i < mid) && (j < hi))
+        dst[k++] = (cmp(src[i], src[j]) > 0) ? src[j++] : src[i++];
+
+    while (i < mid)
+        dst[k++] = src[i++];
+
+    while (j < hi)
+        dst[k++] = src[j++];
+}
+
+/*
+ * Bottom-up merge sort of an array of nodes, keeping equal nodes in their
+ * original order. Short runs are sorted by insertion first, so the merges
+ * start from blocks that fit in the cache. @tmp must have room for @n nodes.
+ */
+static void sort_nodes(struct gnode_s **v, struct gnode_s **tmp,
+    unsigned int n, int (*cmp)(void *, void *))
+{
+    struct gnode_s **src = v, **dst = tmp, **t, *node;
+    unsigned int width, lo, mid, hi, i, j;
+
+    for (lo = 0; lo < n; lo += GLIST_SORT_RUN) {
+        hi = (lo + GLIST_SORT_RUN < n) ? lo + GLIST_SORT_RUN : n;
+
+        for (i = lo + 1; i < hi; i++) {
+            node = v[i];
+
+            for (j = i; (j > lo) && (cmp(v[j - 1], node) > 0); j--)
+                v[j] = v[j - 1];
+
+            v[j] = node;
+        }
+    }
+
+    for (width = GLIST_SORT_RUN; width < n; width *= 2) {
+        for (lo = 0; lo < n; lo += 2 * width) {
+            mid = (lo + width < n) ? lo + width : n;
+            hi = (mid + width < n) ? mid + width : n;
+            merge_nodes(src, dst, lo, mid, hi, cmp);
+        }
+
+        t = src;
+        src = dst;
+        dst = t;
+    }
+
+    if (src != v)
+        memcpy(v, src, n * sizeof(struct gnode_s *));
+}
+
+/* A piece of a parallel sort, either sorting or merging a range */
+struct sort_job {
+    struct gnode_s      **v;
+    struct gnode_s      **tmp;
+    unsigned int        lo;
+    unsigned int        mid;
+    unsigned int        hi;
+    int                 (*cmp)(void *, void *);
+    bool                merge;
+    pthread_t           thread;
+    bool                running;
+};
+
+static void *sort_job_run(void *arg)
+{
+    struct sort_job *j = (struct sort_job *)arg;
+
+    if (j->merge == true)
+        merge_nodes(j->v, j->tmp, j->lo, j->mid, j->hi, j->cmp);
+    else
+        sort_nodes(j->v + j->lo, j->tmp + j->lo, j->hi - j->lo, j->cmp);
+
+    return NULL;
+}
+
+/*
+ * Runs @count jobs, each one in its own thread, except the first one which
+ * uses the caller thread. A job whose thread can't be created runs in the
+ * caller thread too.
+ */
+static void run_sort_jobs(struct sort_job *jobs, unsigned int count)
+{
+    unsigned int i;
+
+    for (i = 1; i < count; i++) {
+        jobs[i].running = (pthread_create(&jobs[i].thread, NULL, sort_job_run,
+                                          &jobs[i]) == 0);
+
+        if (jobs[i].running == false)
+            sort_job_run(&jobs[i]);
+    }
+
+    sort_job_run(&jobs[0]);
+
+    for (i = 1; i < count; i++)
+        if (jobs[i].running == true)
+            pthread_join(jobs[i].thread, NULL);
+}
+
+/*
+ * Splits the array in up to GLIST_SORT_MAX_THREADS parts sorted at the same
+ * time, then merges them back in pairs, also at the same time. The @cmp
+ * function must therefore be safe to be called from several threads.
+ */
+static void sort_nodes_parallel(struct gnode_s **v, struct gnode_s **tmp,
+    unsigned int n, int (*cmp)(void *, void *))
+{
+    struct sort_job jobs[GLIST_SORT_MAX_THREADS];
+    struct gnode_s **src = v, **dst = tmp, **t;
+    unsigned int parts = 1, width, i;
+    long cpus;
+
+    cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    while ((parts * 2 <= GLIST_SORT_MAX_THREADS) && (parts * 2 <= cpus) &&
+           (n / (parts * 2) >= GLIST_SORT_RUN))
+    {
+        parts *= 2;
+    }
+
+    if (parts == 1) {
+        sort_nodes(v, tmp, n, cmp);
+        return;
+    }
+
+    width = (n + parts - 1) / parts;
+
+    for (i = 0; i < parts; i++) {
+        jobs[i].v = v;
+        jobs[i].tmp = tmp;
+        jobs[i].lo = (i * width < n) ? i * width : n;
+        jobs[i].hi = ((i + 1) * width < n) ? (i + 1) * width : n;
+        jobs[i].cmp = cmp;
+        jobs[i].merge = false;
+    }
+
+    run_sort_jobs(jobs, parts);
+
+    for (; parts > 1; parts /= 2, width *= 2) {
+        for (i = 0; i < parts / 2; i++) {
+            jobs[i].v = src;
+            jobs[i].tmp = dst;
+            jobs[i].lo = (2 * i * width < n) ? 2 * i * width : n;
+            jobs[i].mid = ((2 * i + 1) * width < n) ? (2 * i + 1) * width : n;
+            jobs[i].hi = ((2 * i + 2) * width < n) ? (2 * i + 2) * width : n;
+            jobs[i].cmp = cmp;
+            jobs[i].merge = true;
+        }
+
+        run_sort_jobs(jobs, parts / 2);
+        t = src;
+        src = dst;
+        dst = t;
+    }
+
+    if (src != v)
+        memcpy(v, src, n * sizeof(struct gnode_s *));
+}
+
+/*
+ * Sorts the ring, laying its nodes out from the first slot on.
+ */
+static int ring_sort(struct gring *r, int (*cmp)(void *, void *))
+{
+    struct gnode_s **v = NULL;
+    unsigned int i;
+
+    if (r->count < 2)
+        return 0;
+
+    v = malloc(2 * r->count * sizeof(struct gnode_s *));
+
+    if (NULL == v) {
+        cset_errno(CL_NO_MEM);
+        return -1;
+    }
+
+    for (i = 0; i < r->count; i++)
+        v[i] = ring_at(r, i);
+
+    sort_nodes(v, v + r->count, r->count, cmp);
+    memcpy(r->slots, v, r->count * sizeof(struct gnode_s *));
+    r->head = 0;
+    free(v);
+
+    return 0;
+}
+
+/*
+ * Sorts the linked list through an array of its nodes, relinking them in the
+ * new order afterwards.
+ */
+static void list_sort(glist_s *l, int (*cmp)(void *, void *))
+{
+    struct gnode_s **v = NULL, *node;
+    unsigned int i, n = l->list.count;
+
+    if (n < 2)
+        return;
+
+    v = malloc(2 * (size_t)n * sizeof(struct gnode_s *));
+
+    /* Without room for the array the list is sorted in place */
+    if (NULL == v) {
+        cdll_sort(&l->list, cmp);
+        return;
+    }
+
+    for (i = 0, node = l->list.first; i < n; i++, node = node->next)
+        v[i] = node;
+
+    if ((l->sort_threshold != 0) && (n >= l->sort_threshold))
+        sort_nodes_parallel(v, v + n, n, cmp);
+    else
+        sort_nodes(v, v + n, n, cmp);
+
+    for (i = 0; i < n; i++) {
+        v[i]->prev = (i > 0) ? v[i - 1] : NULL;
+        v[i]->next = (i + 1 < n) ? v[i + 1] : NULL;
+    }
+
+    l->list.first = v[0];
+    l->list.last = v[n - 1];
+    l->list.cursor = NULL;
+    free(v);
+}
+
+/*
+ * Moves the last @n nodes of the ring to its beginning.
+ */
+static void ring_rotate(struct gring *r, unsigned int n)
+{
+    if (r->count < 2)
+        return;
+
+    n %= r->count;
+
+    /* A full ring only needs to move its head */
+    if (r->count == r->capacity) {
+        r->head = ring_slot(r, r->count - n);
+        return;
+    }
+
+    while (n-- > 0)
+        ring_insert(r, ring_remove(r, false), true);
+}
+
+/*
+ *
+ * Snapshots.
+ *
+ */
+
+/*
+ * Takes a new reference to every node of the list, in order. User functions
+ * are called over them after the list is unlocked, so they may use it again,
+ * even to change it, and the nodes removed meanwhile stay valid until
+ * release_nodes. Must be called with the list locked.
+ */
+static struct gnode_s **grab_nodes(glist_s *l, unsigned int *count)
+{
+    struct gnode_s **nodes = NULL, *node;
+    unsigned int i, n;
+
+    n = (l->ring != NULL) ? l->ring->count : cdll_size(&l->list);
+    *count = 0;
+
+    if (n == 0)
+        return NULL;
+
+    nodes = malloc(n * sizeof(struct gnode_s *));
+
+    if (NULL == nodes) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    node = (struct gnode_s *)l->list.first;
+
+    for (i = 0; i < n; i++) {
+        if (l->ring != NULL)
+            nodes[i] = ring_at(l->ring, i);
+        else {
+            nodes[i] = node;
+            node = (struct gnode_s *)node->next;
+        }
+
+        cl_ref_inc(&nodes[i]->ref);
+    }
+
+    *count = n;
+
+    return nodes;
+}
+
+static void release_nodes(struct gnode_s **nodes, unsigned int count)
+{
+    unsigned int i;
 
-cl_struct_declare(glist_s, clist_members);
+    for (i = 0; i < count; i++)
+        cl_ref_dec(&nodes[i]->ref);
 
-#define glist_s     cl_struct(glist_s)
+    free(nodes);
+}
+
+/* Position of the @i-th visited node among @count of them */
+static unsigned int visit_order(unsigned int i, unsigned int count,
+    bool reverse)
+{
+    return (reverse == true) ? count - 1 - i : i;
+}
 
 /*
- * Duplicate internal glist_s members to another one.
+ * Calls @foo over the nodes until it returns non-zero, giving back a new
+ * reference to the node where it stopped.
  */
-static void dup_internal_data(glist_s *orig, glist_s *dest)
+static struct gnode_s *map_nodes(glist_s *l, enum cl_object node_object,
+    int (*foo)(void *, void *), void *data, bool reverse)
 {
-    if ((NULL == orig) || (NULL == dest))
-        return;
+    struct gnode_s **nodes, *node = NULL;
+    unsigned int i, count;
 
-    dest->size = orig->size;
-    dest->free_data = orig->free_data;
-    dest->filter = orig->filter;
-    dest->compare_to = orig->compare_to;
-    dest->equals = orig->equals;
-}
+    pthread_rwlock_rdlock(&l->lock);
+    nodes = grab_nodes(l, &count);
+    pthread_rwlock_unlock(&l->lock);
 
-static bool is_cl_object(struct gnode_s *node)
-{
-    if (NULL == node)
-        return false;
+    for (i = 0; (i < count) && (NULL == node); i++)
+        if (foo(nodes[visit_order(i, count, reverse)], data))
+            node = nodes[visit_order(i, count, reverse)];
 
-    /*
-     * If we're holding information smaller than a cl_object_hdr structure we
-     * don't even need to validate it.
-     */
-    if (node->content_size < CL_OBJECT_HEADER_ID_SIZE)
-        return false;
+    if (node != NULL)
+        cglist_node_ref(node, node_object);
 
-    return typeof_validate_object(node->content, CL_OBJ_OBJECT);
+    release_nodes(nodes, count);
+
+    return node;
 }
 
 /*
- * Checks if we're holding cobjects inside the list. Returns true if does.
+ * Like map_nodes, but @foo also receives an index, which only advances when
+ * it returns 0. A negative return stops the walk.
  */
-static bool is_list_of_cobjects(glist_s *list)
+static struct gnode_s *map_nodes_indexed(glist_s *l,
+    enum cl_object node_object, int (*foo)(unsigned int, void *, void *),
+    void *data, bool reverse)
 {
-    struct gnode_s *node = NULL;
+    struct gnode_s **nodes, *node = NULL;
+    unsigned int i, idx = 0, count;
+    int ret;
 
-    node = cl_dll_at(list->list, 0);
+    pthread_rwlock_rdlock(&l->lock);
+    nodes = grab_nodes(l, &count);
+    pthread_rwlock_unlock(&l->lock);
 
-    return is_cl_object(node);
+    for (i = 0; (i < count) && (NULL == node); i++) {
+        ret = foo(idx, nodes[visit_order(i, count, reverse)], data);
+
+        if (ret < 0)
+            node = nodes[visit_order(i, count, reverse)];
+        else if (ret == 0)
+            idx++;
+    }
+
+    if (node != NULL)
+        cglist_node_ref(node, node_object);
+
+    release_nodes(nodes, count);
+
+    return node;
 }
 
 /*
- * If we have a list of cobjects, this function uses its compare_to function
- * to compare two cobjects.
+ *
+ * Membership filter.
+ *
  */
-static int compare_cobjects(void *a, void *b)
-{
-    struct gnode_s *node_a = (struct gnode_s *)a;
-    struct gnode_s *node_b = (struct gnode_s *)b;
-    cl_object_t *ob1 = (cl_object_t *)node_a->content;
-    cl_object_t *ob2 = (cl_object_t *)node_b->content;
 
-    return cl_object_compare_to(ob1, ob2);
+/*
+ * The filter is only enabled along with a user hash, since the comparison
+ * used by lookups is always a custom one and nothing else knows which
+ * contents it takes as equal.
+ */
+static unsigned long long node_hash(const glist_s *l, struct gnode_s *node)
+{
+    return (l->hash)(node);
 }
 
 /*
- * If we have a list of cobjects, this functions uses its equals function to
- * compare two cobjects.
+ * Builds a new filter holding every node of the list, with room for as many
+ * more. On failure the list is left without a filter, which only makes its
+ * lookups slower.
  */
-static int cobjects_are_equal(void *a, void *b)
+static void bloom_rebuild(glist_s *l)
 {
-    struct gnode_s *node_a = (struct gnode_s *)a;
-    struct gnode_s *node_b = (struct gnode_s *)b;
-    cl_object_t *ob1 = (cl_object_t *)node_a->content;
-    cl_object_t *ob2 = (cl_object_t *)node_b->content;
+    struct gnode_s *node = NULL;
+    unsigned int i, count;
 
-    return cl_object_equals(ob1, ob2);
+    count = (l->ring != NULL) ? l->ring->count : cdll_size(&l->list);
+    cbloom_destroy(l->bloom);
+    l->bloom = cbloom_create((count < 64) ? 128 : count * 2);
+
+    if (NULL == l->bloom)
+        return;
+
+    if (l->ring != NULL) {
+        for (i = 0; i < l->ring->count; i++)
+            cbloom_add(l->bloom, node_hash(l, ring_at(l->ring, i)));
+
+        return;
+    }
+
+    for (node = (struct gnode_s *)l->list.first; node != NULL;
+         node = (struct gnode_s *)node->next)
+    {
+        cbloom_add(l->bloom, node_hash(l, node));
+    }
+}
+
+/* Grows the filter once it holds more nodes than it was sized for */
+static void bloom_fit(glist_s *l)
+{
+    if ((l->bloom != NULL) && (cbloom_is_full(l->bloom) == true))
+        bloom_rebuild(l);
+}
+
+static void bloom_add_node(glist_s *l, struct gnode_s *node)
+{
+    if (l->bloom != NULL)
+        cbloom_add(l->bloom, node_hash(l, node));
+}
+
+static void bloom_insert(glist_s *l, struct gnode_s *node)
+{
+    bloom_add_node(l, node);
+    bloom_fit(l);
+}
+
+static void bloom_forget(glist_s *l, struct gnode_s *node)
+{
+    if (l->bloom != NULL)
+        cbloom_remove(l->bloom, node_hash(l, node));
+}
+
+/* Tells if the filter proves that no node of the list is equal to @node */
+static bool bloom_rules_out(const glist_s *l, struct gnode_s *node)
+{
+    if (NULL == l->bloom)
+        return false;
+
+    return !cbloom_may_contain(l->bloom, node_hash(l, node));
 }
 
 /*
- * Releases a struct gnode_s from memory. Its content will also be released
- * if @free_content is true. In this case the function checks which _free_
- * function will be used according the type of a node content.
+ * Stores a new content at one end of a ring list. When the ring is full the
+ * node at its other end is dropped and, if nobody else is holding it, reused
+ * for the new content, so a full ring keeps working without allocating.
+ *
+ * The list lock must be held by the caller.
  */
-static void destroy_node(struct gnode_s *node, bool free_content)
+static int ring_store(glist_s *l, const void *content, unsigned int size,
+    enum cl_object node_object, bool front)
 {
-    if (NULL == node)
-        return;
+    struct gring *r = l->ring;
+    struct gnode_s *node = NULL;
 
-    if (free_content == true) {
-        if (node->free_data != NULL)
-            (node->free_data)(node->content);
-        else {
-            /*
-             * If we're holding information smaller than a cl_object_hdr structure
-             * we don't even need to validate it and call free on it.
-             */
-            if (node->content_size < CL_OBJECT_HEADER_ID_SIZE)
-                free(node->content);
-            else {
-                /*
-                 * If we're holding cl_object_t pointers we know how to destroy
-                 * them.
-                 */
-                if (typeof_validate_object(node->content, CL_OBJ_OBJECT) == true)
-                    cl_object_destroy(node->content);
-            }
+    if (r->count == r->capacity) {
+        node = ring_remove(r, !front);
+        bloom_forget(l, node);
+
+        if (node->ref.count == 1) {
+            release_node_content(node);
+            node->content = (void *)content;
+            node->content_size = size;
+            node->content_type = typeof_guess_object(content);
+            node->inline_content = false;
+        } else {
+            cl_ref_dec(&node->ref);
+            node = NULL;
         }
     }
 
-    free(node);
-    node = NULL;
+    if (NULL == node)
+        node = new_node(content, size, l, node_object);
+
+    if (NULL == node)
+        return -1;
+
+    ring_insert(r, node, front);
+    bloom_insert(l, node);
+
+    return 0;
 }
 
-/*
- * The function to release a node called when a reference count from them drops
- * to 0.
- */
-static void __destroy_node(const struct cl_ref_s *ref)
+static int ring_push(glist_s *l, const void *content, unsigned int size,
+    enum cl_object node_object, bool front)
 {
-    struct gnode_s *node = cl_container_of(ref, struct gnode_s, ref);
+    int ret;
 
-    destroy_node(node, true);
+    pthread_rwlock_wrlock(&l->lock);
+    ret = ring_store(l, content, size, node_object, front);
+    pthread_rwlock_unlock(&l->lock);
+
+    return ret;
 }
 
 /*
- * Creates a new struct gnode_s with @content inside.
+ * Creates a node for each one of @count contents, linked inside @chain in
+ * the same order that pushing them one at a time at the beginning of a list,
+ * or at its far end if @front is false, would leave them. No list lock is
+ * needed since the chain belongs to nobody yet.
  */
-static struct gnode_s *new_node(const void *content, unsigned int content_size,
-    glist_s *list, enum cl_object object)
+static int new_chain(glist_s *l, void **contents, unsigned int size,
+    unsigned int count, enum cl_object node_object, bool front,
+    struct cdll_head *chain)
 {
-    struct gnode_s *n = NULL;
+    struct gnode_s **nodes = NULL;
+    unsigned int i, n = 0;
 
-    n = calloc(1, sizeof(struct gnode_s));
+    nodes = calloc(count, sizeof(struct gnode_s *));
 
-    if (NULL == n) {
+    if (NULL == nodes) {
         cset_errno(CL_NO_MEM);
-        return NULL;
+        return -1;
     }
 
-    n->content = (void *)content;
-    n->content_size = content_size;
-    n->content_type = typeof_guess_object(content);
-    n->free_data = list->free_data;
-    n->ref.free = __destroy_node;
-    n->ref.count = 1;
+    if (l->pool != NULL)
+        n = pool_get_many(l->pool, nodes, count);
+    else
+        for (n = 0; n < count; n++) {
+            nodes[n] = alloc_node(l, size);
 
-    typeof_set_with_offset(object, n, CLIST_NODE_OFFSET);
+            if (NULL == nodes[n])
+                break;
+        }
 
-    return n;
+    if (n < count) {
+        for (i = 0; i < n; i++)
+            destroy_node(nodes[i], false);
+
+        free(nodes);
+        cset_errno(CL_NO_MEM);
+
+        return -1;
+    }
+
+    cdll_init(chain);
+
+    for (i = 0; i < count; i++) {
+        fill_node(nodes[i], contents[i], size, l, node_object);
+
+        if (front == true)
+            cdll_push(chain, nodes[i]);
+        else
+            cdll_unshift(chain, nodes[i]);
+    }
+
+    free(nodes);
+
+    return 0;
 }
 
 /*
@@ -224,10 +1225,18 @@ static void destroy_list(const struct cl_ref_s *ref)
     else if (typeof_validate_object(list, CL_OBJ_QUEUE))
         node_object = CL_OBJ_QUEUE_NODE;
 
-    while ((p = cl_dll_pop(&list->list)) != NULL)
+    while ((p = cdll_pop(&list->list)) != NULL)
         cglist_node_unref(p, node_object);
 
-    pthread_mutex_destroy(&list->lock);
+    if (list->ring != NULL)
+        destroy_ring(list->ring);
+
+    if (list->pool != NULL)
+        pool_unref(list->pool);
+
+    cbloom_destroy(list->bloom);
+
+    pthread_rwlock_destroy(&list->lock);
     free(list);
     list = NULL;
 }
@@ -238,6 +1247,7 @@ static void destroy_list(const struct cl_ref_s *ref)
 static glist_s *new_clist(enum cl_object object)
 {
     glist_s *l = NULL;
+    pthread_rwlockattr_t attr;
 
     l = calloc(1, sizeof(glist_s));
 
@@ -246,8 +1256,17 @@ static glist_s *new_clist(enum cl_object object)
         return NULL;
     }
 
-    l->size = 0;
-    pthread_mutex_init(&l->lock, NULL);
+    /*
+     * Writers are preferred, so a steady stream of readers can't starve
+     * them. The price is that a thread must not take the read lock twice.
+     */
+    pthread_rwlockattr_init(&attr);
+    pthread_rwlockattr_setkind_np(&attr,
+                                  PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+
+    cdll_init(&l->list);
+    pthread_rwlock_init(&l->lock, &attr);
+    pthread_rwlockattr_destroy(&attr);
     typeof_set(object, l);
 
     l->ref.free = destroy_list;
@@ -276,6 +1295,51 @@ int cglist_node_unref(void *node, enum cl_object object)
     return 0;
 }
 
+/*
+ * Creates a node that does not belong to any list, so containers keeping
+ * their elements some other way can still hand them out as list nodes.
+ */
+void *cglist_node_create(const void *content, unsigned int size,
+    void (*free_data)(void *), enum cl_object node_object)
+{
+    struct gnode_s *n = NULL;
+
+    n = calloc(1, sizeof(struct gnode_s));
+
+    if (NULL == n) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    init_node(n, content, size, free_data, node_object);
+
+    return n;
+}
+
+/*
+ * Releases a node created by cglist_node_create that was never handed out,
+ * leaving its content to the caller.
+ */
+void cglist_node_discard(void *node)
+{
+    destroy_node((struct gnode_s *)node, false);
+}
+
+bool cglist_node_holds_cobject(const void *node)
+{
+    return is_cl_object((struct gnode_s *)node);
+}
+
+int cglist_compare_cobjects(void *a, void *b)
+{
+    return compare_cobjects(a, b);
+}
+
+int cglist_cobjects_are_equal(void *a, void *b)
+{
+    return cobjects_are_equal(a, b);
+}
+
 void *cglist_ref(void *list, enum cl_object object)
 {
     glist_s *l = (glist_s *)list;
@@ -298,16 +1362,35 @@ int cglist_unref(void *list, enum cl_object object)
 
 void *cglist_create(enum cl_object object, void (*free_data)(void *),
     int (*compare_to)(void *, void *), int (*filter)(void *, void *),
-    int (*equals)(void *, void *))
+    int (*equals)(void *, void *), unsigned int flags)
 {
     glist_s *l = NULL;
 
     __clib_function_init__(false, NULL, -1, NULL);
+
+    /* Pooled nodes have no room for the contents */
+    if ((flags & CL_LIST_NODE_POOL) && (flags & CL_LIST_INLINE_CONTENT)) {
+        cset_errno(CL_INVALID_VALUE);
+        return NULL;
+    }
+
     l = new_clist(object);
 
     if (NULL == l)
         return NULL;
 
+    l->inline_content = (flags & CL_LIST_INLINE_CONTENT) ? true : false;
+
+    if (flags & CL_LIST_NODE_POOL) {
+        l->pool = new_pool();
+
+        if (NULL == l->pool) {
+            cglist_unref(l, object);
+            cset_errno(CL_NO_MEM);
+            return NULL;
+        }
+    }
+
     if (free_data != NULL)
         l->free_data = free_data;
 
@@ -331,10 +1414,14 @@ int cglist_destroy(void *list, enum cl_object object)
 int cglist_size(const void *list, enum cl_object object)
 {
     glist_s *l = (glist_s *)list;
+    int size;
 
     __clib_function_init__(true, list, object, -1);
+    pthread_rwlock_rdlock(&l->lock);
+    size = (l->ring != NULL) ? l->ring->count : cdll_size(&l->list);
+    pthread_rwlock_unlock(&l->lock);
 
-    return l->size;
+    return size;
 }
 
 int cglist_push(void *list, enum cl_object object,
@@ -344,15 +1431,19 @@ int cglist_push(void *list, enum cl_object object,
     struct gnode_s *node = NULL;
 
     __clib_function_init__(true, list, object, -1);
+
+    if (l->ring != NULL)
+        return ring_push(l, node_content, size, node_object, true);
+
     node = new_node(node_content, size, l, node_object);
 
     if (NULL == node)
         return -1;
 
-    pthread_mutex_lock(&l->lock);
-    l->list = cl_dll_push(l->list, node);
-    l->size++;
-    pthread_mutex_unlock(&l->lock);
+    pthread_rwlock_wrlock(&l->lock);
+    cdll_push(&l->list, node);
+    bloom_insert(l, node);
+    pthread_rwlock_unlock(&l->lock);
 
     return 0;
 }
@@ -364,13 +1455,14 @@ void *cglist_pop(void *list, enum cl_object object)
 
     __clib_function_init__(true, list, object, NULL);
 
-    pthread_mutex_lock(&l->lock);
-    node = cl_dll_pop(&l->list);
+    pthread_rwlock_wrlock(&l->lock);
+    node = (l->ring != NULL) ? ring_remove(l->ring, true)
+                             : cdll_pop(&l->list);
 
-    if (node)
-        l->size--;
+    if (node != NULL)
+        bloom_forget(l, node);
 
-    pthread_mutex_unlock(&l->lock);
+    pthread_rwlock_unlock(&l->lock);
 
     if (NULL == node)
         return NULL;
@@ -385,36 +1477,179 @@ void *cglist_shift(void *list, enum cl_object object)
 
     __clib_function_init__(true, list, object, NULL);
 
-    pthread_mutex_lock(&l->lock);
-    node = cl_dll_shift(&l->list);
+    pthread_rwlock_wrlock(&l->lock);
+    node = (l->ring != NULL) ? ring_remove(l->ring, false)
+                             : cdll_shift(&l->list);
+
+    if (node != NULL)
+        bloom_forget(l, node);
+
+    pthread_rwlock_unlock(&l->lock);
+
+    if (NULL == node)
+        return NULL;
+
+    return node;
+}
+
+int cglist_unshift(void *list, enum cl_object object,
+    const void *node_content, unsigned int size, enum cl_object node_object)
+{
+    glist_s *l = (glist_s *)list;
+    struct gnode_s *node = NULL;
+
+    __clib_function_init__(true, list, object, -1);
+
+    if (l->ring != NULL)
+        return ring_push(l, node_content, size, node_object, false);
+
+    node = new_node(node_content, size, l, node_object);
+
+    if (NULL == node)
+        return -1;
+
+    pthread_rwlock_wrlock(&l->lock);
+    cdll_unshift(&l->list, node);
+    bloom_insert(l, node);
+    pthread_rwlock_unlock(&l->lock);
+
+    return 0;
+}
+
+/*
+ * Stores @count contents at the beginning of the list, if @front is true, or
+ * at its far end, as if they were inserted one at a time, but validating the
+ * list and taking its lock only once.
+ */
+int cglist_push_many(void *list, enum cl_object object, void **contents,
+    unsigned int size, unsigned int count, enum cl_object node_object,
+    bool front)
+{
+    glist_s *l = (glist_s *)list;
+    struct gnode_s *node = NULL;
+    struct cdll_head chain;
+    unsigned int i;
+    int ret = 0;
+
+    __clib_function_init__(true, list, object, -1);
+
+    if (NULL == contents) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    if (count == 0)
+        return 0;
+
+    if (l->ring != NULL) {
+        pthread_rwlock_wrlock(&l->lock);
+
+        for (i = 0; (i < count) && (ret == 0); i++)
+            ret = ring_store(l, contents[i], size, node_object, front);
+
+        pthread_rwlock_unlock(&l->lock);
+
+        return ret;
+    }
+
+    if (new_chain(l, contents, size, count, node_object, front, &chain) < 0)
+        return -1;
+
+    pthread_rwlock_wrlock(&l->lock);
+
+    for (node = (struct gnode_s *)chain.first; node != NULL;
+         node = (struct gnode_s *)node->next)
+    {
+        bloom_add_node(l, node);
+    }
+
+    cdll_splice(&l->list, &chain, front);
+    bloom_fit(l);
+    pthread_rwlock_unlock(&l->lock);
+
+    return 0;
+}
+
+/*
+ * Removes up to @count nodes from the beginning of the list, under a single
+ * lock, storing them inside @nodes. Returns how many were removed.
+ */
+int cglist_pop_many(void *list, enum cl_object object, void **nodes,
+    unsigned int count)
+{
+    glist_s *l = (glist_s *)list;
+    unsigned int n;
+
+    __clib_function_init__(true, list, object, -1);
+
+    if (NULL == nodes) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    pthread_rwlock_wrlock(&l->lock);
+
+    for (n = 0; n < count; n++) {
+        nodes[n] = (l->ring != NULL) ? ring_remove(l->ring, true)
+                                     : cdll_pop(&l->list);
 
-    if (node)
-        l->size--;
+        if (NULL == nodes[n])
+            break;
 
-    pthread_mutex_unlock(&l->lock);
+        bloom_forget(l, nodes[n]);
+    }
 
-    if (NULL == node)
-        return NULL;
+    pthread_rwlock_unlock(&l->lock);
 
-    return node;
+    return n;
 }
 
-int cglist_unshift(void *list, enum cl_object object,
-    const void *node_content, unsigned int size, enum cl_object node_object)
+/*
+ * Moves all nodes of @other to the far end of @list in constant time. Both
+ * locks are taken in address order, so two threads splicing the same lists
+ * in opposite directions can't deadlock.
+ */
+int cglist_splice(void *list, enum cl_object object, void *other)
 {
-    glist_s *l = (glist_s *)list;
+    glist_s *l = (glist_s *)list, *o = (glist_s *)other;
+    glist_s *first, *second;
     struct gnode_s *node = NULL;
 
     __clib_function_init__(true, list, object, -1);
-    node = new_node(node_content, size, l, node_object);
 
-    if (NULL == node)
+    if (typeof_validate_object(other, object) == false) {
+        cset_errno(CL_INVALID_VALUE);
+        return -1;
+    }
+
+    if (l == o) {
+        cset_errno(CL_INVALID_VALUE);
+        return -1;
+    }
+
+    if ((l->ring != NULL) || (o->ring != NULL)) {
+        cset_errno(CL_UNSUPPORTED_TYPE);
         return -1;
+    }
+
+    first = (l < o) ? l : o;
+    second = (l < o) ? o : l;
+    pthread_rwlock_wrlock(&first->lock);
+    pthread_rwlock_wrlock(&second->lock);
 
-    pthread_mutex_lock(&l->lock);
-    l->list = cl_dll_unshift(l->list, node);
-    l->size++;
-    pthread_mutex_unlock(&l->lock);
+    for (node = (struct gnode_s *)o->list.first; node != NULL;
+         node = (struct gnode_s *)node->next)
+    {
+        bloom_add_node(l, node);
+    }
+
+    if (o->bloom != NULL)
+        cbloom_clear(o->bloom);
+
+    cdll_splice(&l->list, &o->list, false);
+    bloom_fit(l);
+    pthread_rwlock_unlock(&second->lock);
+    pthread_rwlock_unlock(&first->lock);
 
     return 0;
 }
@@ -423,7 +1658,6 @@ void *cglist_map(const void *list, enum cl_object object,
     enum cl_object node_object, int (*foo)(void *, void *), void *data)
 {
     glist_s *l = (glist_s *)list;
-    struct gnode_s *node = NULL;
 
     __clib_function_init__(true, list, object, NULL);
 
@@ -432,12 +1666,7 @@ void *cglist_map(const void *list, enum cl_object object,
         return NULL;
     }
 
-    node = cl_dll_map(l->list, foo, data);
-
-    if (NULL == node)
-        return NULL;
-
-    return cglist_node_ref(node, node_object);
+    return map_nodes(l, node_object, foo, data, false);
 }
 
 void *cglist_map_indexed(const void *list, enum cl_object object,
@@ -445,7 +1674,6 @@ void *cglist_map_indexed(const void *list, enum cl_object object,
     void *data)
 {
     glist_s *l = (glist_s *)list;
-    struct gnode_s *node = NULL;
 
     __clib_function_init__(true, list, object, NULL);
 
@@ -454,19 +1682,13 @@ void *cglist_map_indexed(const void *list, enum cl_object object,
         return NULL;
     }
 
-    node = cl_dll_map_indexed(l->list, foo, data);
-
-    if (NULL == node)
-        return NULL;
-
-    return cglist_node_ref(node, node_object);
+    return map_nodes_indexed(l, node_object, foo, data, false);
 }
 
 void *cglist_map_reverse(const void *list, enum cl_object object,
     enum cl_object node_object, int (*foo)(void *, void *), void *data)
 {
     glist_s *l = (glist_s *)list;
-    struct gnode_s *node = NULL;
 
     __clib_function_init__(true, list, object, NULL);
 
@@ -475,12 +1697,7 @@ void *cglist_map_reverse(const void *list, enum cl_object object,
         return NULL;
     }
 
-    node = cl_dll_map_reverse(l->list, foo, data);
-
-    if (NULL == node)
-        return NULL;
-
-    return cglist_node_ref(node, node_object);
+    return map_nodes(l, node_object, foo, data, true);
 }
 
 void *cglist_map_reverse_indexed(const void *list,
@@ -488,7 +1705,6 @@ void *cglist_map_reverse_indexed(const void *list,
     int (*foo)(unsigned int, void *, void *), void *data)
 {
     glist_s *l = (glist_s *)list;
-    struct gnode_s *node = NULL;
 
     __clib_function_init__(true, list, object, NULL);
 
@@ -497,12 +1713,7 @@ void *cglist_map_reverse_indexed(const void *list,
         return NULL;
     }
 
-    node = cl_dll_map_indexed_reverse(l->list, foo, data);
-
-    if (NULL == node)
-        return NULL;
-
-    return cglist_node_ref(node, node_object);
+    return map_nodes_indexed(l, node_object, foo, data, true);
 }
 
 void *cglist_at(const void *list, enum cl_object object,
@@ -512,14 +1723,19 @@ void *cglist_at(const void *list, enum cl_object object,
     struct gnode_s *node = NULL;
 
     __clib_function_init__(true, list, object, NULL);
-    pthread_mutex_lock(&l->lock);
-    node = cl_dll_at(l->list, index);
-    pthread_mutex_unlock(&l->lock);
+    pthread_rwlock_rdlock(&l->lock);
 
-    if (NULL == node)
-        return NULL;
+    if (l->ring != NULL)
+        node = (index < l->ring->count) ? ring_at(l->ring, index) : NULL;
+    else
+        node = cdll_at(&l->list, index);
+
+    if (node != NULL)
+        cglist_node_ref(node, node_object);
 
-    return cglist_node_ref(node, node_object);
+    pthread_rwlock_unlock(&l->lock);
+
+    return node;
 }
 
 /* TODO: Maybe return the number of deleted elements */
@@ -527,6 +1743,7 @@ int cglist_delete(void *list, enum cl_object object, void *data)
 {
     glist_s *l = (glist_s *)list;
     struct gnode_s *node = NULL;
+    struct cdll_head extracted;
 
     __clib_function_init__(true, list, object, -1);
 
@@ -535,19 +1752,24 @@ int cglist_delete(void *list, enum cl_object object, void *data)
         return -1;
     }
 
-    pthread_mutex_lock(&l->lock);
-    node = cl_dll_delete(&l->list, l->filter, data, NULL);
+    cdll_init(&extracted);
+    pthread_rwlock_wrlock(&l->lock);
 
-    if (node) {
-        /*
-         * Since the node is removed from the list we need to really remove it
-         * from the memory.
-         */
-        destroy_node(node, true);
-        l->size--;
+    if (l->ring != NULL)
+        ring_filter(l->ring, &extracted, l->filter, data);
+    else
+        cdll_filter(&l->list, &extracted, l->filter, data);
+
+    /*
+     * Since the nodes are removed from the list we drop its reference to
+     * them. They are only really released when no reader holds them anymore.
+     */
+    while ((node = cdll_pop(&extracted)) != NULL) {
+        bloom_forget(l, node);
+        cl_ref_dec(&node->ref);
     }
 
-    pthread_mutex_unlock(&l->lock);
+    pthread_rwlock_unlock(&l->lock);
 
     return 0;
 }
@@ -560,19 +1782,20 @@ int cglist_delete_indexed(void *list, enum cl_object object,
 
     __clib_function_init__(true, list, object, -1);
 
-    pthread_mutex_lock(&l->lock);
-    node = cl_dll_delete_indexed(&l->list, index, NULL);
+    pthread_rwlock_wrlock(&l->lock);
+    node = (l->ring != NULL) ? ring_delete_at(l->ring, index)
+                             : cdll_delete_indexed(&l->list, index);
 
+    /*
+     * Since the node is removed from the list we drop its reference to it.
+     * It is only really released when no reader holds it anymore.
+     */
     if (node) {
-        /*
-         * Since the node is removed from the list we need to really remove it
-         * from the memory.
-         */
-        destroy_node(node, true);
-        l->size--;
+        bloom_forget(l, node);
+        cl_ref_dec(&node->ref);
     }
 
-    pthread_mutex_unlock(&l->lock);
+    pthread_rwlock_unlock(&l->lock);
 
     return 0;
 }
@@ -580,6 +1803,7 @@ int cglist_delete_indexed(void *list, enum cl_object object,
 void *cglist_move(void *list, enum cl_object object)
 {
     glist_s *l = (glist_s *)list, *n = NULL;
+    struct gring *r = NULL;
 
     __clib_function_init__(true, list, object, NULL);
     n = new_clist(object);
@@ -587,16 +1811,34 @@ void *cglist_move(void *list, enum cl_object object)
     if (NULL == n)
         return NULL;
 
-    pthread_mutex_lock(&l->lock);
+    /* The original list keeps a ring, now empty, with the same capacity */
+    if (l->ring != NULL) {
+        n->ring = new_ring(l->ring->capacity);
+
+        if (NULL == n->ring) {
+            cglist_unref(n, object);
+            cset_errno(CL_NO_MEM);
+            return NULL;
+        }
+    }
+
+    pthread_rwlock_wrlock(&l->lock);
     dup_internal_data(l, n);
-    n->list = cl_dll_move(l->list);
 
-    /*
-     * Since we just move all nodes to another list, we mark its size as
-     * zero.
-     */
-    l->size = 0;
-    pthread_mutex_unlock(&l->lock);
+    if (l->ring != NULL) {
+        r = n->ring;
+        n->ring = l->ring;
+        l->ring = r;
+    } else
+        cdll_move(&l->list, &n->list);
+
+    /* The filter goes along with the nodes, the emptied list gets a new one */
+    if (l->bloom != NULL) {
+        n->bloom = l->bloom;
+        l->bloom = cbloom_create(0);
+    }
+
+    pthread_rwlock_unlock(&l->lock);
 
     return n;
 }
@@ -604,6 +1846,8 @@ void *cglist_move(void *list, enum cl_object object)
 void *cglist_filter(void *list, enum cl_object object, void *data)
 {
     glist_s *l = (glist_s *)list, *n = NULL;
+    struct gnode_s *node = NULL;
+    struct cdll_head extracted;
 
     __clib_function_init__(true, list, object, NULL);
 
@@ -617,12 +1861,41 @@ void *cglist_filter(void *list, enum cl_object object, void *data)
     if (NULL == n)
         return NULL;
 
-    pthread_mutex_lock(&l->lock);
+    if (l->ring != NULL) {
+        n->ring = new_ring(l->ring->capacity);
+
+        if (NULL == n->ring) {
+            cglist_unref(n, object);
+            cset_errno(CL_NO_MEM);
+            return NULL;
+        }
+    }
+
+    pthread_rwlock_wrlock(&l->lock);
     dup_internal_data(l, n);
-    n->list = cl_dll_filter(&l->list, l->filter, data);
-    n->size = cl_dll_size(n->list);
-    l->size -= n->size;
-    pthread_mutex_unlock(&l->lock);
+
+    if (l->ring != NULL) {
+        cdll_init(&extracted);
+        ring_filter(l->ring, &extracted, l->filter, data);
+
+        while ((node = cdll_pop(&extracted)) != NULL) {
+            bloom_forget(l, node);
+            ring_insert(n->ring, node, false);
+        }
+    } else {
+        cdll_filter(&l->list, &n->list, l->filter, data);
+
+        for (node = (struct gnode_s *)n->list.first; node != NULL;
+             node = (struct gnode_s *)node->next)
+        {
+            bloom_forget(l, node);
+        }
+    }
+
+    if (l->bloom != NULL)
+        bloom_rebuild(n);
+
+    pthread_rwlock_unlock(&l->lock);
 
     return n;
 }
@@ -645,59 +1918,85 @@ void *cglist_node_content(const void *node, enum cl_object object)
 int cglist_sort(void *list, enum cl_object object)
 {
     glist_s *l = (glist_s *)list;
-    bool list_of_cobjects;
+    int (*cmp)(void *, void *);
+    int ret = 0;
 
     __clib_function_init__(true, list, object, -1);
-    list_of_cobjects = is_list_of_cobjects(l);
+    pthread_rwlock_wrlock(&l->lock);
+    cmp = (is_list_of_cobjects(l) == true) ? compare_cobjects : l->compare_to;
 
-    if ((list_of_cobjects == false) && (NULL == l->compare_to)) {
+    if (NULL == cmp) {
+        pthread_rwlock_unlock(&l->lock);
         cset_errno(CL_NULL_DATA);
         return -1;
     }
 
-    pthread_mutex_lock(&l->lock);
-    l->list = cl_dll_mergesort(l->list,
-                               (list_of_cobjects == true) ? compare_cobjects
-                                                          : l->compare_to);
+    if (l->ring != NULL)
+        ret = ring_sort(l->ring, cmp);
+    else
+        list_sort(l, cmp);
 
-    pthread_mutex_unlock(&l->lock);
+    pthread_rwlock_unlock(&l->lock);
 
-    return 0;
+    return ret;
 }
 
-static int get_indexof(const void *list, enum cl_object object, void *content,
-    unsigned int size, enum cl_object node_content, bool bottom_up)
+/*
+ * Lookups compare the list nodes against a probe node holding the searched
+ * content. It lives on the stack since it never leaves the lookup.
+ */
+static void init_probe(struct gnode_s *probe, void *content,
+    unsigned int size, enum cl_object node_object)
 {
-    glist_s *l = (glist_s *)list;
-    struct gnode_s *node = NULL;
-    bool list_of_cobjects;
-    int idx;
+    memset(probe, 0, sizeof(struct gnode_s));
+    init_node(probe, content, size, NULL, node_object);
+}
 
-    __clib_function_init__(true, list, object, -1);
-    list_of_cobjects = is_list_of_cobjects(l);
+/*
+ * Looks for a node equal to @probe, giving back its position or -1. The
+ * comparison runs over the nodes the list held when called, with the list
+ * already unlocked.
+ */
+static int find_node(glist_s *l, struct gnode_s *probe, bool bottom_up)
+{
+    struct gnode_s **nodes = NULL;
+    int (*equals)(void *, void *);
+    unsigned int i, idx, count = 0;
+    int ret = -1;
+
+    /* The first node tells which comparison to use, so it must be locked */
+    pthread_rwlock_rdlock(&l->lock);
+    equals = (is_list_of_cobjects(l) == true) ? cobjects_are_equal
+                                              : l->equals;
 
-    if ((list_of_cobjects == false) && (NULL == l->equals)) {
+    if (NULL == equals)
         cset_errno(CL_NULL_DATA);
-        return -1;
+    else if (bloom_rules_out(l, probe) == false)
+        nodes = grab_nodes(l, &count);
+
+    pthread_rwlock_unlock(&l->lock);
+
+    for (i = 0; (i < count) && (ret < 0); i++) {
+        idx = visit_order(i, count, bottom_up);
+
+        if (equals(nodes[idx], probe))
+            ret = idx;
     }
 
-    node = new_node(content, size, l, node_content);
+    release_nodes(nodes, count);
 
-    if (NULL == node)
-        return -1;
+    return ret;
+}
 
-    if (bottom_up == false) {
-        idx = cl_dll_indexof(l->list, node,
-                             (list_of_cobjects == true) ? cobjects_are_equal
-                                                        : l->equals);
-    } else
-        idx = cl_dll_last_indexof(l->list, node,
-                                  (list_of_cobjects == true) ? cobjects_are_equal
-                                                             : l->equals);
+static int get_indexof(const void *list, enum cl_object object, void *content,
+    unsigned int size, enum cl_object node_content, bool bottom_up)
+{
+    struct gnode_s probe;
 
-    destroy_node(node, false);
+    __clib_function_init__(true, list, object, -1);
+    init_probe(&probe, content, size, node_content);
 
-    return idx;
+    return find_node((glist_s *)list, &probe, bottom_up);
 }
 
 int cglist_indexof(const void *list, enum cl_object object,
@@ -715,31 +2014,12 @@ int cglist_last_indexof(const void *list, enum cl_object object,
 bool cglist_contains(const void *list, enum cl_object object,
     void *content, unsigned int size, enum cl_object node_object)
 {
-    glist_s *l = (glist_s *)list;
-    bool list_of_cobjects;
-    struct gnode_s *node = NULL;
-    bool st;
-
-    __clib_function_init__(true, list, object, -1);
-    list_of_cobjects = is_list_of_cobjects(l);
-
-    if ((list_of_cobjects == false) && (NULL == l->equals)) {
-        cset_errno(CL_NULL_DATA);
-        return -1;
-    }
-
-    node = new_node(content, size, l, node_object);
-
-    if (NULL == node)
-        return -1;
+    struct gnode_s probe;
 
-    st = cl_dll_contains(l->list, node,
-                         (list_of_cobjects == true) ? cobjects_are_equal
-                                                    : l->equals);
-
-    destroy_node(node, false);
+    __clib_function_init__(true, list, object, false);
+    init_probe(&probe, content, size, node_object);
 
-    return st;
+    return (find_node((glist_s *)list, &probe, false) >= 0) ? true : false;
 }
 
 void *cglist_peek(const void *list, enum cl_object object,
@@ -749,19 +2029,34 @@ void *cglist_peek(const void *list, enum cl_object object,
     struct gnode_s *node;
 
     __clib_function_init__(true, list, object, NULL);
-    node = cl_dll_peek(l->list);
+    pthread_rwlock_rdlock(&l->lock);
 
-    if (NULL == node)
-        return NULL;
+    if (l->ring != NULL)
+        node = (l->ring->count > 0) ? ring_at(l->ring, 0) : NULL;
+    else
+        node = l->list.first;
+
+    if (node != NULL)
+        cglist_node_ref(node, node_object);
+
+    pthread_rwlock_unlock(&l->lock);
 
-    return cglist_node_ref(node, node_object);
+    return node;
 }
 
 bool cglist_is_empty(const void *list, enum cl_object object)
 {
+    glist_s *l = (glist_s *)list;
+    bool empty;
+
     __clib_function_init__(true, list, object, false);
+    pthread_rwlock_rdlock(&l->lock);
+    empty = (l->ring != NULL) ? (l->ring->count == 0)
+                              : (cdll_size(&l->list) == 0);
+
+    pthread_rwlock_unlock(&l->lock);
 
-    return (NULL == list) ? true : false;
+    return empty;
 }
 
 int cglist_set_compare_to(const void *list, enum cl_object object,
@@ -775,6 +2070,55 @@ int cglist_set_compare_to(const void *list, enum cl_object object,
     return 0;
 }
 
+int cglist_set_sort_threshold(const void *list, enum cl_object object,
+    unsigned int threshold)
+{
+    glist_s *l = (glist_s *)list;
+
+    __clib_function_init__(true, list, object, -1);
+    pthread_rwlock_wrlock(&l->lock);
+    l->sort_threshold = threshold;
+    pthread_rwlock_unlock(&l->lock);
+
+    return 0;
+}
+
+/*
+ * Enables or disables the membership filter of a list. Enabling it again
+ * rebuilds the filter, which is the way to switch its hash function.
+ */
+int cglist_set_bloom_filter(const void *list, enum cl_object object,
+    bool enabled, unsigned long long (*hash)(void *))
+{
+    glist_s *l = (glist_s *)list;
+    int ret = 0;
+
+    __clib_function_init__(true, list, object, -1);
+
+    if ((enabled == true) && (NULL == hash)) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    pthread_rwlock_wrlock(&l->lock);
+    cbloom_destroy(l->bloom);
+    l->bloom = NULL;
+    l->hash = hash;
+
+    if (enabled == true) {
+        bloom_rebuild(l);
+
+        if (NULL == l->bloom) {
+            cset_errno(CL_NO_MEM);
+            ret = -1;
+        }
+    }
+
+    pthread_rwlock_unlock(&l->lock);
+
+    return ret;
+}
+
 int cglist_set_filter(const void *list, enum cl_object object,
     int (*filter)(void *, void *))
 {
@@ -800,10 +2144,20 @@ int cglist_set_equals(const void *list, enum cl_object object,
 void *cglist_middle(const void *list, enum cl_object object)
 {
     glist_s *l = (glist_s *)list;
+    struct gnode_s *node;
 
     __clib_function_init__(true, list, object, NULL);
+    pthread_rwlock_rdlock(&l->lock);
+
+    if (l->ring != NULL)
+        node = (l->ring->count > 0) ? ring_at(l->ring, l->ring->count / 2)
+                                    : NULL;
+    else
+        node = cdll_middle(&l->list);
 
-    return cl_dll_middle(l->list);
+    pthread_rwlock_unlock(&l->lock);
+
+    return node;
 }
 
 int cglist_rotate(void *list, enum cl_object object, unsigned int n)
@@ -811,8 +2165,186 @@ int cglist_rotate(void *list, enum cl_object object, unsigned int n)
     glist_s *l = (glist_s *)list;
 
     __clib_function_init__(true, list, object, -1);
-    l->list = cl_dll_rotate(l->list, n);
+    pthread_rwlock_wrlock(&l->lock);
+
+    if (l->ring != NULL)
+        ring_rotate(l->ring, n);
+    else
+        cdll_rotate(&l->list, n);
+
+    pthread_rwlock_unlock(&l->lock);
+
+    return 0;
+}
+
+int cglist_pool_stats(const void *list, enum cl_object object,
+    struct cl_list_pool_stats_s *stats)
+{
+    glist_s *l = (glist_s *)list;
+
+    __clib_function_init__(true, list, object, -1);
+
+    if (NULL == stats) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    memset(stats, 0, sizeof(struct cl_list_pool_stats_s));
+
+    if (NULL == l->pool)
+        return 0;
+
+    pthread_mutex_lock(&l->pool->lock);
+    stats->hits = l->pool->hits;
+    stats->misses = l->pool->misses;
+    stats->free_nodes = l->pool->nfree;
+    stats->allocated_nodes = l->pool->nslabs * GNODE_POOL_SLAB_SIZE;
+    pthread_mutex_unlock(&l->pool->lock);
+
+    return 0;
+}
+
+/*
+ * Creates a list whose nodes are kept inside a preallocated ring of
+ * @capacity slots instead of being linked. Once full, adding a node to one
+ * end of it drops the node at the other end.
+ */
+void *cglist_create_ring(enum cl_object object, unsigned int capacity,
+    void (*free_data)(void *), int (*compare_to)(void *, void *),
+    int (*filter)(void *, void *), int (*equals)(void *, void *))
+{
+    glist_s *l = NULL;
+
+    __clib_function_init__(false, NULL, -1, NULL);
+
+    if (capacity == 0) {
+        cset_errno(CL_INVALID_VALUE);
+        return NULL;
+    }
+
+    l = cglist_create(object, free_data, compare_to, filter, equals,
+                      CL_LIST_NODE_POOL);
+
+    if (NULL == l)
+        return NULL;
+
+    l->ring = new_ring(capacity);
+
+    if (NULL == l->ring) {
+        cglist_unref(l, object);
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    return l;
+}
+
+/*
+ *
+ * Iterators.
+ *
+ */
+
+void *cglist_iter_begin(const void *list, enum cl_object object,
+    enum cl_object iter_object)
+{
+    glist_s *l = (glist_s *)list;
+    giter_s *it = NULL;
+
+    __clib_function_init__(true, list, object, NULL);
+    it = calloc(1, sizeof(giter_s));
+
+    if (NULL == it) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    pthread_rwlock_rdlock(&l->lock);
+    it->nodes = grab_nodes(l, &it->count);
+    pthread_rwlock_unlock(&l->lock);
+
+    if ((NULL == it->nodes) && (cl_get_last_error() != CL_NO_ERROR)) {
+        free(it);
+        return NULL;
+    }
+
+    typeof_set(iter_object, it);
+
+    return it;
+}
+
+int cglist_iter_end(void *iter, enum cl_object iter_object)
+{
+    giter_s *it = (giter_s *)iter;
+
+    __clib_function_init__(true, iter, iter_object, -1);
+    release_nodes(it->nodes, it->count);
+    free(it);
 
     return 0;
 }
 
+/*
+ * Moves the cursor one node forward, or backwards if @forward is false, and
+ * gives back the new current node, without a new reference.
+ */
+void *cglist_iter_next(void *iter, enum cl_object iter_object, bool forward)
+{
+    giter_s *it = (giter_s *)iter;
+    struct gnode_s *node = NULL;
+
+    /* Cursor steps only validate it, keeping the walk cheap */
+    if (typeof_validate_object(iter, iter_object) == false)
+        return NULL;
+
+    if (NULL == it->node) {
+        /* Walking away from the end it already reached */
+        if (it->past_end == forward)
+            return NULL;
+
+        if (it->count > 0) {
+            it->index = forward ? 0 : it->count - 1;
+            node = it->nodes[it->index];
+        }
+    } else if (forward && (it->index + 1 < it->count))
+        node = it->nodes[++it->index];
+    else if (!forward && (it->index > 0))
+        node = it->nodes[--it->index];
+
+    it->node = node;
+
+    if (NULL == node)
+        it->past_end = forward;
+
+    return node;
+}
+
+void *cglist_iter_content(const void *iter, enum cl_object iter_object)
+{
+    giter_s *it = (giter_s *)iter;
+
+    if (typeof_validate_object(iter, iter_object) == false)
+        return NULL;
+
+    if (NULL == it->node) {
+        cset_errno(CL_INVALID_STATE);
+        return NULL;
+    }
+
+    return it->node->content;
+}
+
+void *cglist_iter_retain(const void *iter, enum cl_object iter_object,
+    enum cl_object node_object)
+{
+    giter_s *it = (giter_s *)iter;
+
+    __clib_function_init__(true, iter, iter_object, NULL);
+
+    if (NULL == it->node) {
+        cset_errno(CL_INVALID_STATE);
+        return NULL;
+    }
+
+    return cglist_node_ref(it->node, node_object);
+}
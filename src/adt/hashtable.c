@@ -26,16 +26,98 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <stdint.h>
 
 #include "collections.h"
 
-#define cl_hashtable_members                            \
-    cl_struct_member(unsigned int, size)                \
-    cl_struct_member(bool, replace_data)                \
-    cl_struct_member(char **, keys)                     \
-    cl_struct_member(void **, table)                    \
-    cl_struct_member(bool, (*compare)(void *, void *))  \
-    cl_struct_member(void, (*release)(void *))          \
+/*
+ * The hash table is an open addressing one using robin hood hashing. Every
+ * slot keeps the distance (plus one) from the bucket where its key should
+ * be, so a zero distance means an empty slot. Entries are deleted using
+ * backward shifting, so we never need tombstones.
+ *
+ * When growing, the current slots become the old table and its entries are
+ * moved to the new one. This may be done all at once or, in incremental
+ * mode, a few slots at every put/delete call. Lookups never move anything,
+ * so they don't change the table, and search both tables while there is an
+ * old one.
+ *
+ * Keys are copied into an internal arena, so inserting one does not need a
+ * memory allocation of its own, and slots keep the key size and hash next
+ * to the pointer. Removed keys only leave a hole in the arena, which is
+ * compacted once holes use more space than the stored keys.
+ *
+ * Every key is handled as a sequence of bytes; string keys simply do not
+ * include their '\0'. Integer keys are the exception, they are stored inside
+ * the slot itself and have a hash function of their own.
+ */
+
+/* The minimum number of slots of a table */
+#define HASHTABLE_MIN_CAPACITY              8
+
+/* The maximum load factor, in percent, before growing the table */
+#define HASHTABLE_MAX_LOAD_FACTOR           85
+
+/* The minimum size of an arena block */
+#define HASHTABLE_ARENA_BLOCK_SIZE          16384
+
+/* Flag, inside the key size, of keys stored in the slot instead of the arena */
+#define HASHTABLE_KEY_INLINE                (1U << 31)
+
+union hashtable_key_value {
+    const char          *ptr;
+    unsigned long long  ullong;
+};
+
+struct hashtable_slot {
+    union hashtable_key_value   key;
+    void                        *data;
+    uint64_t                    hash;
+    unsigned int                key_size;
+    unsigned int                distance;
+};
+
+/* A key being looked up */
+struct hashtable_key {
+    union hashtable_key_value   key;
+    unsigned int                size;
+    uint64_t                    hash;
+};
+
+struct hashtable_arena_block {
+    struct hashtable_arena_block    *next;
+    size_t                          size;
+    size_t                          used;
+    char                            data[];
+};
+
+struct hashtable_arena {
+    struct hashtable_arena_block    *blocks;
+    size_t                          live;
+    size_t                          wasted;
+};
+
+struct hashtable_table {
+    struct hashtable_slot   *slots;
+    unsigned int            capacity;
+};
+
+typedef unsigned long long (*hashtable_key_hash)(const void *, unsigned int);
+typedef bool (*hashtable_key_equals)(const void *, const void *, unsigned int);
+
+#define cl_hashtable_members                                \
+    cl_struct_member(struct hashtable_table, table)         \
+    cl_struct_member(struct hashtable_table, old)           \
+    cl_struct_member(unsigned int, migrate_idx)             \
+    cl_struct_member(unsigned int, migrated)                \
+    cl_struct_member(unsigned int, resize_step)             \
+    cl_struct_member(unsigned int, count)                   \
+    cl_struct_member(struct hashtable_arena, arena)         \
+    cl_struct_member(bool, replace_data)                    \
+    cl_struct_member(bool, (*compare)(void *, void *))      \
+    cl_struct_member(void, (*release)(void *))              \
+    cl_struct_member(hashtable_key_hash, key_hash)          \
+    cl_struct_member(hashtable_key_equals, key_equals)      \
     cl_struct_member(struct cl_ref_s, ref)
 
 cl_struct_declare(hashtable_s, cl_hashtable_members);
@@ -79,128 +161,547 @@ static int equals_keys(cl_list_node_t *a, cl_list_node_t *b)
     return 0;
 }
 
+/* Borrowed keys belong to the hash table arena */
+static void release_borrowed_key(void *key __attribute__((unused)))
+{
+}
+
 static cl_list_t *create_list_of_keys(bool dup)
 {
-    return cl_list_create((dup == true) ? free : NULL, compare_to_keys,
-                          filter_keys, equals_keys);
+    return cl_list_create((dup == true) ? free : release_borrowed_key,
+                          compare_to_keys, filter_keys, equals_keys);
 }
 
 /*
- * Copies all stored keys to a list of keys.
+ * Gets a pointer to the bytes of a stored key.
  */
-static void add_keys_to_list_of_keys(cl_list_t *keys, hashtable_s *hashtable,
-    bool dup)
+static const void *slot_key(const struct hashtable_slot *slot)
 {
-    unsigned int i;
+    if (slot->key_size & HASHTABLE_KEY_INLINE)
+        return &slot->key.ullong;
 
-    for (i = 0; i < hashtable->size; i++)
-        if (hashtable->keys[i] != NULL)
-            cl_list_push(keys, (dup == true) ? strdup(hashtable->keys[i])
-                                             : hashtable->keys[i], -1);
+    return slot->key.ptr;
+}
+
+static char *dup_slot_key(const struct hashtable_slot *slot)
+{
+    unsigned int size = slot->key_size & ~HASHTABLE_KEY_INLINE;
+    char *key;
+
+    key = malloc(size + 1);
+
+    if (NULL == key)
+        return NULL;
+
+    memcpy(key, slot_key(slot), size);
+    key[size] = '\0';
+
+    return key;
+}
+
+static unsigned int capacity_for(unsigned int size)
+{
+    unsigned int capacity = HASHTABLE_MIN_CAPACITY;
+
+    while ((capacity < size) && (capacity < (1U << 31)))
+        capacity <<= 1;
+
+    return capacity;
+}
+
+static void bytes_key(hashtable_s *hashtable, struct hashtable_key *k,
+    const void *key, unsigned int size)
+{
+    k->key.ptr = key;
+    k->size = size;
+
+    if (hashtable->key_hash != NULL)
+        k->hash = (hashtable->key_hash)(key, size);
+    else
+        k->hash = bytes_hash(key, size);
+}
+
+static void string_key(hashtable_s *hashtable, struct hashtable_key *k,
+    const char *key)
+{
+    bytes_key(hashtable, k, key, strlen(key));
 }
 
 /*
- * Count all values stored in the hash table.
+ * Integers are hashed using only the murmur3 finalizer.
  */
-static int count_values(hashtable_s *hashtable)
+static void ullong_key(struct hashtable_key *k, unsigned long long key)
 {
-    unsigned int i, c = 0;
+    uint64_t h = key;
 
-    for (i = 0; i < hashtable->size; i++)
-        if (hashtable->table[i] != NULL)
-            c++;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
 
-    return c;
+    k->key.ullong = key;
+    k->size = sizeof(unsigned long long) | HASHTABLE_KEY_INLINE;
+    k->hash = h;
 }
 
-static void create_keys_storage(hashtable_s *hashtable, unsigned int size)
+static bool keys_equal(hashtable_s *hashtable,
+    const struct hashtable_slot *slot, const struct hashtable_key *k)
 {
-    hashtable->keys = calloc(size, sizeof(char *));
+    if ((slot->hash != k->hash) || (slot->key_size != k->size))
+        return false;
+
+    if (k->size & HASHTABLE_KEY_INLINE)
+        return slot->key.ullong == k->key.ullong;
+
+    if (hashtable->key_equals != NULL)
+        return (hashtable->key_equals)(slot->key.ptr, k->key.ptr, k->size);
+
+    return memcmp(slot->key.ptr, k->key.ptr, k->size) == 0;
 }
 
-static void add_key(hashtable_s *hashtable, const char *key, unsigned int idx)
+static struct hashtable_slot *find_slot(hashtable_s *hashtable,
+    struct hashtable_table *table, const struct hashtable_key *k)
 {
-    if (hashtable->keys[idx] != NULL)
-        free(hashtable->keys[idx]);
+    unsigned int mask = table->capacity - 1;
+    unsigned int idx = k->hash & mask, distance = 1;
+    struct hashtable_slot *slot;
+
+    if (NULL == table->slots)
+        return NULL;
+
+    while (1) {
+        slot = &table->slots[idx];
 
-    hashtable->keys[idx] = strdup(key);
+        /*
+         * Robin hood invariant: if our key was here it would have stolen
+         * this slot, so we can stop looking.
+         */
+        if (slot->distance < distance)
+            return NULL;
+
+        if (keys_equal(hashtable, slot, k) == true)
+            return slot;
+
+        idx = (idx + 1) & mask;
+        distance++;
+    }
+
+    return NULL;
 }
 
-static void delete_key(hashtable_s *hashtable, unsigned int idx)
+/*
+ * Looks for a key inside the current table and, if we're in the middle of a
+ * resize, inside the old one. @table receives where it was found.
+ */
+static struct hashtable_slot *find_entry(hashtable_s *hashtable,
+    const struct hashtable_key *k, struct hashtable_table **table)
 {
-    if (hashtable->keys[idx] != NULL) {
-        free(hashtable->keys[idx]);
-        hashtable->keys[idx] = NULL;
+    struct hashtable_slot *slot;
+
+    slot = find_slot(hashtable, &hashtable->table, k);
+
+    if (slot != NULL) {
+        *table = &hashtable->table;
+        return slot;
     }
+
+    slot = find_slot(hashtable, &hashtable->old, k);
+    *table = &hashtable->old;
+
+    return slot;
 }
 
-static void clear_hashtable(hashtable_s *hashtable)
+/*
+ * Inserts an entry whose key is known not to be inside the table.
+ */
+static void insert_slot(struct hashtable_table *table,
+    struct hashtable_slot entry)
+{
+    unsigned int mask = table->capacity - 1;
+    unsigned int idx = entry.hash & mask;
+    struct hashtable_slot tmp;
+
+    entry.distance = 1;
+
+    while (1) {
+        if (table->slots[idx].distance == 0) {
+            table->slots[idx] = entry;
+            return;
+        }
+
+        /* Takes the slot from a richer entry */
+        if (table->slots[idx].distance < entry.distance) {
+            tmp = table->slots[idx];
+            table->slots[idx] = entry;
+            entry = tmp;
+        }
+
+        idx = (idx + 1) & mask;
+        entry.distance++;
+    }
+}
+
+/*
+ * Removes an entry from a table shifting back its followers, so the table
+ * never holds deleted markers. The key is not released here.
+ */
+static void delete_slot(struct hashtable_table *table,
+    struct hashtable_slot *slot)
+{
+    unsigned int mask = table->capacity - 1;
+    unsigned int idx = slot - table->slots, next;
+
+    next = (idx + 1) & mask;
+
+    while (table->slots[next].distance > 1) {
+        table->slots[idx] = table->slots[next];
+        table->slots[idx].distance--;
+        idx = next;
+        next = (next + 1) & mask;
+    }
+
+    memset(&table->slots[idx], 0, sizeof(struct hashtable_slot));
+}
+
+static void release_table(struct hashtable_table *table)
+{
+    free(table->slots);
+    table->slots = NULL;
+    table->capacity = 0;
+}
+
+static void clear_arena(struct hashtable_arena *arena)
+{
+    struct hashtable_arena_block *b;
+
+    while (arena->blocks != NULL) {
+        b = arena->blocks;
+        arena->blocks = b->next;
+        free(b);
+    }
+
+    arena->live = 0;
+    arena->wasted = 0;
+}
+
+/*
+ * Copies a key to the arena, always followed by a '\0'. Only the newest
+ * block is used, older ones are never looked at again until a compaction.
+ */
+static char *arena_store(struct hashtable_arena *arena, const void *key,
+    unsigned int size)
+{
+    struct hashtable_arena_block *b = arena->blocks;
+    size_t block_size = HASHTABLE_ARENA_BLOCK_SIZE;
+    char *p;
+
+    if ((NULL == b) || ((b->size - b->used) < (size_t)size + 1)) {
+        if (block_size < (size_t)size + 1)
+            block_size = size + 1;
+
+        b = malloc(sizeof(struct hashtable_arena_block) + block_size);
+
+        if (NULL == b)
+            return NULL;
+
+        b->size = block_size;
+        b->used = 0;
+        b->next = arena->blocks;
+        arena->blocks = b;
+    }
+
+    p = b->data + b->used;
+    memcpy(p, key, size);
+    p[size] = '\0';
+    b->used += size + 1;
+    arena->live += size + 1;
+
+    return p;
+}
+
+static void compact_table_keys(struct hashtable_table *table,
+    struct hashtable_arena *arena)
 {
     unsigned int i;
+    struct hashtable_slot *slot;
+
+    for (i = 0; i < table->capacity; i++) {
+        slot = &table->slots[i];
+
+        if ((slot->distance != 0) && !(slot->key_size & HASHTABLE_KEY_INLINE))
+            slot->key.ptr = arena_store(arena, slot->key.ptr, slot->key_size);
+    }
+}
+
+/*
+ * Moves every stored key to a single new block, dropping the holes left by
+ * removed keys. If there's no memory to do it we just keep the holes.
+ */
+static void compact_arena(hashtable_s *hashtable)
+{
+    struct hashtable_arena arena, old = hashtable->arena;
+    size_t size = old.live;
+
+    if (size < HASHTABLE_ARENA_BLOCK_SIZE)
+        size = HASHTABLE_ARENA_BLOCK_SIZE;
+
+    arena.blocks = malloc(sizeof(struct hashtable_arena_block) + size);
+
+    if (NULL == arena.blocks)
+        return;
 
-    for (i = 0; i < hashtable->size; i++) {
-        if (hashtable->table[i] != NULL)
-            hashtable->table[i] = NULL;
+    arena.blocks->next = NULL;
+    arena.blocks->size = size;
+    arena.blocks->used = 0;
+    arena.live = 0;
+    arena.wasted = 0;
+
+    /* Nothing is allocated from here, everything fits inside the block */
+    compact_table_keys(&hashtable->table, &arena);
+    compact_table_keys(&hashtable->old, &arena);
+    clear_arena(&old);
+    hashtable->arena = arena;
+}
+
+static void arena_release(hashtable_s *hashtable, unsigned int size)
+{
+    struct hashtable_arena *arena = &hashtable->arena;
+
+    arena->live -= size + 1;
+    arena->wasted += size + 1;
 
-        delete_key(hashtable, i);
+    if ((arena->wasted > HASHTABLE_ARENA_BLOCK_SIZE) &&
+        (arena->wasted > arena->live))
+    {
+        compact_arena(hashtable);
     }
 }
 
-static bool contains_key(hashtable_s *hashtable, const char *key)
+/*
+ * Gets a key to be handed out by cl_hashtable_keys. Borrowed keys are the
+ * arena copies themselves, except for integer keys, which live inside the
+ * slots and move whenever the table changes. These get an arena copy of
+ * their own, accounted as a hole so the next compaction drops it.
+ */
+static char *list_key(hashtable_s *hashtable, const struct hashtable_slot *slot,
+    bool dup)
+{
+    unsigned int size = slot->key_size & ~HASHTABLE_KEY_INLINE;
+    struct hashtable_arena *arena = &hashtable->arena;
+    char *key;
+
+    if (dup == true)
+        return dup_slot_key(slot);
+
+    if (!(slot->key_size & HASHTABLE_KEY_INLINE))
+        return (char *)slot->key.ptr;
+
+    key = arena_store(arena, slot_key(slot), size);
+
+    if (key != NULL) {
+        arena->live -= size + 1;
+        arena->wasted += size + 1;
+    }
+
+    return key;
+}
+
+/*
+ * Adds all stored keys from a table to a list of keys.
+ */
+static int add_keys_to_list_of_keys(hashtable_s *hashtable, cl_list_t *keys,
+    struct hashtable_table *table, bool dup)
 {
     unsigned int i;
+    struct hashtable_slot *slot;
+    char *key;
 
-    /* Very poor search method */
-    for (i = 0; i < hashtable->size; i++)
-        if ((hashtable->keys[i] != NULL) &&
-            (strcmp(hashtable->keys[i], key) == 0))
+    for (i = 0; i < table->capacity; i++) {
+        slot = &table->slots[i];
+
+        if (slot->distance == 0)
+            continue;
+
+        key = list_key(hashtable, slot, dup);
+
+        if (NULL == key) {
+            cset_errno(CL_NO_MEM);
+            return -1;
+        }
+
+        /*
+         * The stored size, since bytes keys may hold '\0' themselves. It
+         * also keeps short keys from being probed as cl_objects.
+         */
+        if (cl_list_push(keys, key,
+                         slot->key_size & ~HASHTABLE_KEY_INLINE) < 0)
         {
-            return true;
+            if (dup == true)
+                free(key);
+
+            return -1;
         }
+    }
 
-    return false;
+    return 0;
 }
 
-static bool contains_value(hashtable_s *hashtable, void *data)
+/*
+ * Moves at least @n slots from the old table into the current one.
+ *
+ * Slots are moved one whole cluster (a run of used slots) at a time. Since
+ * the probe sequence of any key never leaves its cluster, the entries still
+ * inside the old table can be found even with the moved ones emptied.
+ */
+static void migrate(hashtable_s *hashtable, unsigned int n)
+{
+    struct hashtable_table *old = &hashtable->old;
+    struct hashtable_slot *slot;
+    unsigned int mask = old->capacity - 1;
+
+    while ((old->slots != NULL) && (n > 0)) {
+        do {
+            slot = &old->slots[hashtable->migrate_idx];
+
+            if (slot->distance != 0) {
+                insert_slot(&hashtable->table, *slot);
+                memset(slot, 0, sizeof(struct hashtable_slot));
+            }
+
+            hashtable->migrate_idx = (hashtable->migrate_idx + 1) & mask;
+            hashtable->migrated++;
+            n = (n > 0) ? n - 1 : 0;
+        } while ((old->slots[hashtable->migrate_idx].distance != 0) &&
+                 (hashtable->migrated < old->capacity));
+
+        if (hashtable->migrated == old->capacity)
+            release_table(old);
+    }
+}
+
+static int resize(hashtable_s *hashtable, unsigned int capacity)
+{
+    struct hashtable_table table;
+    unsigned int start = 0;
+
+    /* An unfinished resize must be done before starting another one */
+    migrate(hashtable, hashtable->old.capacity);
+
+    table.capacity = capacity;
+    table.slots = calloc(capacity, sizeof(struct hashtable_slot));
+
+    if (NULL == table.slots)
+        return -1;
+
+    /*
+     * The migration starts right after an empty slot, so it never begins in
+     * the middle of a cluster.
+     */
+    while (hashtable->table.slots[start].distance != 0)
+        start++;
+
+    hashtable->old = hashtable->table;
+    hashtable->table = table;
+    hashtable->migrate_idx = (start + 1) & (hashtable->old.capacity - 1);
+    hashtable->migrated = 1;
+
+    if (hashtable->resize_step == 0)
+        migrate(hashtable, hashtable->old.capacity);
+
+    return 0;
+}
+
+static bool needs_to_grow(hashtable_s *hashtable)
+{
+    return ((unsigned long long)(hashtable->count + 1) * 100 >
+            (unsigned long long)hashtable->table.capacity *
+                HASHTABLE_MAX_LOAD_FACTOR);
+}
+
+static void clear_hashtable(hashtable_s *hashtable)
+{
+    struct hashtable_table *table = &hashtable->table;
+
+    release_table(&hashtable->old);
+    memset(table->slots, 0, table->capacity * sizeof(struct hashtable_slot));
+    clear_arena(&hashtable->arena);
+    hashtable->count = 0;
+}
+
+static bool table_contains_value(hashtable_s *hashtable,
+    struct hashtable_table *table, void *data)
 {
     unsigned int i;
+    struct hashtable_slot *slot;
 
     /* Very poor search method */
-    for (i = 0; i < hashtable->size; i++)
+    for (i = 0; i < table->capacity; i++) {
+        slot = &table->slots[i];
+
+        if (slot->distance == 0)
+            continue;
+
         if (NULL == hashtable->compare) {
-            if (hashtable->table[i] == data)
+            if (slot->data == data)
                 return true;
         } else
-            if ((hashtable->compare)(hashtable->table[i], data))
+            if ((hashtable->compare)(slot->data, data))
                 return true;
+    }
 
     return false;
 }
 
-static void destroy_hashtable_s(const struct cl_ref_s *ref)
+static const char *map_table(struct hashtable_table *table,
+    int (*foo)(const char *, void *, void *), void *data)
 {
-    hashtable_s *h = cl_container_of(ref, hashtable_s, ref);
     unsigned int i;
+    struct hashtable_slot *slot;
 
-    if (NULL == h)
-        return;
-
-    if (h->keys != NULL) {
-        for (i = 0; i < h->size; i++)
-            if (h->keys[i] != NULL)
-                free(h->keys[i]);
+    for (i = 0; i < table->capacity; i++) {
+        slot = &table->slots[i];
 
-        free(h->keys);
+        if ((slot->distance != 0) &&
+            (foo(slot_key(slot), slot->data, data) != 0))
+        {
+            return slot_key(slot);
+        }
     }
 
-    if (h->table != NULL) {
-        for (i = 0; i < h->size; i++)
-            if ((h->table[i] != NULL) && (h->release != NULL))
-                (h->release)(h->table[i]);
+    return NULL;
+}
 
-        free(h->table);
-    }
+static bool contains_value(hashtable_s *hashtable, void *data)
+{
+    if (table_contains_value(hashtable, &hashtable->table, data) == true)
+        return true;
+
+    return table_contains_value(hashtable, &hashtable->old, data);
+}
+
+static void destroy_table(hashtable_s *h, struct hashtable_table *table)
+{
+    unsigned int i;
+
+    if (h->release != NULL)
+        for (i = 0; i < table->capacity; i++)
+            if (table->slots[i].distance != 0)
+                (h->release)(table->slots[i].data);
+
+    release_table(table);
+}
+
+static void destroy_hashtable_s(const struct cl_ref_s *ref)
+{
+    hashtable_s *h = cl_container_of(ref, hashtable_s, ref);
 
+    if (NULL == h)
+        return;
+
+    destroy_table(h, &h->table);
+    destroy_table(h, &h->old);
+    clear_arena(&h->arena);
     free(h);
     h = NULL;
 }
@@ -217,19 +718,20 @@ static hashtable_s *new_hashtable_s(unsigned int size, bool replace_data,
         return NULL;
     }
 
-    h->table = calloc(size, sizeof(void *));
+    h->table.capacity = capacity_for(size);
+    h->table.slots = calloc(h->table.capacity, sizeof(struct hashtable_slot));
 
-    if (NULL == h->table) {
+    if (NULL == h->table.slots) {
         free(h);
         cset_errno(CL_NO_MEM);
         return NULL;
     }
 
-    h->size = size;
+    h->count = 0;
+    h->resize_step = 0;
     h->replace_data = replace_data;
     h->compare = compare;
     h->release = release;
-    create_keys_storage(h, size);
 
     /* Reference count */
     h->ref.count = 1;
@@ -241,28 +743,129 @@ static hashtable_s *new_hashtable_s(unsigned int size, bool replace_data,
 }
 
 /*
- * Jenkins one at a time hash function.
+ *
+ * Key type independent operations, called by the exported functions after
+ * validating their arguments.
+ *
  */
-static unsigned short int hash(const char *key, unsigned int hashtable_size)
+
+static void *put_entry(hashtable_s *hashtable, const struct hashtable_key *k,
+    void *data)
 {
-    unsigned int h = 0, i = 0, length;
+    struct hashtable_slot *slot, entry;
+    struct hashtable_table *table;
+    enum cl_error_code error = CL_NO_ERROR;
+    void *ret = NULL;
 
-    if (NULL == key)
-        return 0;
+    cl_hashtable_ref(hashtable);
+    migrate(hashtable, hashtable->resize_step);
+    slot = find_entry(hashtable, k, &table);
+
+    if (slot != NULL) {
+        if (hashtable->replace_data == false) {
+            /* The key is already being used */
+            error = CL_HASHTABLE_COLLISION;
+            goto end_block;
+        }
 
-    length = strlen(key);
+        ret = slot->data;
+        slot->data = data;
+        goto end_block;
+    }
 
-    for (i = 0; i < length; ++i) {
-        h += key[i];
-        h += (h << 10);
-        h ^= (h >> 6);
+    if (needs_to_grow(hashtable) &&
+        (resize(hashtable, hashtable->table.capacity << 1) < 0))
+    {
+        error = CL_NO_MEM;
+        goto end_block;
     }
 
-    h += (h << 3);
-    h ^= (h >> 11);
-    h += (h << 15);
+    if (k->size & HASHTABLE_KEY_INLINE)
+        entry.key = k->key;
+    else {
+        entry.key.ptr = arena_store(&hashtable->arena, k->key.ptr, k->size);
+
+        if (NULL == entry.key.ptr) {
+            error = CL_NO_MEM;
+            goto end_block;
+        }
+    }
 
-	return h % hashtable_size;
+    entry.key_size = k->size;
+    entry.data = data;
+    entry.hash = k->hash;
+    insert_slot(&hashtable->table, entry);
+    hashtable->count++;
+
+end_block:
+    cl_hashtable_unref(hashtable);
+
+    /* Only now, so unref does not clear it */
+    if (error != CL_NO_ERROR)
+        cset_errno(error);
+
+    return ret;
+}
+
+static void *get_entry(hashtable_s *hashtable, const struct hashtable_key *k)
+{
+    struct hashtable_slot *slot;
+    struct hashtable_table *table;
+    void *ptr = NULL;
+
+    cl_hashtable_ref(hashtable);
+    slot = find_entry(hashtable, k, &table);
+
+    if (slot != NULL)
+        ptr = slot->data;
+
+    cl_hashtable_unref(hashtable);
+
+    return ptr;
+}
+
+static int delete_entry(hashtable_s *hashtable, const struct hashtable_key *k)
+{
+    struct hashtable_slot *slot;
+    struct hashtable_table *table;
+    int ret = -1;
+
+    cl_hashtable_ref(hashtable);
+    migrate(hashtable, hashtable->resize_step);
+    slot = find_entry(hashtable, k, &table);
+
+    if (slot != NULL) {
+        delete_slot(table, slot);
+        hashtable->count--;
+
+        if (!(k->size & HASHTABLE_KEY_INLINE))
+            arena_release(hashtable, k->size);
+
+        ret = 0;
+    }
+
+    cl_hashtable_unref(hashtable);
+
+    if (ret < 0)
+        cset_errno(CL_OBJECT_NOT_FOUND);
+
+    return ret;
+}
+
+static bool contains_entry(hashtable_s *hashtable,
+    const struct hashtable_key *k)
+{
+    struct hashtable_table *table;
+    bool ret = false;
+
+    cl_hashtable_ref(hashtable);
+
+    if (find_entry(hashtable, k, &table) != NULL)
+        ret = true;
+
+    cl_hashtable_unref(hashtable);
+
+    return ret;
 }
 
 /*
@@ -320,9 +923,7 @@ __PUB_API__ int cl_hashtable_uninit(cl_hashtable_t *hashtable)
 __PUB_API__ void *cl_hashtable_put(cl_hashtable_t *hashtable, const char *key,
     void *data)
 {
-    hashtable_s *h;
-    int idx = -1;
-    void *ret = NULL;
+    struct hashtable_key k;
 
     __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, NULL);
 
@@ -331,31 +932,14 @@ __PUB_API__ void *cl_hashtable_put(cl_hashtable_t *hashtable, const char *key,
         return NULL;
     }
 
-    h = cl_hashtable_ref(hashtable);
-    idx = hash(key, h->size);
+    string_key(hashtable, &k, key);
 
-    if (h->table[idx] != NULL) {
-        if (h->replace_data == false) {
-            /* We don't handle collisions */
-            cset_errno(CL_HASHTABLE_COLLISION);
-            goto end_block;
-        }
-    }
-
-    ret = h->table[idx];
-    h->table[idx] = data;
-    add_key(h, key, idx);
-
-end_block:
-    cl_hashtable_unref(h);
-    return ret;
+    return put_entry(hashtable, &k, data);
 }
 
 __PUB_API__ void *cl_hashtable_get(cl_hashtable_t *hashtable, const char *key)
 {
-    hashtable_s *h;
-    int idx = -1;
-    void *ptr = NULL;
+    struct hashtable_key k;
 
     __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, NULL);
 
@@ -364,18 +948,14 @@ __PUB_API__ void *cl_hashtable_get(cl_hashtable_t *hashtable, const char *key)
         return NULL;
     }
 
-    h = cl_hashtable_ref(hashtable);
-    idx = hash(key, h->size);
-    ptr = h->table[idx];
-    cl_hashtable_unref(h);
+    string_key(hashtable, &k, key);
 
-    return ptr;
+    return get_entry(hashtable, &k);
 }
 
 __PUB_API__ int cl_hashtable_delete(cl_hashtable_t *hashtable, const char *key)
 {
-    hashtable_s *h;
-    int idx = -1, ret = -1;
+    struct hashtable_key k;
 
     __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, -1);
 
@@ -384,34 +964,164 @@ __PUB_API__ int cl_hashtable_delete(cl_hashtable_t *hashtable, const char *key)
         return -1;
     }
 
-    h = cl_hashtable_ref(hashtable);
-    idx = hash(key, h->size);
-    h->table[idx] = NULL;
-    delete_key(h, idx);
-    ret = 0;
-    cl_hashtable_unref(h);
+    string_key(hashtable, &k, key);
 
-    return ret;
+    return delete_entry(hashtable, &k);
 }
 
 __PUB_API__ bool cl_hashtable_contains_key(cl_hashtable_t *hashtable,
     const char *key)
 {
-    hashtable_s *h;
-    bool ret = false;
+    struct hashtable_key k;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, false);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return false;
+    }
+
+    string_key(hashtable, &k, key);
+
+    return contains_entry(hashtable, &k);
+}
+
+__PUB_API__ void *cl_hashtable_put_bytes(cl_hashtable_t *hashtable,
+    const void *key, unsigned int size, void *data)
+{
+    struct hashtable_key k;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, NULL);
+
+    if ((NULL == key) || (NULL == data)) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    if (size & HASHTABLE_KEY_INLINE) {
+        cset_errno(CL_INVALID_VALUE);
+        return NULL;
+    }
+
+    bytes_key(hashtable, &k, key, size);
+
+    return put_entry(hashtable, &k, data);
+}
+
+__PUB_API__ void *cl_hashtable_get_bytes(cl_hashtable_t *hashtable,
+    const void *key, unsigned int size)
+{
+    struct hashtable_key k;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, NULL);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    if (size & HASHTABLE_KEY_INLINE) {
+        cset_errno(CL_INVALID_VALUE);
+        return NULL;
+    }
+
+    bytes_key(hashtable, &k, key, size);
+
+    return get_entry(hashtable, &k);
+}
+
+__PUB_API__ int cl_hashtable_delete_bytes(cl_hashtable_t *hashtable,
+    const void *key, unsigned int size)
+{
+    struct hashtable_key k;
 
     __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, -1);
 
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    if (size & HASHTABLE_KEY_INLINE) {
+        cset_errno(CL_INVALID_VALUE);
+        return -1;
+    }
+
+    bytes_key(hashtable, &k, key, size);
+
+    return delete_entry(hashtable, &k);
+}
+
+__PUB_API__ bool cl_hashtable_contains_key_bytes(cl_hashtable_t *hashtable,
+    const void *key, unsigned int size)
+{
+    struct hashtable_key k;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, false);
+
     if (NULL == key) {
         cset_errno(CL_NULL_ARG);
         return false;
     }
 
-    h = cl_hashtable_ref(hashtable);
-    ret = contains_key(h, key);
-    cl_hashtable_unref(h);
+    if (size & HASHTABLE_KEY_INLINE) {
+        cset_errno(CL_INVALID_VALUE);
+        return false;
+    }
 
-    return ret;
+    bytes_key(hashtable, &k, key, size);
+
+    return contains_entry(hashtable, &k);
+}
+
+__PUB_API__ void *cl_hashtable_put_ullong(cl_hashtable_t *hashtable,
+    unsigned long long key, void *data)
+{
+    struct hashtable_key k;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, NULL);
+
+    if (NULL == data) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    ullong_key(&k, key);
+
+    return put_entry(hashtable, &k, data);
+}
+
+__PUB_API__ void *cl_hashtable_get_ullong(cl_hashtable_t *hashtable,
+    unsigned long long key)
+{
+    struct hashtable_key k;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, NULL);
+    ullong_key(&k, key);
+
+    return get_entry(hashtable, &k);
+}
+
+__PUB_API__ int cl_hashtable_delete_ullong(cl_hashtable_t *hashtable,
+    unsigned long long key)
+{
+    struct hashtable_key k;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, -1);
+    ullong_key(&k, key);
+
+    return delete_entry(hashtable, &k);
+}
+
+__PUB_API__ bool cl_hashtable_contains_key_ullong(cl_hashtable_t *hashtable,
+    unsigned long long key)
+{
+    struct hashtable_key k;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, false);
+    ullong_key(&k, key);
+
+    return contains_entry(hashtable, &k);
 }
 
 __PUB_API__ int cl_hashtable_size(cl_hashtable_t *hashtable)
@@ -422,7 +1132,7 @@ __PUB_API__ int cl_hashtable_size(cl_hashtable_t *hashtable)
     __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, -1);
 
     h = cl_hashtable_ref(hashtable);
-    size = count_values(h);
+    size = h->count;
     cl_hashtable_unref(h);
 
     return size;
@@ -473,9 +1183,111 @@ __PUB_API__ cl_list_t *cl_hashtable_keys(cl_hashtable_t *hashtable, bool dup)
         return NULL;
 
     h = cl_hashtable_ref(hashtable);
-    add_keys_to_list_of_keys(keys, h, dup);
+
+    if ((add_keys_to_list_of_keys(h, keys, &h->table, dup) < 0) ||
+        (add_keys_to_list_of_keys(h, keys, &h->old, dup) < 0))
+    {
+        cl_list_destroy(keys);
+        keys = NULL;
+    }
+
     cl_hashtable_unref(h);
 
     return keys;
 }
 
+
+__PUB_API__ int cl_hashtable_set_incremental_resize(cl_hashtable_t *hashtable,
+    unsigned int slots_per_operation)
+{
+    hashtable_s *h;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, -1);
+
+    h = cl_hashtable_ref(hashtable);
+    h->resize_step = slots_per_operation;
+
+    /* Going back to blocking mode finishes a pending resize */
+    if (slots_per_operation == 0)
+        migrate(h, h->old.capacity);
+
+    cl_hashtable_unref(h);
+
+    return 0;
+}
+
+__PUB_API__ int cl_hashtable_stats(cl_hashtable_t *hashtable,
+    struct cl_hashtable_stats_s *stats)
+{
+    hashtable_s *h;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, -1);
+
+    if (NULL == stats) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    h = cl_hashtable_ref(hashtable);
+    stats->size = h->count;
+    stats->capacity = h->table.capacity;
+    stats->resizing = (h->old.slots != NULL) ? true : false;
+    stats->old_capacity = h->old.capacity;
+    stats->migrated_slots = (h->old.slots != NULL) ? h->migrated : 0;
+    stats->load_factor = (h->table.capacity != 0)
+                            ? (double)h->count / h->table.capacity : 0;
+
+    cl_hashtable_unref(h);
+
+    return 0;
+}
+
+__PUB_API__ const char *cl_hashtable_map(cl_hashtable_t *hashtable,
+    int (*foo)(const char *, void *, void *), void *data)
+{
+    hashtable_s *h;
+    const char *key = NULL;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, NULL);
+
+    if (NULL == foo) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    h = cl_hashtable_ref(hashtable);
+    key = map_table(&h->table, foo, data);
+
+    if (NULL == key)
+        key = map_table(&h->old, foo, data);
+
+    cl_hashtable_unref(h);
+
+    return key;
+}
+
+__PUB_API__ int cl_hashtable_set_key_functions(cl_hashtable_t *hashtable,
+    unsigned long long (*hash)(const void *, unsigned int),
+    bool (*equals)(const void *, const void *, unsigned int))
+{
+    hashtable_s *h;
+    int ret = -1;
+
+    __clib_function_init__(true, hashtable, CL_OBJ_HASHTABLE, -1);
+    h = cl_hashtable_ref(hashtable);
+
+    /* Stored keys were hashed with the previous function */
+    if (h->count == 0) {
+        h->key_hash = hash;
+        h->key_equals = equals;
+        ret = 0;
+    }
+
+    cl_hashtable_unref(h);
+
+    if (ret < 0)
+        cset_errno(CL_INVALID_STATE);
+
+    return ret;
+}
+
@@ -0,0 +1,390 @@
+
+/*
+ * Description: A lock-free stack shared between several threads.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 18:20:37 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <pthread.h>
+
+#include "collections.h"
+
+/*
+ * Two Treiber stacks share the same nodes: @items, with the elements, and
+ * @free_nodes, with the nodes not in use. A push moves a node from the
+ * second to the first and a pop moves it back.
+ *
+ * Nodes are only released with the stack, so a thread may always read the
+ * node it saw at the top, even if it was popped meanwhile. To keep such
+ * thread from swapping the top for a stale one (ABA), a top is a single
+ * 64-bit word with the node in its lower half and a counter bumped on every
+ * change in its upper half. Nodes are therefore referred by 32-bit indexes,
+ * starting at 1 so that 0 means an empty stack.
+ *
+ * An unbounded stack grows by slabs, each one twice as large as the last,
+ * so an index maps to its slab with a few bit operations.
+ */
+
+#define LFSTACK_CACHE_LINE          64
+
+/* Nodes of the first slab of an unbounded stack */
+#define LFSTACK_SLAB_SIZE           64
+
+/* Enough slabs to use every index available */
+#define LFSTACK_MAX_SLABS           26
+
+struct lfnode {
+    unsigned int        next;
+    unsigned int        content_size;
+    void                *content;
+};
+
+/* Keeps each contended word in its own cache line */
+struct lfword {
+    unsigned long long  value;
+} __attribute__((aligned(LFSTACK_CACHE_LINE)));
+
+#define cl_lfstack_members                                          \
+    cl_struct_member(struct lfword, items)                          \
+    cl_struct_member(struct lfword, free_nodes)                     \
+    cl_struct_member(struct lfword, count)                          \
+    cl_struct_member(struct lfnode *, slabs[LFSTACK_MAX_SLABS])     \
+    cl_struct_member(unsigned int, nslabs)                          \
+    cl_struct_member(unsigned int, slab_size)                       \
+    cl_struct_member(unsigned int, capacity)                        \
+    cl_struct_member(void, (*free_data)(void *))                    \
+    cl_struct_member(pthread_mutex_t, grow_lock)                    \
+    cl_struct_member(struct cl_ref_s, ref)
+
+cl_struct_declare(lfstack_s, cl_lfstack_members);
+
+#define lfstack_s           cl_struct(lfstack_s)
+
+static struct lfnode *node_at(lfstack_s *s, unsigned int index)
+{
+    unsigned int i = index - 1, k;
+
+    /* Slab k starts at slab_size * (2^k - 1) */
+    k = 31 - __builtin_clz(i / s->slab_size + 1);
+
+    return &s->slabs[k][i - s->slab_size * ((1U << k) - 1)];
+}
+
+/*
+ * Puts the chain of nodes from @first to @last, already linked, on top of
+ * @top.
+ */
+static void push_nodes(lfstack_s *s, struct lfword *top, unsigned int first,
+    unsigned int last)
+{
+    struct lfnode *n = node_at(s, last);
+    unsigned long long old, new;
+
+    old = __atomic_load_n(&top->value, __ATOMIC_RELAXED);
+
+    do {
+        __atomic_store_n(&n->next, (unsigned int)old, __ATOMIC_RELAXED);
+        new = (((old >> 32) + 1) << 32) | first;
+    } while (__atomic_compare_exchange_n(&top->value, &old, new, true,
+                                         __ATOMIC_RELEASE,
+                                         __ATOMIC_RELAXED) == false);
+}
+
+/* Takes the node at the top of @top, returning 0 if there is none */
+static unsigned int pop_node(lfstack_s *s, struct lfword *top)
+{
+    unsigned long long old, new;
+    unsigned int index, next;
+
+    old = __atomic_load_n(&top->value, __ATOMIC_ACQUIRE);
+
+    do {
+        index = (unsigned int)old;
+
+        if (index == 0)
+            return 0;
+
+        next = __atomic_load_n(&node_at(s, index)->next, __ATOMIC_RELAXED);
+        new = (((old >> 32) + 1) << 32) | next;
+    } while (__atomic_compare_exchange_n(&top->value, &old, new, true,
+                                         __ATOMIC_ACQUIRE,
+                                         __ATOMIC_ACQUIRE) == false);
+
+    return index;
+}
+
+/*
+ * Allocates one more slab, keeping its first node to the caller. Returns 0
+ * if it can't, or if another thread grew the stack meanwhile.
+ */
+static unsigned int grow(lfstack_s *s)
+{
+    struct lfnode *slab;
+    unsigned int k, i, n, base = 0;
+
+    pthread_mutex_lock(&s->grow_lock);
+
+    if ((unsigned int)__atomic_load_n(&s->free_nodes.value,
+                                      __ATOMIC_RELAXED) != 0)
+    {
+        goto end_block;
+    }
+
+    k = s->nslabs;
+
+    if (k == LFSTACK_MAX_SLABS) {
+        cset_errno(CL_NO_MEM);
+        goto end_block;
+    }
+
+    n = s->slab_size << k;
+    slab = calloc(n, sizeof(struct lfnode));
+
+    if (NULL == slab) {
+        cset_errno(CL_NO_MEM);
+        goto end_block;
+    }
+
+    base = s->slab_size * ((1U << k) - 1) + 1;
+
+    for (i = 0; i < n - 1; i++)
+        slab[i].next = base + i + 1;
+
+    s->slabs[k] = slab;
+    s->nslabs++;
+
+    if (n > 1)
+        push_nodes(s, &s->free_nodes, base + 1, base + n - 1);
+
+end_block:
+    pthread_mutex_unlock(&s->grow_lock);
+
+    return base;
+}
+
+/*
+ * Releases an element left inside the stack, the same way a list node
+ * releases its content.
+ */
+static void release_content(lfstack_s *s, struct lfnode *n)
+{
+    if (s->free_data != NULL)
+        (s->free_data)(n->content);
+    else if (n->content_size < CL_OBJECT_HEADER_ID_SIZE)
+        free(n->content);
+    else if (typeof_validate_object(n->content, CL_OBJ_OBJECT) == true)
+        cl_object_destroy(n->content);
+}
+
+static void destroy_lfstack_s(const struct cl_ref_s *ref)
+{
+    lfstack_s *s = cl_container_of(ref, lfstack_s, ref);
+    struct lfnode *n;
+    unsigned int index, k;
+
+    if (NULL == s)
+        return;
+
+    index = (unsigned int)s->items.value;
+
+    while (index != 0) {
+        n = node_at(s, index);
+        release_content(s, n);
+        index = n->next;
+    }
+
+    for (k = 0; k < s->nslabs; k++)
+        free(s->slabs[k]);
+
+    pthread_mutex_destroy(&s->grow_lock);
+    free(s);
+    s = NULL;
+}
+
+static lfstack_s *new_lfstack_s(unsigned int capacity,
+    void (*free_data)(void *))
+{
+    lfstack_s *s = NULL;
+
+    if (posix_memalign((void **)&s, LFSTACK_CACHE_LINE,
+                       sizeof(lfstack_s)) != 0)
+    {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    memset(s, 0, sizeof(lfstack_s));
+    s->capacity = capacity;
+    s->slab_size = (capacity != 0) ? capacity : LFSTACK_SLAB_SIZE;
+    s->free_data = free_data;
+    pthread_mutex_init(&s->grow_lock, NULL);
+
+    /* A bounded stack has all its nodes from the beginning */
+    if (capacity != 0) {
+        if (grow(s) == 0) {
+            pthread_mutex_destroy(&s->grow_lock);
+            free(s);
+            return NULL;
+        }
+
+        push_nodes(s, &s->free_nodes, 1, 1);
+    }
+
+    typeof_set(CL_OBJ_LFSTACK, s);
+
+    /* Reference count */
+    s->ref.count = 1;
+    s->ref.free = destroy_lfstack_s;
+
+    return s;
+}
+
+/*
+ *
+ * API
+ *
+ */
+
+__PUB_API__ cl_lfstack_t *cl_lfstack_ref(cl_lfstack_t *stack)
+{
+    lfstack_s *s = (lfstack_s *)stack;
+
+    __clib_function_init__(true, stack, CL_OBJ_LFSTACK, NULL);
+    cl_ref_inc(&s->ref);
+
+    return stack;
+}
+
+__PUB_API__ int cl_lfstack_unref(cl_lfstack_t *stack)
+{
+    lfstack_s *s = (lfstack_s *)stack;
+
+    __clib_function_init__(true, stack, CL_OBJ_LFSTACK, -1);
+    cl_ref_dec(&s->ref);
+
+    return 0;
+}
+
+__PUB_API__ cl_lfstack_t *cl_lfstack_create(unsigned int capacity,
+    void (*free_data)(void *))
+{
+    __clib_function_init__(false, NULL, -1, NULL);
+
+    if (capacity > (1U << 31)) {
+        cset_errno(CL_INVALID_VALUE);
+        return NULL;
+    }
+
+    return new_lfstack_s(capacity, free_data);
+}
+
+__PUB_API__ int cl_lfstack_destroy(cl_lfstack_t *stack)
+{
+    return cl_lfstack_unref(stack);
+}
+
+__PUB_API__ bool cl_lfstack_push(cl_lfstack_t *stack,
+    const void *node_content, unsigned int size)
+{
+    lfstack_s *s = (lfstack_s *)stack;
+    struct lfnode *n;
+    unsigned int index;
+
+    __clib_function_init__(true, stack, CL_OBJ_LFSTACK, false);
+
+    if (NULL == node_content) {
+        cset_errno(CL_NULL_ARG);
+        return false;
+    }
+
+    while ((index = pop_node(s, &s->free_nodes)) == 0) {
+        /* Full */
+        if (s->capacity != 0)
+            return false;
+
+        index = grow(s);
+
+        if (index != 0)
+            break;
+
+        if (cl_get_last_error() != CL_NO_ERROR)
+            return false;
+    }
+
+    n = node_at(s, index);
+    n->content = (void *)node_content;
+    n->content_size = size;
+    push_nodes(s, &s->items, index, index);
+    __atomic_add_fetch(&s->count.value, 1, __ATOMIC_RELAXED);
+
+    return true;
+}
+
+__PUB_API__ cl_stack_node_t *cl_lfstack_pop(cl_lfstack_t *stack)
+{
+    lfstack_s *s = (lfstack_s *)stack;
+    cl_stack_node_t *node;
+    struct lfnode *n;
+    unsigned int index;
+
+    __clib_function_init__(true, stack, CL_OBJ_LFSTACK, NULL);
+    index = pop_node(s, &s->items);
+
+    if (index == 0)
+        return NULL;
+
+    n = node_at(s, index);
+    node = cglist_node_create(n->content, n->content_size, s->free_data,
+                              CL_OBJ_STACK_NODE);
+
+    if (NULL == node) {
+        /* Gives the element back */
+        push_nodes(s, &s->items, index, index);
+        return NULL;
+    }
+
+    push_nodes(s, &s->free_nodes, index, index);
+    __atomic_sub_fetch(&s->count.value, 1, __ATOMIC_RELAXED);
+
+    return node;
+}
+
+__PUB_API__ int cl_lfstack_size(cl_lfstack_t *stack)
+{
+    lfstack_s *s = (lfstack_s *)stack;
+    long long count;
+
+    __clib_function_init__(true, stack, CL_OBJ_LFSTACK, -1);
+    count = (long long)__atomic_load_n(&s->count.value, __ATOMIC_RELAXED);
+
+    /* A pop may be counted before the push that fed it */
+    return (count < 0) ? 0 : (int)count;
+}
+
+__PUB_API__ bool cl_lfstack_is_empty(cl_lfstack_t *stack)
+{
+    return (cl_lfstack_size(stack) == 0) ? true : false;
+}
+
@@ -57,7 +57,16 @@ __PUB_API__ cl_list_t *cl_list_create(void (*free_data)(void *),
     int (*equals)(cl_list_node_t *, cl_list_node_t *))
 {
     return (cl_list_t *)cglist_create(CL_OBJ_LIST, free_data, compare_to,
-                                      filter, equals);
+                                      filter, equals, 0);
+}
+
+__PUB_API__ cl_list_t *cl_list_create_ex(void (*free_data)(void *),
+    int (*compare_to)(cl_list_node_t *, cl_list_node_t *),
+    int (*filter)(cl_list_node_t *, void *),
+    int (*equals)(cl_list_node_t *, cl_list_node_t *), unsigned int flags)
+{
+    return (cl_list_t *)cglist_create(CL_OBJ_LIST, free_data, compare_to,
+                                      filter, equals, flags);
 }
 
 __PUB_API__ int cl_list_destroy(cl_list_t *list)
@@ -94,6 +103,18 @@ __PUB_API__ int cl_list_unshift(cl_list_t *list, const void *node_content,
                           CL_OBJ_LIST_NODE);
 }
 
+__PUB_API__ int cl_list_push_many(cl_list_t *list, void **contents,
+    unsigned int size, unsigned int count)
+{
+    return cglist_push_many((cl_list_t *)list, CL_OBJ_LIST, contents, size,
+                            count, CL_OBJ_LIST_NODE, true);
+}
+
+__PUB_API__ int cl_list_splice(cl_list_t *list, cl_list_t *other)
+{
+    return cglist_splice((cl_list_t *)list, CL_OBJ_LIST, (cl_list_t *)other);
+}
+
 __PUB_API__ cl_list_node_t *cl_list_map(const cl_list_t *list,
     int (*foo)(cl_list_node_t *, void *), void *data)
 {
@@ -205,6 +226,20 @@ __PUB_API__ int cl_list_set_equals(const cl_list_t *list,
     return cglist_set_equals((cl_list_t *)list, CL_OBJ_LIST, equals);
 }
 
+__PUB_API__ int cl_list_set_sort_threshold(const cl_list_t *list,
+    unsigned int threshold)
+{
+    return cglist_set_sort_threshold((cl_list_t *)list, CL_OBJ_LIST,
+                                     threshold);
+}
+
+__PUB_API__ int cl_list_set_bloom_filter(const cl_list_t *list, bool enabled,
+    unsigned long long (*hash)(cl_list_node_t *))
+{
+    return cglist_set_bloom_filter((cl_list_t *)list, CL_OBJ_LIST, enabled,
+                                   hash);
+}
+
 __PUB_API__ cl_list_node_t *cl_list_middle(const cl_list_t *list)
 {
     return (cl_list_node_t *)cglist_middle((cl_list_t *)list, CL_OBJ_LIST);
@@ -215,3 +250,39 @@ __PUB_API__ int cl_list_rotate(cl_list_t *list, unsigned int n)
     return cglist_rotate(list, CL_OBJ_LIST, n);
 }
 
+__PUB_API__ int cl_list_pool_stats(const cl_list_t *list,
+    struct cl_list_pool_stats_s *stats)
+{
+    return cglist_pool_stats(list, CL_OBJ_LIST, stats);
+}
+
+__PUB_API__ cl_list_iter_t *cl_list_iter_begin(const cl_list_t *list)
+{
+    return cglist_iter_begin(list, CL_OBJ_LIST, CL_OBJ_LIST_ITER);
+}
+
+__PUB_API__ int cl_list_iter_end(cl_list_iter_t *iter)
+{
+    return cglist_iter_end(iter, CL_OBJ_LIST_ITER);
+}
+
+__PUB_API__ cl_list_node_t *cl_list_iter_next(cl_list_iter_t *iter)
+{
+    return cglist_iter_next(iter, CL_OBJ_LIST_ITER, true);
+}
+
+__PUB_API__ cl_list_node_t *cl_list_iter_prev(cl_list_iter_t *iter)
+{
+    return cglist_iter_next(iter, CL_OBJ_LIST_ITER, false);
+}
+
+__PUB_API__ void *cl_list_iter_content(const cl_list_iter_t *iter)
+{
+    return cglist_iter_content(iter, CL_OBJ_LIST_ITER);
+}
+
+__PUB_API__ cl_list_node_t *cl_list_iter_retain(const cl_list_iter_t *iter)
+{
+    return cglist_iter_retain(iter, CL_OBJ_LIST_ITER, CL_OBJ_LIST_NODE);
+}
+
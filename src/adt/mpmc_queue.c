@@ -0,0 +1,564 @@
+
+/*
+ * Description: A bounded queue shared between several producer and consumer
+ *              threads.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 16:12:40 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <pthread.h>
+
+#include "collections.h"
+
+/*
+ * The queue is a ring of slots, each one with a sequence number telling
+ * whose turn it is to use it (Dmitry Vyukov's bounded MPMC queue). A
+ * producer claims the position @tail by advancing it with a CAS, once the
+ * slot sequence says it is empty for this lap, and publishes its element by
+ * setting the sequence to the position plus one. A consumer does the same
+ * with @head and hands the slot to the producer of the next lap.
+ *
+ * Threads only wait inside the blocking functions. They announce themselves
+ * in a waiting counter before sleeping, so the other side only takes the
+ * lock to wake them up when there is someone to be woken up.
+ */
+
+#define MPMC_QUEUE_CACHE_LINE           64
+
+/* How many times a blocking call retries before going to sleep */
+#define MPMC_QUEUE_SPIN                 64
+
+struct mpmc_slot {
+    unsigned long       sequence;
+    void                *content;
+    unsigned int        content_size;
+};
+
+/* Keeps each cursor in its own cache line */
+struct mpmc_cursor {
+    unsigned long       pos;
+} __attribute__((aligned(MPMC_QUEUE_CACHE_LINE)));
+
+#define cl_mpmc_queue_members                                   \
+    cl_struct_member(struct mpmc_cursor, tail)                  \
+    cl_struct_member(struct mpmc_cursor, head)                  \
+    cl_struct_member(struct mpmc_slot *, slots)                 \
+    cl_struct_member(unsigned long, mask)                       \
+    cl_struct_member(void, (*free_data)(void *))                \
+    cl_struct_member(pthread_mutex_t, lock)                     \
+    cl_struct_member(pthread_cond_t, not_empty)                 \
+    cl_struct_member(pthread_cond_t, not_full)                  \
+    cl_struct_member(unsigned int, waiting_consumers)           \
+    cl_struct_member(unsigned int, waiting_producers)           \
+    cl_struct_member(struct cl_ref_s, ref)
+
+cl_struct_declare(mpmc_queue_s, cl_mpmc_queue_members);
+
+#define mpmc_queue_s        cl_struct(mpmc_queue_s)
+
+/*
+ * Releases an element left inside the queue, the same way a list node
+ * releases its content.
+ */
+static void release_content(mpmc_queue_s *q, struct mpmc_slot *slot)
+{
+    if (q->free_data != NULL)
+        (q->free_data)(slot->content);
+    else if (slot->content_size < CL_OBJECT_HEADER_ID_SIZE)
+        free(slot->content);
+    else if (typeof_validate_object(slot->content, CL_OBJ_OBJECT) == true)
+        cl_object_destroy(slot->content);
+}
+
+static void destroy_mpmc_queue_s(const struct cl_ref_s *ref)
+{
+    mpmc_queue_s *q = cl_container_of(ref, mpmc_queue_s, ref);
+    struct mpmc_slot *slot;
+    unsigned long pos;
+
+    if (NULL == q)
+        return;
+
+    if (q->slots != NULL) {
+        for (pos = q->head.pos; pos != q->tail.pos; pos++) {
+            slot = &q->slots[pos & q->mask];
+
+            if (slot->sequence == pos + 1)
+                release_content(q, slot);
+        }
+
+        free(q->slots);
+    }
+
+    pthread_cond_destroy(&q->not_full);
+    pthread_cond_destroy(&q->not_empty);
+    pthread_mutex_destroy(&q->lock);
+    free(q);
+    q = NULL;
+}
+
+static mpmc_queue_s *new_mpmc_queue_s(unsigned int capacity,
+    void (*free_data)(void *))
+{
+    mpmc_queue_s *q = NULL;
+    unsigned long i, size = 2;
+
+    if (posix_memalign((void **)&q, MPMC_QUEUE_CACHE_LINE,
+                       sizeof(mpmc_queue_s)) != 0)
+    {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    memset(q, 0, sizeof(mpmc_queue_s));
+
+    while (size < capacity)
+        size <<= 1;
+
+    q->slots = calloc(size, sizeof(struct mpmc_slot));
+
+    if (NULL == q->slots) {
+        free(q);
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    for (i = 0; i < size; i++)
+        q->slots[i].sequence = i;
+
+    q->mask = size - 1;
+    q->free_data = free_data;
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->not_empty, NULL);
+    pthread_cond_init(&q->not_full, NULL);
+    typeof_set(CL_OBJ_MPMC_QUEUE, q);
+
+    /* Reference count */
+    q->ref.count = 1;
+    q->ref.free = destroy_mpmc_queue_s;
+
+    return q;
+}
+
+/*
+ * Claims up to @count consecutive slots from the cursor @c whose sequence
+ * must be its position plus @offset, 0 for producers and 1 for consumers.
+ * Returns how many were claimed, starting at @pos.
+ */
+static unsigned int claim(mpmc_queue_s *q, struct mpmc_cursor *c,
+    unsigned long offset, unsigned int count, unsigned long *pos)
+{
+    unsigned long p, seq = 0;
+    unsigned int n;
+    long dif;
+
+    p = __atomic_load_n(&c->pos, __ATOMIC_RELAXED);
+
+    while (1) {
+        for (n = 0; n < count; n++) {
+            seq = __atomic_load_n(&q->slots[(p + n) & q->mask].sequence,
+                                  __ATOMIC_ACQUIRE);
+
+            if (seq != p + n + offset)
+                break;
+        }
+
+        if (n == 0) {
+            dif = (long)(seq - (p + offset));
+
+            /* Full (or empty) ring */
+            if (dif < 0)
+                return 0;
+
+            /* Someone else took the position, start again from the new one */
+            p = __atomic_load_n(&c->pos, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        if (__atomic_compare_exchange_n(&c->pos, &p, p + n, true,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+    }
+
+    *pos = p;
+
+    return n;
+}
+
+/*
+ * Wakes up threads sleeping on @cond, if there is any. Must be called after
+ * the slots have been handed to them.
+ */
+static void wake_up(mpmc_queue_s *q, unsigned int *waiting,
+    pthread_cond_t *cond, bool all)
+{
+    /* Pairs with the fence of wait_for() */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(waiting, __ATOMIC_RELAXED) == 0)
+        return;
+
+    pthread_mutex_lock(&q->lock);
+
+    if (all == true)
+        pthread_cond_broadcast(cond);
+    else
+        pthread_cond_signal(cond);
+
+    pthread_mutex_unlock(&q->lock);
+}
+
+static unsigned int push(mpmc_queue_s *q, void **contents, unsigned int size,
+    unsigned int count)
+{
+    struct mpmc_slot *slot;
+    unsigned long pos;
+    unsigned int i, n;
+
+    n = claim(q, &q->tail, 0, count, &pos);
+
+    for (i = 0; i < n; i++) {
+        slot = &q->slots[(pos + i) & q->mask];
+        slot->content = contents[i];
+        slot->content_size = size;
+        __atomic_store_n(&slot->sequence, pos + i + 1, __ATOMIC_RELEASE);
+    }
+
+    return n;
+}
+
+static unsigned int pop(mpmc_queue_s *q, void **contents, unsigned int count)
+{
+    struct mpmc_slot *slot;
+    unsigned long pos;
+    unsigned int i, n;
+
+    n = claim(q, &q->head, 1, count, &pos);
+
+    for (i = 0; i < n; i++) {
+        slot = &q->slots[(pos + i) & q->mask];
+        contents[i] = slot->content;
+        __atomic_store_n(&slot->sequence, pos + i + q->mask + 1,
+                         __ATOMIC_RELEASE);
+    }
+
+    return n;
+}
+
+static unsigned int produce(mpmc_queue_s *q, void **contents,
+    unsigned int size, unsigned int count)
+{
+    unsigned int n;
+
+    n = push(q, contents, size, count);
+
+    if (n > 0)
+        wake_up(q, &q->waiting_consumers, &q->not_empty, n > 1);
+
+    return n;
+}
+
+static unsigned int consume(mpmc_queue_s *q, void **contents,
+    unsigned int count)
+{
+    unsigned int n;
+
+    n = pop(q, contents, count);
+
+    if (n > 0)
+        wake_up(q, &q->waiting_producers, &q->not_full, n > 1);
+
+    return n;
+}
+
+/*
+ * Keeps trying to push (@producer is true) or to pop elements, sleeping
+ * between attempts once spinning did not help. Returns how many elements
+ * were moved, at least one.
+ */
+static unsigned int wait_for(mpmc_queue_s *q, bool producer, void **contents,
+    unsigned int size, unsigned int count)
+{
+    unsigned int *waiting, n, i;
+    pthread_cond_t *cond;
+
+    if (producer == true) {
+        waiting = &q->waiting_producers;
+        cond = &q->not_full;
+    } else {
+        waiting = &q->waiting_consumers;
+        cond = &q->not_empty;
+    }
+
+    while (1) {
+        for (i = 0; i < MPMC_QUEUE_SPIN; i++) {
+            n = (producer == true) ? produce(q, contents, size, count)
+                                   : consume(q, contents, count);
+
+            if (n > 0)
+                return n;
+        }
+
+        pthread_mutex_lock(&q->lock);
+        __atomic_add_fetch(waiting, 1, __ATOMIC_RELAXED);
+
+        /* Pairs with the fence of wake_up() */
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        n = (producer == true) ? push(q, contents, size, count)
+                               : pop(q, contents, count);
+
+        if (n == 0)
+            pthread_cond_wait(cond, &q->lock);
+
+        __atomic_sub_fetch(waiting, 1, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&q->lock);
+
+        /* The other side is woken up only now, without holding the lock */
+        if (n > 0) {
+            if (producer == true)
+                wake_up(q, &q->waiting_consumers, &q->not_empty, n > 1);
+            else
+                wake_up(q, &q->waiting_producers, &q->not_full, n > 1);
+
+            return n;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ *
+ * API
+ *
+ */
+
+__PUB_API__ cl_mpmc_queue_t *cl_mpmc_queue_ref(cl_mpmc_queue_t *queue)
+{
+    mpmc_queue_s *q = (mpmc_queue_s *)queue;
+
+    __clib_function_init__(true, queue, CL_OBJ_MPMC_QUEUE, NULL);
+    cl_ref_inc(&q->ref);
+
+    return queue;
+}
+
+__PUB_API__ int cl_mpmc_queue_unref(cl_mpmc_queue_t *queue)
+{
+    mpmc_queue_s *q = (mpmc_queue_s *)queue;
+
+    __clib_function_init__(true, queue, CL_OBJ_MPMC_QUEUE, -1);
+    cl_ref_dec(&q->ref);
+
+    return 0;
+}
+
+__PUB_API__ cl_mpmc_queue_t *cl_mpmc_queue_create(unsigned int capacity,
+    void (*free_data)(void *))
+{
+    __clib_function_init__(false, NULL, -1, NULL);
+
+    if ((capacity == 0) || (capacity > (1U << 31))) {
+        cset_errno(CL_INVALID_VALUE);
+        return NULL;
+    }
+
+    return new_mpmc_queue_s(capacity, free_data);
+}
+
+__PUB_API__ int cl_mpmc_queue_destroy(cl_mpmc_queue_t *queue)
+{
+    return cl_mpmc_queue_unref(queue);
+}
+
+__PUB_API__ bool cl_mpmc_queue_try_enqueue(cl_mpmc_queue_t *queue,
+    const void *node_content, unsigned int size)
+{
+    mpmc_queue_s *q = (mpmc_queue_s *)queue;
+    void *content = (void *)node_content;
+
+    __clib_function_init__(true, queue, CL_OBJ_MPMC_QUEUE, false);
+
+    if (NULL == node_content) {
+        cset_errno(CL_NULL_ARG);
+        return false;
+    }
+
+    return (produce(q, &content, size, 1) == 1) ? true : false;
+}
+
+__PUB_API__ int cl_mpmc_queue_enqueue(cl_mpmc_queue_t *queue,
+    const void *node_content, unsigned int size)
+{
+    mpmc_queue_s *q = (mpmc_queue_s *)queue;
+    void *content = (void *)node_content;
+
+    __clib_function_init__(true, queue, CL_OBJ_MPMC_QUEUE, -1);
+
+    if (NULL == node_content) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    wait_for(q, true, &content, size, 1);
+
+    return 0;
+}
+
+__PUB_API__ void *cl_mpmc_queue_try_dequeue(cl_mpmc_queue_t *queue)
+{
+    mpmc_queue_s *q = (mpmc_queue_s *)queue;
+    void *content = NULL;
+
+    __clib_function_init__(true, queue, CL_OBJ_MPMC_QUEUE, NULL);
+    consume(q, &content, 1);
+
+    return content;
+}
+
+__PUB_API__ void *cl_mpmc_queue_dequeue(cl_mpmc_queue_t *queue)
+{
+    mpmc_queue_s *q = (mpmc_queue_s *)queue;
+    void *content = NULL;
+
+    __clib_function_init__(true, queue, CL_OBJ_MPMC_QUEUE, NULL);
+    wait_for(q, false, &content, 0, 1);
+
+    return content;
+}
+
+__PUB_API__ int cl_mpmc_queue_try_enqueue_batch(cl_mpmc_queue_t *queue,
+    void **contents, unsigned int size, unsigned int count)
+{
+    mpmc_queue_s *q = (mpmc_queue_s *)queue;
+    unsigned int i;
+
+    __clib_function_init__(true, queue, CL_OBJ_MPMC_QUEUE, -1);
+
+    if (NULL == contents) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (NULL == contents[i]) {
+            cset_errno(CL_NULL_DATA);
+            return -1;
+        }
+    }
+
+    if (count == 0)
+        return 0;
+
+    return produce(q, contents, size, count);
+}
+
+__PUB_API__ int cl_mpmc_queue_enqueue_batch(cl_mpmc_queue_t *queue,
+    void **contents, unsigned int size, unsigned int count)
+{
+    mpmc_queue_s *q = (mpmc_queue_s *)queue;
+    unsigned int i;
+
+    __clib_function_init__(true, queue, CL_OBJ_MPMC_QUEUE, -1);
+
+    if (NULL == contents) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    for (i = 0; i < count; i++) {
+        if (NULL == contents[i]) {
+            cset_errno(CL_NULL_DATA);
+            return -1;
+        }
+    }
+
+    for (i = 0; i < count; )
+        i += wait_for(q, true, contents + i, size, count - i);
+
+    return 0;
+}
+
+__PUB_API__ int cl_mpmc_queue_try_dequeue_batch(cl_mpmc_queue_t *queue,
+    void **contents, unsigned int count)
+{
+    mpmc_queue_s *q = (mpmc_queue_s *)queue;
+
+    __clib_function_init__(true, queue, CL_OBJ_MPMC_QUEUE, -1);
+
+    if (NULL == contents) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    if (count == 0)
+        return 0;
+
+    return consume(q, contents, count);
+}
+
+__PUB_API__ int cl_mpmc_queue_dequeue_batch(cl_mpmc_queue_t *queue,
+    void **contents, unsigned int count)
+{
+    mpmc_queue_s *q = (mpmc_queue_s *)queue;
+
+    __clib_function_init__(true, queue, CL_OBJ_MPMC_QUEUE, -1);
+
+    if (NULL == contents) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    if (count == 0) {
+        cset_errno(CL_INVALID_VALUE);
+        return -1;
+    }
+
+    return wait_for(q, false, contents, 0, count);
+}
+
+__PUB_API__ int cl_mpmc_queue_size(cl_mpmc_queue_t *queue)
+{
+    mpmc_queue_s *q = (mpmc_queue_s *)queue;
+    unsigned long head, tail;
+
+    __clib_function_init__(true, queue, CL_OBJ_MPMC_QUEUE, -1);
+    head = __atomic_load_n(&q->head.pos, __ATOMIC_RELAXED);
+    tail = __atomic_load_n(&q->tail.pos, __ATOMIC_RELAXED);
+
+    /* Both are read apart, so the head may be already ahead */
+    if ((long)(tail - head) < 0)
+        return 0;
+
+    return (int)(tail - head);
+}
+
+__PUB_API__ bool cl_mpmc_queue_is_empty(cl_mpmc_queue_t *queue)
+{
+    return (cl_mpmc_queue_size(queue) == 0) ? true : false;
+}
+
@@ -0,0 +1,664 @@
+
+/*
+ * Description: Maps with ordered keys, kept inside a skip list.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 20:31:06 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <pthread.h>
+
+#include "collections.h"
+
+/*
+ * Every node is promoted to the next level with a 1/4 probability, so 16
+ * levels are enough for about 4 billion keys.
+ */
+#define ORDMAP_MAX_LEVEL            16
+
+/*
+ * Nodes only point backwards at the lowest level, which is enough to walk
+ * a range in reverse.
+ */
+struct onode {
+    void            *key;
+    void            *value;
+    struct onode    *prev;
+    unsigned int    level;
+    struct onode    *next[];
+};
+
+#define cl_ordmap_members                                           \
+    cl_struct_member(struct onode *, head)                          \
+    cl_struct_member(struct onode *, tail)                          \
+    cl_struct_member(unsigned int, level)                           \
+    cl_struct_member(unsigned int, size)                            \
+    cl_struct_member(uint32_t, seed)                                \
+    cl_struct_member(int, (*compare_to)(const void *, const void *))\
+    cl_struct_member(void, (*free_key)(void *))                     \
+    cl_struct_member(void, (*free_value)(void *))                   \
+    cl_struct_member(bool, thread_safe)                             \
+    cl_struct_member(pthread_rwlock_t, lock)                        \
+    cl_struct_member(struct cl_ref_s, ref)
+
+cl_struct_declare(ordmap_s, cl_ordmap_members);
+
+#define ordmap_s        cl_struct(ordmap_s)
+
+static void read_lock(ordmap_s *m)
+{
+    if (m->thread_safe)
+        pthread_rwlock_rdlock(&m->lock);
+}
+
+static void write_lock(ordmap_s *m)
+{
+    if (m->thread_safe)
+        pthread_rwlock_wrlock(&m->lock);
+}
+
+static void unlock(ordmap_s *m)
+{
+    if (m->thread_safe)
+        pthread_rwlock_unlock(&m->lock);
+}
+
+static struct onode *new_node(unsigned int level, void *key, void *value)
+{
+    struct onode *n;
+
+    n = calloc(1, sizeof(struct onode) + level * sizeof(struct onode *));
+
+    if (NULL == n) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    n->key = key;
+    n->value = value;
+    n->level = level;
+
+    return n;
+}
+
+static void release_node(const ordmap_s *m, struct onode *n)
+{
+    if (m->free_key != NULL)
+        (m->free_key)(n->key);
+
+    if (m->free_value != NULL)
+        (m->free_value)(n->value);
+
+    free(n);
+}
+
+/* Only called while holding the write lock, so the seed needs no care */
+static unsigned int random_level(ordmap_s *m)
+{
+    uint32_t x = m->seed;
+    unsigned int level = 1;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    m->seed = x;
+
+    while (((x & 3) == 0) && (level < ORDMAP_MAX_LEVEL)) {
+        level++;
+        x >>= 2;
+    }
+
+    return level;
+}
+
+/*
+ * Finds the last node whose key is lower than @key, or lower than or equal
+ * to it if @inclusive is true. Returns the head when there is none. When
+ * @update is given it receives the last node visited at every level, which
+ * are the ones to be changed to insert or remove a node.
+ */
+static struct onode *last_before(const ordmap_s *m, const void *key,
+    bool inclusive, struct onode **update)
+{
+    struct onode *x = m->head, *next;
+    int i, c;
+
+    for (i = m->level - 1; i >= 0; i--) {
+        while ((next = x->next[i]) != NULL) {
+            c = (m->compare_to)(next->key, key);
+
+            if ((c > 0) || ((c == 0) && !inclusive))
+                break;
+
+            x = next;
+        }
+
+        if (update != NULL)
+            update[i] = x;
+    }
+
+    return x;
+}
+
+static struct onode *find_node(const ordmap_s *m, const void *key)
+{
+    struct onode *n;
+
+    n = last_before(m, key, false, NULL)->next[0];
+
+    if ((n != NULL) && ((m->compare_to)(n->key, key) == 0))
+        return n;
+
+    return NULL;
+}
+
+static int insert_node(ordmap_s *m, void *key, void *value)
+{
+    struct onode *update[ORDMAP_MAX_LEVEL], *n;
+    unsigned int i, level;
+
+    n = last_before(m, key, false, update)->next[0];
+
+    if ((n != NULL) && ((m->compare_to)(n->key, key) == 0)) {
+        /* Putting the stored pointers again must not release them */
+        if ((m->free_key != NULL) && (key != n->key))
+            (m->free_key)(key);
+
+        if ((m->free_value != NULL) && (value != n->value))
+            (m->free_value)(n->value);
+
+        n->value = value;
+
+        return 0;
+    }
+
+    level = random_level(m);
+    n = new_node(level, key, value);
+
+    if (NULL == n)
+        return -1;
+
+    for (i = m->level; i < level; i++)
+        update[i] = m->head;
+
+    if (level > m->level)
+        m->level = level;
+
+    for (i = 0; i < level; i++) {
+        n->next[i] = update[i]->next[i];
+        update[i]->next[i] = n;
+    }
+
+    n->prev = (update[0] == m->head) ? NULL : update[0];
+
+    if (n->next[0] != NULL)
+        n->next[0]->prev = n;
+    else
+        m->tail = n;
+
+    m->size++;
+
+    return 0;
+}
+
+static int delete_node(ordmap_s *m, const void *key)
+{
+    struct onode *update[ORDMAP_MAX_LEVEL], *n;
+    unsigned int i;
+
+    n = last_before(m, key, false, update)->next[0];
+
+    if ((NULL == n) || ((m->compare_to)(n->key, key) != 0)) {
+        cset_errno(CL_OBJECT_NOT_FOUND);
+        return -1;
+    }
+
+    for (i = 0; i < n->level; i++)
+        update[i]->next[i] = n->next[i];
+
+    if (n->next[0] != NULL)
+        n->next[0]->prev = n->prev;
+    else
+        m->tail = n->prev;
+
+    while ((m->level > 1) && (NULL == m->head->next[m->level - 1]))
+        m->level--;
+
+    m->size--;
+    release_node(m, n);
+
+    return 0;
+}
+
+/* Finds the node a lookup of the kind @seek is after */
+static struct onode *seek_node(const ordmap_s *m, const void *key,
+    enum cl_ordmap_seek seek)
+{
+    struct onode *n;
+
+    switch (seek) {
+        case CL_ORDMAP_FLOOR:
+            n = last_before(m, key, true, NULL);
+            return (n == m->head) ? NULL : n;
+
+        case CL_ORDMAP_CEILING:
+            return last_before(m, key, false, NULL)->next[0];
+
+        case CL_ORDMAP_FIRST:
+            return m->head->next[0];
+
+        case CL_ORDMAP_LAST:
+            return m->tail;
+
+        default:
+            return find_node(m, key);
+    }
+}
+
+/* Fills the optional output value and gives back the node key */
+static const void *node_entry(const struct onode *n, void **value)
+{
+    if (NULL == n) {
+        cset_errno(CL_OBJECT_NOT_FOUND);
+        return NULL;
+    }
+
+    if (value != NULL)
+        *value = n->value;
+
+    return n->key;
+}
+
+static const void *map_forward(const ordmap_s *m, const void *from,
+    const void *to, int (*foo)(const void *, void *, void *), void *data)
+{
+    struct onode *n;
+
+    n = (NULL == from) ? m->head->next[0]
+                       : last_before(m, from, false, NULL)->next[0];
+
+    for (; n != NULL; n = n->next[0]) {
+        if ((to != NULL) && ((m->compare_to)(n->key, to) > 0))
+            break;
+
+        if (foo(n->key, n->value, data) != 0)
+            return n->key;
+    }
+
+    return NULL;
+}
+
+static const void *map_backward(const ordmap_s *m, const void *from,
+    const void *to, int (*foo)(const void *, void *, void *), void *data)
+{
+    struct onode *n;
+
+    if (NULL == to)
+        n = m->tail;
+    else {
+        n = last_before(m, to, true, NULL);
+
+        if (n == m->head)
+            n = NULL;
+    }
+
+    for (; n != NULL; n = n->prev) {
+        if ((from != NULL) && ((m->compare_to)(n->key, from) < 0))
+            break;
+
+        if (foo(n->key, n->value, data) != 0)
+            return n->key;
+    }
+
+    return NULL;
+}
+
+static void destroy_ordmap(const struct cl_ref_s *ref)
+{
+    ordmap_s *m = cl_container_of(ref, ordmap_s, ref);
+    struct onode *n, *next;
+
+    if (NULL == m)
+        return;
+
+    for (n = m->head->next[0]; n != NULL; n = next) {
+        next = n->next[0];
+        release_node(m, n);
+    }
+
+    free(m->head);
+    pthread_rwlock_destroy(&m->lock);
+    free(m);
+    m = NULL;
+}
+
+static ordmap_s *new_ordmap(int (*compare_to)(const void *, const void *),
+    void (*free_key)(void *), void (*free_value)(void *), bool thread_safe)
+{
+    ordmap_s *m = NULL;
+
+    m = calloc(1, sizeof(ordmap_s));
+
+    if (NULL == m) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    m->head = new_node(ORDMAP_MAX_LEVEL, NULL, NULL);
+
+    if (NULL == m->head) {
+        free(m);
+        return NULL;
+    }
+
+    m->level = 1;
+    m->seed = (uint32_t)time(NULL) ^ (uint32_t)(uintptr_t)m;
+
+    if (0 == m->seed)
+        m->seed = 1;
+
+    m->compare_to = compare_to;
+    m->free_key = free_key;
+    m->free_value = free_value;
+    m->thread_safe = thread_safe;
+    pthread_rwlock_init(&m->lock, NULL);
+    typeof_set(CL_OBJ_ORDMAP, m);
+
+    m->ref.free = destroy_ordmap;
+    m->ref.count = 1;
+
+    return m;
+}
+
+/*
+ *
+ * API
+ *
+ */
+
+__PUB_API__ cl_ordmap_t *cl_ordmap_ref(cl_ordmap_t *map)
+{
+    ordmap_s *m = (ordmap_s *)map;
+
+    __clib_function_init__(true, map, CL_OBJ_ORDMAP, NULL);
+    cl_ref_inc(&m->ref);
+
+    return map;
+}
+
+__PUB_API__ int cl_ordmap_unref(cl_ordmap_t *map)
+{
+    ordmap_s *m = (ordmap_s *)map;
+
+    __clib_function_init__(true, map, CL_OBJ_ORDMAP, -1);
+    cl_ref_dec(&m->ref);
+
+    return 0;
+}
+
+__PUB_API__ cl_ordmap_t *cl_ordmap_create(int (*compare_to)(const void *,
+                                                            const void *),
+    void (*free_key)(void *), void (*free_value)(void *), bool thread_safe)
+{
+    __clib_function_init__(false, NULL, -1, NULL);
+
+    if (NULL == compare_to) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    return new_ordmap(compare_to, free_key, free_value, thread_safe);
+}
+
+__PUB_API__ int cl_ordmap_destroy(cl_ordmap_t *map)
+{
+    return cl_ordmap_unref(map);
+}
+
+__PUB_API__ int cl_ordmap_put(cl_ordmap_t *map, void *key, void *value)
+{
+    ordmap_s *m = (ordmap_s *)map;
+    int ret;
+
+    __clib_function_init__(true, map, CL_OBJ_ORDMAP, -1);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    write_lock(m);
+    ret = insert_node(m, key, value);
+    unlock(m);
+
+    return ret;
+}
+
+__PUB_API__ void *cl_ordmap_get(cl_ordmap_t *map, const void *key)
+{
+    ordmap_s *m = (ordmap_s *)map;
+    struct onode *n;
+    void *value = NULL;
+
+    __clib_function_init__(true, map, CL_OBJ_ORDMAP, NULL);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    read_lock(m);
+    n = find_node(m, key);
+
+    if (n != NULL)
+        value = n->value;
+    else
+        cset_errno(CL_OBJECT_NOT_FOUND);
+
+    unlock(m);
+
+    return value;
+}
+
+__PUB_API__ int cl_ordmap_delete(cl_ordmap_t *map, const void *key)
+{
+    ordmap_s *m = (ordmap_s *)map;
+    int ret;
+
+    __clib_function_init__(true, map, CL_OBJ_ORDMAP, -1);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    write_lock(m);
+    ret = delete_node(m, key);
+    unlock(m);
+
+    return ret;
+}
+
+__PUB_API__ bool cl_ordmap_contains_key(cl_ordmap_t *map, const void *key)
+{
+    ordmap_s *m = (ordmap_s *)map;
+    bool ret;
+
+    __clib_function_init__(true, map, CL_OBJ_ORDMAP, false);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return false;
+    }
+
+    read_lock(m);
+    ret = (find_node(m, key) != NULL);
+    unlock(m);
+
+    return ret;
+}
+
+__PUB_API__ int cl_ordmap_size(cl_ordmap_t *map)
+{
+    ordmap_s *m = (ordmap_s *)map;
+    int size;
+
+    __clib_function_init__(true, map, CL_OBJ_ORDMAP, -1);
+    read_lock(m);
+    size = m->size;
+    unlock(m);
+
+    return size;
+}
+
+__PUB_API__ bool cl_ordmap_is_empty(cl_ordmap_t *map)
+{
+    return (cl_ordmap_size(map) > 0) ? false : true;
+}
+
+__PUB_API__ const void *cl_ordmap_floor(cl_ordmap_t *map, const void *key,
+    void **value)
+{
+    ordmap_s *m = (ordmap_s *)map;
+    const void *k;
+
+    __clib_function_init__(true, map, CL_OBJ_ORDMAP, NULL);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    read_lock(m);
+    k = node_entry(seek_node(m, key, CL_ORDMAP_FLOOR), value);
+    unlock(m);
+
+    return k;
+}
+
+__PUB_API__ const void *cl_ordmap_ceiling(cl_ordmap_t *map, const void *key,
+    void **value)
+{
+    ordmap_s *m = (ordmap_s *)map;
+    const void *k;
+
+    __clib_function_init__(true, map, CL_OBJ_ORDMAP, NULL);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    read_lock(m);
+    k = node_entry(seek_node(m, key, CL_ORDMAP_CEILING), value);
+    unlock(m);
+
+    return k;
+}
+
+__PUB_API__ const void *cl_ordmap_first(cl_ordmap_t *map, void **value)
+{
+    ordmap_s *m = (ordmap_s *)map;
+    const void *k;
+
+    __clib_function_init__(true, map, CL_OBJ_ORDMAP, NULL);
+    read_lock(m);
+    k = node_entry(seek_node(m, NULL, CL_ORDMAP_FIRST), value);
+    unlock(m);
+
+    return k;
+}
+
+__PUB_API__ const void *cl_ordmap_last(cl_ordmap_t *map, void **value)
+{
+    ordmap_s *m = (ordmap_s *)map;
+    const void *k;
+
+    __clib_function_init__(true, map, CL_OBJ_ORDMAP, NULL);
+    read_lock(m);
+    k = node_entry(seek_node(m, NULL, CL_ORDMAP_LAST), value);
+    unlock(m);
+
+    return k;
+}
+
+__PUB_API__ const void *cl_ordmap_map_range(cl_ordmap_t *map,
+    const void *from, const void *to, bool reverse,
+    int (*foo)(const void *, void *, void *), void *data)
+{
+    ordmap_s *m = (ordmap_s *)map;
+    const void *k;
+
+    __clib_function_init__(true, map, CL_OBJ_ORDMAP, NULL);
+
+    if (NULL == foo) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    read_lock(m);
+    k = reverse ? map_backward(m, from, to, foo, data)
+                : map_forward(m, from, to, foo, data);
+
+    unlock(m);
+
+    return k;
+}
+
+__PUB_API__ int cl_ordmap_visit(cl_ordmap_t *map, const void *key,
+    enum cl_ordmap_seek seek, void (*foo)(const void *, void *, void *),
+    void *data)
+{
+    ordmap_s *m = (ordmap_s *)map;
+    struct onode *n;
+
+    __clib_function_init__(true, map, CL_OBJ_ORDMAP, -1);
+
+    if ((NULL == foo) ||
+        ((NULL == key) && (seek != CL_ORDMAP_FIRST) &&
+         (seek != CL_ORDMAP_LAST)))
+    {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    if (seek > CL_ORDMAP_LAST) {
+        cset_errno(CL_INVALID_VALUE);
+        return -1;
+    }
+
+    read_lock(m);
+    n = seek_node(m, key, seek);
+
+    if (n != NULL)
+        foo(n->key, n->value, data);
+    else
+        cset_errno(CL_OBJECT_NOT_FOUND);
+
+    unlock(m);
+
+    return (NULL == n) ? -1 : 0;
+}
+
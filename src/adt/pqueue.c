@@ -0,0 +1,570 @@
+
+/*
+ * Description: Priority queues kept inside d-ary heaps.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 21:14:27 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdlib.h>
+
+#include <pthread.h>
+
+#include "collections.h"
+
+/* Children of every element when the user doesn't choose */
+#define PQUEUE_DEFAULT_ARITY            4
+
+/* Room allocated by the first insertion */
+#define PQUEUE_INITIAL_CAPACITY         16
+
+/*
+ * The handle given back by a push. It follows its element around the heap
+ * so it can be found again without a search. The queue holds a reference
+ * to it while the element is inside, and the user another one, so a handle
+ * whose element already left, with @owner cleared, is still safe to look
+ * at.
+ */
+struct phandle {
+    struct cl_object_hdr    hdr;
+    unsigned int            index;
+    const void              *owner;
+    struct cl_ref_s         ref;
+};
+
+/*
+ * The heap holds the list nodes themselves, so the user compare_to sees
+ * the same objects it sees inside a list. Elements moved from a list have
+ * no handle.
+ */
+struct pentry {
+    void                    *node;
+    struct phandle          *handle;
+};
+
+#define cl_pqueue_members                                   \
+    cl_struct_member(struct pentry *, heap)                 \
+    cl_struct_member(unsigned int, size)                    \
+    cl_struct_member(unsigned int, capacity)                \
+    cl_struct_member(unsigned int, arity)                   \
+    cl_struct_member(void, (*free_data)(void *))            \
+    cl_struct_member(int, (*compare_to)(void *, void *))    \
+    cl_struct_member(bool, thread_safe)                     \
+    cl_struct_member(pthread_mutex_t, lock)                 \
+    cl_struct_member(struct cl_ref_s, ref)
+
+cl_struct_declare(pqueue_s, cl_pqueue_members);
+
+#define pqueue_s        cl_struct(pqueue_s)
+
+static void lock(pqueue_s *q)
+{
+    if (q->thread_safe)
+        pthread_mutex_lock(&q->lock);
+}
+
+static void unlock(pqueue_s *q)
+{
+    if (q->thread_safe)
+        pthread_mutex_unlock(&q->lock);
+}
+
+static inline void place(pqueue_s *q, unsigned int i, struct pentry e)
+{
+    q->heap[i] = e;
+
+    if (e.handle != NULL)
+        e.handle->index = i;
+}
+
+/*
+ * Moves the entry at @i up while it goes out before its parent, carrying a
+ * hole instead of swapping at every level.
+ */
+static void sift_up(pqueue_s *q, unsigned int i)
+{
+    struct pentry e = q->heap[i];
+    unsigned int parent;
+
+    while (i > 0) {
+        parent = (i - 1) / q->arity;
+
+        if ((q->compare_to)(e.node, q->heap[parent].node) >= 0)
+            break;
+
+        place(q, i, q->heap[parent]);
+        i = parent;
+    }
+
+    place(q, i, e);
+}
+
+static void sift_down(pqueue_s *q, unsigned int i)
+{
+    struct pentry e = q->heap[i];
+    unsigned int child, best, last;
+
+    while (1) {
+        child = i * q->arity + 1;
+
+        if (child >= q->size)
+            break;
+
+        last = child + q->arity;
+
+        if (last > q->size)
+            last = q->size;
+
+        for (best = child++; child < last; child++)
+            if ((q->compare_to)(q->heap[child].node, q->heap[best].node) < 0)
+                best = child;
+
+        if ((q->compare_to)(q->heap[best].node, e.node) >= 0)
+            break;
+
+        place(q, i, q->heap[best]);
+        i = best;
+    }
+
+    place(q, i, e);
+}
+
+static int grow(pqueue_s *q, unsigned int capacity)
+{
+    struct pentry *heap;
+    unsigned int n;
+
+    if (capacity <= q->capacity)
+        return 0;
+
+    n = (q->capacity == 0) ? PQUEUE_INITIAL_CAPACITY : q->capacity;
+
+    while ((n < capacity) && (n < (1U << 31)))
+        n <<= 1;
+
+    if (n < capacity)
+        n = capacity;
+
+    heap = realloc(q->heap, (size_t)n * sizeof(struct pentry));
+
+    if (NULL == heap) {
+        cset_errno(CL_NO_MEM);
+        return -1;
+    }
+
+    q->heap = heap;
+    q->capacity = n;
+
+    return 0;
+}
+
+static void destroy_handle(const struct cl_ref_s *ref)
+{
+    struct phandle *h = cl_container_of(ref, struct phandle, ref);
+
+    free(h);
+}
+
+/* Drops the queue reference of a handle whose element left it */
+static void release_handle(struct phandle *h)
+{
+    if (NULL == h)
+        return;
+
+    h->owner = NULL;
+    cl_ref_dec(&h->ref);
+}
+
+/* Takes the entry at @i out of the heap, handing its node to the caller */
+static void *take(pqueue_s *q, unsigned int i)
+{
+    struct pentry e = q->heap[i];
+
+    q->size--;
+
+    if (i < q->size) {
+        place(q, i, q->heap[q->size]);
+
+        if ((i > 0) &&
+            ((q->compare_to)(q->heap[i].node,
+                             q->heap[(i - 1) / q->arity].node) < 0))
+        {
+            sift_up(q, i);
+        } else
+            sift_down(q, i);
+    }
+
+    release_handle(e.handle);
+
+    return e.node;
+}
+
+/* Checks if @handle is a live handle of the queue @q */
+static int validate_handle(const pqueue_s *q, const struct phandle *h)
+{
+    if (NULL == h) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    if (typeof_validate_object(h, CL_OBJ_PQUEUE_NODE) == false) {
+        cset_errno(CL_INVALID_VALUE);
+        return -1;
+    }
+
+    if ((h->owner != q) || (h->index >= q->size) ||
+        (q->heap[h->index].handle != h))
+    {
+        cset_errno(CL_INVALID_VALUE);
+        return -1;
+    }
+
+    return 0;
+}
+
+static void destroy_pqueue(const struct cl_ref_s *ref)
+{
+    pqueue_s *q = cl_container_of(ref, pqueue_s, ref);
+    unsigned int i;
+
+    if (NULL == q)
+        return;
+
+    for (i = 0; i < q->size; i++) {
+        cglist_node_unref(q->heap[i].node, CL_OBJ_LIST_NODE);
+        release_handle(q->heap[i].handle);
+    }
+
+    if (q->heap != NULL)
+        free(q->heap);
+
+    pthread_mutex_destroy(&q->lock);
+    free(q);
+    q = NULL;
+}
+
+static pqueue_s *new_pqueue(unsigned int arity, void (*free_data)(void *),
+    int (*compare_to)(void *, void *), bool thread_safe)
+{
+    pqueue_s *q = NULL;
+
+    q = calloc(1, sizeof(pqueue_s));
+
+    if (NULL == q) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    q->arity = (arity == 0) ? PQUEUE_DEFAULT_ARITY : arity;
+    q->free_data = free_data;
+    q->compare_to = compare_to;
+    q->thread_safe = thread_safe;
+    pthread_mutex_init(&q->lock, NULL);
+    typeof_set(CL_OBJ_PQUEUE, q);
+
+    q->ref.free = destroy_pqueue;
+    q->ref.count = 1;
+
+    return q;
+}
+
+/*
+ * Moves an element whose priority changed to its new place, with the
+ * queue locked. @change, when given, is what changes it.
+ */
+static int update_element(pqueue_s *q, struct phandle *h,
+    void (*change)(cl_list_node_t *, void *), void *data)
+{
+    unsigned int i;
+
+    lock(q);
+
+    if (validate_handle(q, h) < 0) {
+        unlock(q);
+        return -1;
+    }
+
+    i = h->index;
+
+    if (change != NULL)
+        (change)(q->heap[i].node, data);
+
+    sift_up(q, i);
+
+    /* It didn't move up, so it may need to go down */
+    if (h->index == i)
+        sift_down(q, i);
+
+    unlock(q);
+
+    return 0;
+}
+
+/*
+ *
+ * API
+ *
+ */
+
+__PUB_API__ cl_pqueue_t *cl_pqueue_ref(cl_pqueue_t *pqueue)
+{
+    pqueue_s *q = (pqueue_s *)pqueue;
+
+    __clib_function_init__(true, pqueue, CL_OBJ_PQUEUE, NULL);
+    cl_ref_inc(&q->ref);
+
+    return pqueue;
+}
+
+__PUB_API__ int cl_pqueue_unref(cl_pqueue_t *pqueue)
+{
+    pqueue_s *q = (pqueue_s *)pqueue;
+
+    __clib_function_init__(true, pqueue, CL_OBJ_PQUEUE, -1);
+    cl_ref_dec(&q->ref);
+
+    return 0;
+}
+
+__PUB_API__ cl_pqueue_t *cl_pqueue_create(unsigned int arity,
+    void (*free_data)(void *),
+    int (*compare_to)(cl_list_node_t *, cl_list_node_t *), bool thread_safe)
+{
+    __clib_function_init__(false, NULL, -1, NULL);
+
+    if (NULL == compare_to) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    return new_pqueue(arity, free_data, compare_to, thread_safe);
+}
+
+__PUB_API__ int cl_pqueue_destroy(cl_pqueue_t *pqueue)
+{
+    return cl_pqueue_unref(pqueue);
+}
+
+__PUB_API__ cl_pqueue_node_t *cl_pqueue_push(cl_pqueue_t *pqueue,
+    const void *node_content, unsigned int size)
+{
+    pqueue_s *q = (pqueue_s *)pqueue;
+    struct pentry e;
+
+    __clib_function_init__(true, pqueue, CL_OBJ_PQUEUE, NULL);
+
+    if (NULL == node_content) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    e.handle = calloc(1, sizeof(struct phandle));
+
+    if (NULL == e.handle) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    e.node = cglist_node_create(node_content, size, q->free_data,
+                                CL_OBJ_LIST_NODE);
+
+    if (NULL == e.node) {
+        free(e.handle);
+        return NULL;
+    }
+
+    e.handle->owner = q;
+    e.handle->ref.free = destroy_handle;
+    e.handle->ref.count = 2;
+    typeof_set(CL_OBJ_PQUEUE_NODE, e.handle);
+    lock(q);
+
+    if (grow(q, q->size + 1) < 0) {
+        unlock(q);
+        cglist_node_unref(e.node, CL_OBJ_LIST_NODE);
+        free(e.handle);
+        return NULL;
+    }
+
+    q->heap[q->size] = e;
+    sift_up(q, q->size++);
+    unlock(q);
+
+    return e.handle;
+}
+
+__PUB_API__ cl_pqueue_node_t *cl_pqueue_node_ref(cl_pqueue_node_t *handle)
+{
+    struct phandle *h = (struct phandle *)handle;
+
+    __clib_function_init__(true, handle, CL_OBJ_PQUEUE_NODE, NULL);
+    cl_ref_inc(&h->ref);
+
+    return handle;
+}
+
+__PUB_API__ int cl_pqueue_node_unref(cl_pqueue_node_t *handle)
+{
+    struct phandle *h = (struct phandle *)handle;
+
+    __clib_function_init__(true, handle, CL_OBJ_PQUEUE_NODE, -1);
+    cl_ref_dec(&h->ref);
+
+    return 0;
+}
+
+__PUB_API__ cl_list_node_t *cl_pqueue_pop(cl_pqueue_t *pqueue)
+{
+    pqueue_s *q = (pqueue_s *)pqueue;
+    void *node = NULL;
+
+    __clib_function_init__(true, pqueue, CL_OBJ_PQUEUE, NULL);
+    lock(q);
+
+    if (q->size > 0)
+        node = take(q, 0);
+
+    unlock(q);
+
+    return node;
+}
+
+__PUB_API__ cl_list_node_t *cl_pqueue_peek(cl_pqueue_t *pqueue)
+{
+    pqueue_s *q = (pqueue_s *)pqueue;
+    void *node = NULL;
+
+    __clib_function_init__(true, pqueue, CL_OBJ_PQUEUE, NULL);
+    lock(q);
+
+    if (q->size > 0)
+        node = cglist_node_ref(q->heap[0].node, CL_OBJ_LIST_NODE);
+
+    unlock(q);
+
+    return node;
+}
+
+__PUB_API__ int cl_pqueue_update(cl_pqueue_t *pqueue,
+    cl_pqueue_node_t *handle)
+{
+    __clib_function_init__(true, pqueue, CL_OBJ_PQUEUE, -1);
+
+    return update_element((pqueue_s *)pqueue, (struct phandle *)handle, NULL,
+                          NULL);
+}
+
+__PUB_API__ int cl_pqueue_update_priority(cl_pqueue_t *pqueue,
+    cl_pqueue_node_t *handle, void (*change)(cl_list_node_t *, void *),
+    void *data)
+{
+    __clib_function_init__(true, pqueue, CL_OBJ_PQUEUE, -1);
+
+    if (NULL == change) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    return update_element((pqueue_s *)pqueue, (struct phandle *)handle,
+                          change, data);
+}
+
+__PUB_API__ int cl_pqueue_remove(cl_pqueue_t *pqueue,
+    cl_pqueue_node_t *handle)
+{
+    pqueue_s *q = (pqueue_s *)pqueue;
+    struct phandle *h = (struct phandle *)handle;
+    void *node;
+
+    __clib_function_init__(true, pqueue, CL_OBJ_PQUEUE, -1);
+    lock(q);
+
+    if (validate_handle(q, h) < 0) {
+        unlock(q);
+        return -1;
+    }
+
+    node = take(q, h->index);
+    unlock(q);
+    cglist_node_unref(node, CL_OBJ_LIST_NODE);
+
+    return 0;
+}
+
+__PUB_API__ int cl_pqueue_heapify(cl_pqueue_t *pqueue, cl_list_t *list)
+{
+    pqueue_s *q = (pqueue_s *)pqueue;
+    struct pentry e;
+    unsigned int i;
+    int n, k;
+
+    __clib_function_init__(true, pqueue, CL_OBJ_PQUEUE, -1);
+    n = cl_list_size(list);
+
+    if (n < 0)
+        return -1;
+
+    lock(q);
+
+    if (grow(q, q->size + n) < 0) {
+        unlock(q);
+        return -1;
+    }
+
+    e.handle = NULL;
+
+    for (k = 0; k < n; k++) {
+        e.node = cglist_shift(list, CL_OBJ_LIST);
+
+        if (NULL == e.node)
+            break;
+
+        q->heap[q->size++] = e;
+    }
+
+    /* Floyd's construction, from the last parent up to the root */
+    if (q->size > 1)
+        for (i = (q->size - 2) / q->arity + 1; i-- > 0;)
+            sift_down(q, i);
+
+    unlock(q);
+
+    return 0;
+}
+
+__PUB_API__ int cl_pqueue_size(cl_pqueue_t *pqueue)
+{
+    pqueue_s *q = (pqueue_s *)pqueue;
+    int size;
+
+    __clib_function_init__(true, pqueue, CL_OBJ_PQUEUE, -1);
+    lock(q);
+    size = q->size;
+    unlock(q);
+
+    return size;
+}
+
+__PUB_API__ bool cl_pqueue_is_empty(cl_pqueue_t *pqueue)
+{
+    return (cl_pqueue_size(pqueue) > 0) ? false : true;
+}
+
@@ -57,7 +57,16 @@ __PUB_API__ cl_queue_t *cl_queue_create(void (*free_data)(void *),
     int (*equals)(cl_queue_node_t *, cl_queue_node_t *))
 {
     return (cl_queue_t *)cglist_create(CL_OBJ_QUEUE, free_data, compare_to,
-                                       filter, equals);
+                                       filter, equals, 0);
+}
+
+__PUB_API__ cl_queue_t *cl_queue_create_ex(void (*free_data)(void *),
+    int (*compare_to)(cl_queue_node_t *, cl_queue_node_t *),
+    int (*filter)(cl_queue_node_t *, void *),
+    int (*equals)(cl_queue_node_t *, cl_queue_node_t *), unsigned int flags)
+{
+    return (cl_queue_t *)cglist_create(CL_OBJ_QUEUE, free_data, compare_to,
+                                       filter, equals, flags);
 }
 
 __PUB_API__ int cl_queue_destroy(cl_queue_t *queue)
@@ -82,6 +91,20 @@ __PUB_API__ int cl_queue_enqueue(cl_queue_t *queue, const void *node_content,
                           CL_OBJ_QUEUE_NODE);
 }
 
+__PUB_API__ int cl_queue_enqueue_many(cl_queue_t *queue, void **contents,
+    unsigned int size, unsigned int count)
+{
+    return cglist_push_many((cl_queue_t *)queue, CL_OBJ_QUEUE, contents, size,
+                            count, CL_OBJ_QUEUE_NODE, false);
+}
+
+__PUB_API__ int cl_queue_dequeue_many(cl_queue_t *queue,
+    cl_queue_node_t **nodes, unsigned int count)
+{
+    return cglist_pop_many((cl_queue_t *)queue, CL_OBJ_QUEUE, (void **)nodes,
+                           count);
+}
+
 __PUB_API__ cl_queue_node_t *cl_queue_map(const cl_queue_t *queue,
     int (*foo)(cl_queue_node_t *, void *), void *data)
 {
@@ -196,3 +219,9 @@ __PUB_API__ int cl_queue_set_equals(const cl_queue_t *queue,
     return cglist_set_equals((cl_queue_t *)queue, CL_OBJ_QUEUE, equals);
 }
 
+__PUB_API__ int cl_queue_pool_stats(const cl_queue_t *queue,
+    struct cl_list_pool_stats_s *stats)
+{
+    return cglist_pool_stats(queue, CL_OBJ_QUEUE, stats);
+}
+
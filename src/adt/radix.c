@@ -0,0 +1,1295 @@
+
+/*
+ * Description: An adaptive radix tree keyed by strings.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 19:15:02 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <pthread.h>
+
+#include "collections.h"
+
+/* Bytes of a compressed path kept inside its node */
+#define RADIX_MAX_PREFIX            12
+
+/* A node shrinks to the previous layout once it has this many children */
+#define RADIX_SHRINK16              3
+#define RADIX_SHRINK48              12
+#define RADIX_SHRINK256             37
+
+/* Node layouts, named by the most children they hold */
+enum rnode_type {
+    RNODE4,
+    RNODE16,
+    RNODE48,
+    RNODE256
+};
+
+/*
+ * The part shared by every layout. The @prefix_len bytes common to all keys
+ * below a node are skipped before branching, but only the first
+ * RADIX_MAX_PREFIX of them are kept here. Lookups skip the rest and compare
+ * the whole key once they reach a leaf, while changes compare them against
+ * any leaf below the node.
+ */
+struct rnode {
+    uint32_t        prefix_len;
+    uint16_t        count;
+    uint8_t         type;
+    unsigned char   prefix[RADIX_MAX_PREFIX];
+};
+
+/* Children sorted by their byte. A full rnode4 takes 56 bytes. */
+struct rnode4 {
+    struct rnode    n;
+    unsigned char   keys[4];
+    void            *children[4];
+};
+
+struct rnode16 {
+    struct rnode    n;
+    unsigned char   keys[16];
+    void            *children[16];
+};
+
+/* Children found through @index, which holds their position plus one */
+struct rnode48 {
+    struct rnode    n;
+    unsigned char   index[256];
+    void            *children[48];
+};
+
+struct rnode256 {
+    struct rnode    n;
+    void            *children[256];
+};
+
+/*
+ * Keys are kept with their null terminator, so no key is a prefix of
+ * another one and each of them ends at a leaf of its own. A key which is a
+ * prefix of others is the child, through byte 0, of the node where they
+ * branch, and so the first one visited.
+ */
+struct rleaf {
+    void            *value;
+    unsigned int    len;
+    char            key[];
+};
+
+#define cl_radix_members                                            \
+    cl_struct_member(void *, root)                                  \
+    cl_struct_member(unsigned int, size)                            \
+    cl_struct_member(void, (*free_value)(void *))                   \
+    cl_struct_member(bool, thread_safe)                             \
+    cl_struct_member(pthread_rwlock_t, lock)                        \
+    cl_struct_member(struct cl_ref_s, ref)
+
+cl_struct_declare(radix_s, cl_radix_members);
+
+#define radix_s         cl_struct(radix_s)
+
+static void read_lock(radix_s *r)
+{
+    if (r->thread_safe)
+        pthread_rwlock_rdlock(&r->lock);
+}
+
+static void write_lock(radix_s *r)
+{
+    if (r->thread_safe)
+        pthread_rwlock_wrlock(&r->lock);
+}
+
+static void unlock(radix_s *r)
+{
+    if (r->thread_safe)
+        pthread_rwlock_unlock(&r->lock);
+}
+
+static unsigned int min_of(unsigned int a, unsigned int b)
+{
+    return (a < b) ? a : b;
+}
+
+/*
+ *
+ * Nodes and leaves.
+ *
+ */
+
+/* Children pointing to leaves have their lowest bit set */
+static bool is_leaf(const void *p)
+{
+    return ((uintptr_t)p & 1) != 0;
+}
+
+static struct rleaf *leaf_of(const void *p)
+{
+    return (struct rleaf *)((uintptr_t)p & ~(uintptr_t)1);
+}
+
+static void *tag_leaf(const struct rleaf *l)
+{
+    return (void *)((uintptr_t)l | 1);
+}
+
+static struct rleaf *new_leaf(const unsigned char *key, unsigned int len,
+    void *value)
+{
+    struct rleaf *l;
+
+    l = malloc(sizeof(struct rleaf) + len);
+
+    if (NULL == l) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    l->value = value;
+    l->len = len;
+    memcpy(l->key, key, len);
+
+    return l;
+}
+
+static bool leaf_matches(const struct rleaf *l, const unsigned char *key,
+    unsigned int len)
+{
+    return (l->len == len) && (memcmp(l->key, key, len) == 0);
+}
+
+/* Tells if the key of @l, without its terminator, starts @key */
+static bool leaf_is_prefix(const struct rleaf *l, const unsigned char *key,
+    unsigned int len)
+{
+    return (l->len <= len) && (memcmp(l->key, key, l->len - 1) == 0);
+}
+
+static struct rnode *new_node(enum rnode_type type)
+{
+    static const size_t sizes[] = {
+        sizeof(struct rnode4),
+        sizeof(struct rnode16),
+        sizeof(struct rnode48),
+        sizeof(struct rnode256)
+    };
+
+    struct rnode *n;
+
+    n = calloc(1, sizes[type]);
+
+    if (NULL == n) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    n->type = type;
+
+    return n;
+}
+
+static void copy_header(struct rnode *dest, const struct rnode *src)
+{
+    dest->count = src->count;
+    dest->prefix_len = src->prefix_len;
+    memcpy(dest->prefix, src->prefix,
+           min_of(src->prefix_len, RADIX_MAX_PREFIX));
+}
+
+static void **find_sorted(unsigned char *keys, void **children,
+    unsigned int count, unsigned char c)
+{
+    unsigned int i;
+
+    for (i = 0; (i < count) && (keys[i] <= c); i++)
+        if (keys[i] == c)
+            return &children[i];
+
+    return NULL;
+}
+
+static void insert_sorted(unsigned char *keys, void **children,
+    unsigned int count, unsigned char c, void *child)
+{
+    unsigned int i;
+
+    for (i = 0; (i < count) && (keys[i] < c); i++)
+        ;
+
+    memmove(keys + i + 1, keys + i, count - i);
+    memmove(children + i + 1, children + i, (count - i) * sizeof(void *));
+    keys[i] = c;
+    children[i] = child;
+}
+
+static void remove_sorted(unsigned char *keys, void **children,
+    unsigned int count, unsigned int i)
+{
+    memmove(keys + i, keys + i + 1, count - i - 1);
+    memmove(children + i, children + i + 1,
+            (count - i - 1) * sizeof(void *));
+}
+
+/* Gets where the child of @n for byte @c is, or NULL if there is none */
+static void **find_child(struct rnode *n, unsigned char c)
+{
+    struct rnode4 *n4;
+    struct rnode16 *n16;
+    struct rnode48 *n48;
+    struct rnode256 *n256;
+
+    switch (n->type) {
+        case RNODE4:
+            n4 = (struct rnode4 *)n;
+            return find_sorted(n4->keys, n4->children, n->count, c);
+
+        case RNODE16:
+            n16 = (struct rnode16 *)n;
+            return find_sorted(n16->keys, n16->children, n->count, c);
+
+        case RNODE48:
+            n48 = (struct rnode48 *)n;
+
+            if (n48->index[c] != 0)
+                return &n48->children[n48->index[c] - 1];
+
+            break;
+
+        case RNODE256:
+            n256 = (struct rnode256 *)n;
+
+            if (n256->children[c] != NULL)
+                return &n256->children[c];
+
+            break;
+    }
+
+    return NULL;
+}
+
+/* Gets the leaf with the lowest key below @p */
+static struct rleaf *minimum_leaf(const void *p)
+{
+    const struct rnode48 *n48;
+    const struct rnode256 *n256;
+    unsigned int i;
+
+    while (is_leaf(p) == false) {
+        switch (((const struct rnode *)p)->type) {
+            case RNODE4:
+                p = ((const struct rnode4 *)p)->children[0];
+                break;
+
+            case RNODE16:
+                p = ((const struct rnode16 *)p)->children[0];
+                break;
+
+            case RNODE48:
+                n48 = (const struct rnode48 *)p;
+
+                for (i = 0; n48->index[i] == 0; i++)
+                    ;
+
+                p = n48->children[n48->index[i] - 1];
+                break;
+
+            case RNODE256:
+                n256 = (const struct rnode256 *)p;
+
+                for (i = 0; NULL == n256->children[i]; i++)
+                    ;
+
+                p = n256->children[i];
+                break;
+        }
+    }
+
+    return leaf_of(p);
+}
+
+/*
+ * Compares the path of @n kept inside it with @key from @depth on. Returns
+ * how many bytes are equal.
+ */
+static unsigned int check_prefix(const struct rnode *n,
+    const unsigned char *key, unsigned int len, unsigned int depth)
+{
+    unsigned int max, i;
+
+    max = min_of(min_of(n->prefix_len, RADIX_MAX_PREFIX), len - depth);
+
+    for (i = 0; i < max; i++)
+        if (n->prefix[i] != key[depth + i])
+            break;
+
+    return i;
+}
+
+/*
+ * The same as check_prefix, but comparing the whole path of @n, taking the
+ * bytes not kept inside it from a leaf below it.
+ */
+static unsigned int prefix_mismatch(const struct rnode *n,
+    const unsigned char *key, unsigned int len, unsigned int depth)
+{
+    const struct rleaf *l;
+    unsigned int max, i;
+
+    i = check_prefix(n, key, len, depth);
+
+    if ((i < RADIX_MAX_PREFIX) || (n->prefix_len <= RADIX_MAX_PREFIX))
+        return i;
+
+    l = minimum_leaf(n);
+    max = min_of(min_of(l->len, len) - depth, n->prefix_len);
+
+    for (; i < max; i++)
+        if ((unsigned char)l->key[depth + i] != key[depth + i])
+            break;
+
+    return i;
+}
+
+/*
+ * Adds a child to the node at @ref, replacing it by a larger layout when
+ * it is full.
+ */
+static int add_child(void **ref, unsigned char c, void *child)
+{
+    struct rnode *n = *ref, *bigger = NULL;
+    struct rnode4 *n4;
+    struct rnode16 *n16;
+    struct rnode48 *n48;
+    struct rnode256 *n256;
+    unsigned int i;
+
+    switch (n->type) {
+        case RNODE4:
+            n4 = (struct rnode4 *)n;
+
+            if (n->count < 4) {
+                insert_sorted(n4->keys, n4->children, n->count, c, child);
+                n->count++;
+                return 0;
+            }
+
+            bigger = new_node(RNODE16);
+
+            if (NULL == bigger)
+                return -1;
+
+            n16 = (struct rnode16 *)bigger;
+            memcpy(n16->keys, n4->keys, 4);
+            memcpy(n16->children, n4->children, 4 * sizeof(void *));
+            break;
+
+        case RNODE16:
+            n16 = (struct rnode16 *)n;
+
+            if (n->count < 16) {
+                insert_sorted(n16->keys, n16->children, n->count, c, child);
+                n->count++;
+                return 0;
+            }
+
+            bigger = new_node(RNODE48);
+
+            if (NULL == bigger)
+                return -1;
+
+            n48 = (struct rnode48 *)bigger;
+
+            for (i = 0; i < 16; i++) {
+                n48->index[n16->keys[i]] = i + 1;
+                n48->children[i] = n16->children[i];
+            }
+
+            break;
+
+        case RNODE48:
+            n48 = (struct rnode48 *)n;
+
+            if (n->count < 48) {
+                for (i = 0; n48->children[i] != NULL; i++)
+                    ;
+
+                n48->children[i] = child;
+                n48->index[c] = i + 1;
+                n->count++;
+                return 0;
+            }
+
+            bigger = new_node(RNODE256);
+
+            if (NULL == bigger)
+                return -1;
+
+            n256 = (struct rnode256 *)bigger;
+
+            for (i = 0; i < 256; i++)
+                if (n48->index[i] != 0)
+                    n256->children[i] = n48->children[n48->index[i] - 1];
+
+            break;
+
+        case RNODE256:
+            n256 = (struct rnode256 *)n;
+            n256->children[c] = child;
+            n->count++;
+            return 0;
+    }
+
+    copy_header(bigger, n);
+    free(n);
+    *ref = bigger;
+
+    return add_child(ref, c, child);
+}
+
+/*
+ * A node left with a single child is replaced by it, which takes the node
+ * path and the byte leading to it in front of its own path. Leaves need
+ * nothing since they keep whole keys.
+ */
+static void collapse_node(void **ref)
+{
+    struct rnode4 *n4 = *ref;
+    struct rnode *child;
+    unsigned int prefix, sub;
+
+    if (is_leaf(n4->children[0]) == false) {
+        child = n4->children[0];
+        prefix = n4->n.prefix_len;
+
+        if (prefix < RADIX_MAX_PREFIX)
+            n4->n.prefix[prefix++] = n4->keys[0];
+
+        if (prefix < RADIX_MAX_PREFIX) {
+            sub = min_of(child->prefix_len, RADIX_MAX_PREFIX - prefix);
+            memcpy(n4->n.prefix + prefix, child->prefix, sub);
+            prefix += sub;
+        }
+
+        memcpy(child->prefix, n4->n.prefix, min_of(prefix, RADIX_MAX_PREFIX));
+        child->prefix_len += n4->n.prefix_len + 1;
+    }
+
+    *ref = n4->children[0];
+    free(n4);
+}
+
+/*
+ * Removes the child at @slot, for byte @c, from the node at @ref, replacing
+ * the node by a smaller layout when it gets sparse enough. If that can't be
+ * allocated the node is simply kept.
+ */
+static void remove_child(void **ref, unsigned char c, void **slot)
+{
+    struct rnode *n = *ref, *smaller = NULL;
+    struct rnode4 *n4;
+    struct rnode16 *n16;
+    struct rnode48 *n48;
+    struct rnode256 *n256;
+    unsigned int i, j;
+
+    switch (n->type) {
+        case RNODE4:
+            n4 = (struct rnode4 *)n;
+            remove_sorted(n4->keys, n4->children, n->count,
+                          slot - n4->children);
+
+            if (--n->count == 1)
+                collapse_node(ref);
+
+            return;
+
+        case RNODE16:
+            n16 = (struct rnode16 *)n;
+            remove_sorted(n16->keys, n16->children, n->count,
+                          slot - n16->children);
+
+            if (--n->count > RADIX_SHRINK16)
+                return;
+
+            smaller = new_node(RNODE4);
+
+            if (NULL == smaller)
+                return;
+
+            n4 = (struct rnode4 *)smaller;
+            memcpy(n4->keys, n16->keys, n->count);
+            memcpy(n4->children, n16->children, n->count * sizeof(void *));
+            break;
+
+        case RNODE48:
+            n48 = (struct rnode48 *)n;
+            n48->children[n48->index[c] - 1] = NULL;
+            n48->index[c] = 0;
+
+            if (--n->count > RADIX_SHRINK48)
+                return;
+
+            smaller = new_node(RNODE16);
+
+            if (NULL == smaller)
+                return;
+
+            n16 = (struct rnode16 *)smaller;
+
+            for (i = 0, j = 0; i < 256; i++) {
+                if (n48->index[i] != 0) {
+                    n16->keys[j] = i;
+                    n16->children[j++] = n48->children[n48->index[i] - 1];
+                }
+            }
+
+            break;
+
+        case RNODE256:
+            n256 = (struct rnode256 *)n;
+            n256->children[c] = NULL;
+
+            if (--n->count > RADIX_SHRINK256)
+                return;
+
+            smaller = new_node(RNODE48);
+
+            if (NULL == smaller)
+                return;
+
+            n48 = (struct rnode48 *)smaller;
+
+            for (i = 0, j = 0; i < 256; i++) {
+                if (n256->children[i] != NULL) {
+                    n48->children[j++] = n256->children[i];
+                    n48->index[i] = j;
+                }
+            }
+
+            break;
+    }
+
+    copy_header(smaller, n);
+    free(n);
+    *ref = smaller;
+}
+
+static void destroy_subtree(radix_s *r, void *p)
+{
+    struct rnode *n = p;
+    struct rleaf *l;
+    void **children = NULL;
+    unsigned int i, count = 0;
+
+    if (NULL == p)
+        return;
+
+    if (is_leaf(p) == true) {
+        l = leaf_of(p);
+
+        if (r->free_value != NULL)
+            (r->free_value)(l->value);
+
+        free(l);
+        return;
+    }
+
+    switch (n->type) {
+        case RNODE4:
+            children = ((struct rnode4 *)n)->children;
+            count = n->count;
+            break;
+
+        case RNODE16:
+            children = ((struct rnode16 *)n)->children;
+            count = n->count;
+            break;
+
+        case RNODE48:
+            children = ((struct rnode48 *)n)->children;
+            count = 48;
+            break;
+
+        case RNODE256:
+            children = ((struct rnode256 *)n)->children;
+            count = 256;
+            break;
+    }
+
+    for (i = 0; i < count; i++)
+        destroy_subtree(r, children[i]);
+
+    free(n);
+}
+
+/*
+ *
+ * Tree operations.
+ *
+ */
+
+static struct rleaf *find_leaf(const radix_s *r, const unsigned char *key,
+    unsigned int len)
+{
+    void *p = r->root, **child;
+    struct rnode *n;
+    unsigned int depth = 0;
+
+    while (p != NULL) {
+        if (is_leaf(p) == true)
+            return leaf_matches(leaf_of(p), key, len) ? leaf_of(p) : NULL;
+
+        n = p;
+
+        if (n->prefix_len > 0) {
+            if (check_prefix(n, key, len, depth) !=
+                min_of(n->prefix_len, RADIX_MAX_PREFIX))
+            {
+                return NULL;
+            }
+
+            depth += n->prefix_len;
+        }
+
+        if (depth >= len)
+            return NULL;
+
+        child = find_child(n, key[depth++]);
+        p = (child != NULL) ? *child : NULL;
+    }
+
+    return NULL;
+}
+
+static int insert_key(radix_s *r, const unsigned char *key, unsigned int len,
+    void *value)
+{
+    void **ref = &r->root, **child;
+    struct rnode *n, *split = NULL;
+    struct rleaf *l, *leaf = NULL;
+    unsigned int depth = 0, diff;
+
+    while (*ref != NULL) {
+        if (is_leaf(*ref) == true) {
+            l = leaf_of(*ref);
+
+            if (leaf_matches(l, key, len) == true) {
+                if ((r->free_value != NULL) && (l->value != value))
+                    (r->free_value)(l->value);
+
+                l->value = value;
+                return 0;
+            }
+
+            /* Both keys go below a new node, past the bytes they share */
+            split = new_node(RNODE4);
+            leaf = new_leaf(key, len, value);
+
+            if ((NULL == split) || (NULL == leaf))
+                goto error_block;
+
+            for (diff = 0; l->key[depth + diff] == key[depth + diff]; diff++)
+                ;
+
+            split->prefix_len = diff;
+            memcpy(split->prefix, key + depth, min_of(diff, RADIX_MAX_PREFIX));
+            add_child((void **)&split, l->key[depth + diff], *ref);
+            add_child((void **)&split, key[depth + diff], tag_leaf(leaf));
+            *ref = split;
+            r->size++;
+
+            return 0;
+        }
+
+        n = *ref;
+
+        if (n->prefix_len > 0) {
+            diff = prefix_mismatch(n, key, len, depth);
+
+            if (diff < n->prefix_len) {
+                /* The key leaves the node path, which is split at @diff */
+                split = new_node(RNODE4);
+                leaf = new_leaf(key, len, value);
+
+                if ((NULL == split) || (NULL == leaf))
+                    goto error_block;
+
+                split->prefix_len = diff;
+                memcpy(split->prefix, n->prefix,
+                       min_of(diff, RADIX_MAX_PREFIX));
+
+                if (n->prefix_len <= RADIX_MAX_PREFIX) {
+                    add_child((void **)&split, n->prefix[diff], n);
+                    n->prefix_len -= diff + 1;
+                    memmove(n->prefix, n->prefix + diff + 1,
+                            min_of(n->prefix_len, RADIX_MAX_PREFIX));
+                } else {
+                    l = minimum_leaf(n);
+                    add_child((void **)&split, l->key[depth + diff], n);
+                    n->prefix_len -= diff + 1;
+                    memcpy(n->prefix, l->key + depth + diff + 1,
+                           min_of(n->prefix_len, RADIX_MAX_PREFIX));
+                }
+
+                add_child((void **)&split, key[depth + diff], tag_leaf(leaf));
+                *ref = split;
+                r->size++;
+
+                return 0;
+            }
+
+            depth += n->prefix_len;
+        }
+
+        child = find_child(n, key[depth]);
+
+        if (NULL == child) {
+            leaf = new_leaf(key, len, value);
+
+            if ((NULL == leaf) ||
+                (add_child(ref, key[depth], tag_leaf(leaf)) < 0))
+            {
+                goto error_block;
+            }
+
+            r->size++;
+
+            return 0;
+        }
+
+        ref = child;
+        depth++;
+    }
+
+    leaf = new_leaf(key, len, value);
+
+    if (NULL == leaf)
+        return -1;
+
+    *ref = tag_leaf(leaf);
+    r->size++;
+
+    return 0;
+
+error_block:
+    free(split);
+    free(leaf);
+    cset_errno(CL_NO_MEM);
+
+    return -1;
+}
+
+/*
+ * Takes a key out of the tree. Returns its leaf, which still needs to be
+ * released, or NULL if the key is not there.
+ */
+static struct rleaf *remove_key(radix_s *r, const unsigned char *key,
+    unsigned int len)
+{
+    void **ref = &r->root, **child;
+    struct rnode *n;
+    struct rleaf *l;
+    unsigned int depth = 0;
+
+    if ((NULL == r->root) || (is_leaf(r->root) == true)) {
+        if ((NULL == r->root) ||
+            (leaf_matches(leaf_of(r->root), key, len) == false))
+        {
+            return NULL;
+        }
+
+        l = leaf_of(r->root);
+        r->root = NULL;
+
+        return l;
+    }
+
+    while (1) {
+        n = *ref;
+
+        if (n->prefix_len > 0) {
+            if (check_prefix(n, key, len, depth) !=
+                min_of(n->prefix_len, RADIX_MAX_PREFIX))
+            {
+                return NULL;
+            }
+
+            depth += n->prefix_len;
+        }
+
+        if (depth >= len)
+            return NULL;
+
+        child = find_child(n, key[depth]);
+
+        if (NULL == child)
+            return NULL;
+
+        if (is_leaf(*child) == true) {
+            l = leaf_of(*child);
+
+            if (leaf_matches(l, key, len) == false)
+                return NULL;
+
+            remove_child(ref, key[depth], child);
+
+            return l;
+        }
+
+        ref = child;
+        depth++;
+    }
+}
+
+/*
+ * Walks down @key, remembering the last key ending along the way which is
+ * a prefix of it. Such keys hang from byte 0 of the nodes where they end.
+ */
+static struct rleaf *find_longest_prefix(const radix_s *r,
+    const unsigned char *key, unsigned int len)
+{
+    void *p = r->root, **child;
+    struct rnode *n;
+    struct rleaf *l, *best = NULL;
+    unsigned int depth = 0;
+
+    while (p != NULL) {
+        if (is_leaf(p) == true) {
+            l = leaf_of(p);
+
+            if (leaf_is_prefix(l, key, len) == true)
+                best = l;
+
+            break;
+        }
+
+        n = p;
+
+        if (n->prefix_len > 0) {
+            if (check_prefix(n, key, len, depth) !=
+                min_of(n->prefix_len, RADIX_MAX_PREFIX))
+            {
+                break;
+            }
+
+            depth += n->prefix_len;
+        }
+
+        if (depth >= len)
+            break;
+
+        child = find_child(n, 0);
+
+        if ((child != NULL) && (leaf_is_prefix(leaf_of(*child), key, len)))
+            best = leaf_of(*child);
+
+        child = find_child(n, key[depth++]);
+        p = (child != NULL) ? *child : NULL;
+    }
+
+    return best;
+}
+
+/* Calls @foo for every key below @p, in order, until it returns non-zero */
+static struct rleaf *map_subtree(const void *p,
+    int (*foo)(const char *, void *, void *), void *data)
+{
+    const struct rnode *n = p;
+    const struct rnode48 *n48;
+    const struct rnode256 *n256;
+    struct rleaf *l = NULL;
+    void * const *children = NULL;
+    unsigned int i;
+
+    if (is_leaf(p) == true) {
+        l = leaf_of(p);
+
+        return (foo(l->key, l->value, data) != 0) ? l : NULL;
+    }
+
+    switch (n->type) {
+        case RNODE4:
+            children = ((const struct rnode4 *)n)->children;
+            break;
+
+        case RNODE16:
+            children = ((const struct rnode16 *)n)->children;
+            break;
+
+        case RNODE48:
+            n48 = (const struct rnode48 *)n;
+
+            for (i = 0; (i < 256) && (NULL == l); i++)
+                if (n48->index[i] != 0)
+                    l = map_subtree(n48->children[n48->index[i] - 1], foo,
+                                    data);
+
+            return l;
+
+        case RNODE256:
+            n256 = (const struct rnode256 *)n;
+
+            for (i = 0; (i < 256) && (NULL == l); i++)
+                if (n256->children[i] != NULL)
+                    l = map_subtree(n256->children[i], foo, data);
+
+            return l;
+    }
+
+    for (i = 0; (i < n->count) && (NULL == l); i++)
+        l = map_subtree(children[i], foo, data);
+
+    return l;
+}
+
+/*
+ * Finds the subtree holding every key which starts with @prefix, @len bytes
+ * long with no terminator, and maps @foo over it.
+ */
+static struct rleaf *map_prefix(const radix_s *r, const unsigned char *prefix,
+    unsigned int len, int (*foo)(const char *, void *, void *), void *data)
+{
+    void *p = r->root, **child;
+    struct rnode *n;
+    struct rleaf *l;
+    unsigned int depth = 0, matched;
+
+    while (p != NULL) {
+        if (is_leaf(p) == true) {
+            l = leaf_of(p);
+
+            if ((l->len <= len) || (memcmp(l->key, prefix, len) != 0))
+                return NULL;
+
+            break;
+        }
+
+        n = p;
+
+        if (depth == len)
+            break;
+
+        if (n->prefix_len > 0) {
+            matched = prefix_mismatch(n, prefix, len, depth);
+
+            if (matched < min_of(n->prefix_len, len - depth))
+                return NULL;
+
+            /* The prefix ends inside the node path */
+            if (len - depth <= n->prefix_len)
+                break;
+
+            depth += n->prefix_len;
+        }
+
+        child = find_child(n, prefix[depth++]);
+        p = (child != NULL) ? *child : NULL;
+    }
+
+    if (NULL == p)
+        return NULL;
+
+    return map_subtree(p, foo, data);
+}
+
+static void destroy_radix(const struct cl_ref_s *ref)
+{
+    radix_s *r = cl_container_of(ref, radix_s, ref);
+
+    if (NULL == r)
+        return;
+
+    destroy_subtree(r, r->root);
+    pthread_rwlock_destroy(&r->lock);
+    free(r);
+    r = NULL;
+}
+
+static radix_s *new_radix(void (*free_value)(void *), bool thread_safe)
+{
+    radix_s *r = NULL;
+
+    r = calloc(1, sizeof(radix_s));
+
+    if (NULL == r) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    r->free_value = free_value;
+    r->thread_safe = thread_safe;
+    pthread_rwlock_init(&r->lock, NULL);
+    typeof_set(CL_OBJ_RADIX, r);
+
+    r->ref.free = destroy_radix;
+    r->ref.count = 1;
+
+    return r;
+}
+
+/*
+ *
+ * API
+ *
+ */
+
+__PUB_API__ cl_radix_t *cl_radix_ref(cl_radix_t *radix)
+{
+    radix_s *r = (radix_s *)radix;
+
+    __clib_function_init__(true, radix, CL_OBJ_RADIX, NULL);
+    cl_ref_inc(&r->ref);
+
+    return radix;
+}
+
+__PUB_API__ int cl_radix_unref(cl_radix_t *radix)
+{
+    radix_s *r = (radix_s *)radix;
+
+    __clib_function_init__(true, radix, CL_OBJ_RADIX, -1);
+    cl_ref_dec(&r->ref);
+
+    return 0;
+}
+
+__PUB_API__ cl_radix_t *cl_radix_create(void (*free_value)(void *),
+    bool thread_safe)
+{
+    __clib_function_init__(false, NULL, -1, NULL);
+
+    return new_radix(free_value, thread_safe);
+}
+
+__PUB_API__ int cl_radix_destroy(cl_radix_t *radix)
+{
+    return cl_radix_unref(radix);
+}
+
+__PUB_API__ int cl_radix_put(cl_radix_t *radix, const char *key, void *value)
+{
+    radix_s *r = (radix_s *)radix;
+    int ret;
+
+    __clib_function_init__(true, radix, CL_OBJ_RADIX, -1);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    write_lock(r);
+    ret = insert_key(r, (const unsigned char *)key, strlen(key) + 1, value);
+    unlock(r);
+
+    return ret;
+}
+
+__PUB_API__ void *cl_radix_get(cl_radix_t *radix, const char *key)
+{
+    radix_s *r = (radix_s *)radix;
+    struct rleaf *l;
+    void *value = NULL;
+
+    __clib_function_init__(true, radix, CL_OBJ_RADIX, NULL);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    read_lock(r);
+    l = find_leaf(r, (const unsigned char *)key, strlen(key) + 1);
+
+    if (l != NULL)
+        value = l->value;
+    else
+        cset_errno(CL_OBJECT_NOT_FOUND);
+
+    unlock(r);
+
+    return value;
+}
+
+__PUB_API__ int cl_radix_delete(cl_radix_t *radix, const char *key)
+{
+    radix_s *r = (radix_s *)radix;
+    struct rleaf *l;
+
+    __clib_function_init__(true, radix, CL_OBJ_RADIX, -1);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    write_lock(r);
+    l = remove_key(r, (const unsigned char *)key, strlen(key) + 1);
+
+    if (l != NULL)
+        r->size--;
+
+    unlock(r);
+
+    if (NULL == l) {
+        cset_errno(CL_OBJECT_NOT_FOUND);
+        return -1;
+    }
+
+    if (r->free_value != NULL)
+        (r->free_value)(l->value);
+
+    free(l);
+
+    return 0;
+}
+
+__PUB_API__ bool cl_radix_contains_key(cl_radix_t *radix, const char *key)
+{
+    radix_s *r = (radix_s *)radix;
+    bool ret;
+
+    __clib_function_init__(true, radix, CL_OBJ_RADIX, false);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return false;
+    }
+
+    read_lock(r);
+    ret = (find_leaf(r, (const unsigned char *)key, strlen(key) + 1) != NULL);
+    unlock(r);
+
+    return ret;
+}
+
+__PUB_API__ int cl_radix_size(cl_radix_t *radix)
+{
+    radix_s *r = (radix_s *)radix;
+    int size;
+
+    __clib_function_init__(true, radix, CL_OBJ_RADIX, -1);
+    read_lock(r);
+    size = r->size;
+    unlock(r);
+
+    return size;
+}
+
+__PUB_API__ bool cl_radix_is_empty(cl_radix_t *radix)
+{
+    return (cl_radix_size(radix) > 0) ? false : true;
+}
+
+__PUB_API__ const char *cl_radix_longest_prefix(cl_radix_t *radix,
+    const char *key, void **value)
+{
+    radix_s *r = (radix_s *)radix;
+    struct rleaf *l;
+    const char *k = NULL;
+
+    __clib_function_init__(true, radix, CL_OBJ_RADIX, NULL);
+
+    if (NULL == key) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    read_lock(r);
+    l = find_longest_prefix(r, (const unsigned char *)key, strlen(key) + 1);
+
+    if (l != NULL) {
+        k = l->key;
+
+        if (value != NULL)
+            *value = l->value;
+    } else
+        cset_errno(CL_OBJECT_NOT_FOUND);
+
+    unlock(r);
+
+    return k;
+}
+
+__PUB_API__ const char *cl_radix_map_prefix(cl_radix_t *radix,
+    const char *prefix, int (*foo)(const char *, void *, void *), void *data)
+{
+    radix_s *r = (radix_s *)radix;
+    struct rleaf *l;
+
+    __clib_function_init__(true, radix, CL_OBJ_RADIX, NULL);
+
+    if ((NULL == prefix) || (NULL == foo)) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    read_lock(r);
+    l = map_prefix(r, (const unsigned char *)prefix, strlen(prefix), foo,
+                   data);
+
+    unlock(r);
+
+    return (l != NULL) ? l->key : NULL;
+}
+
+__PUB_API__ int cl_radix_visit(cl_radix_t *radix, const char *key,
+    enum cl_radix_seek seek, void (*foo)(const char *, void *, void *),
+    void *data)
+{
+    radix_s *r = (radix_s *)radix;
+    struct rleaf *l = NULL;
+
+    __clib_function_init__(true, radix, CL_OBJ_RADIX, -1);
+
+    if ((NULL == key) || (NULL == foo)) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    if (seek > CL_RADIX_LONGEST_PREFIX) {
+        cset_errno(CL_INVALID_VALUE);
+        return -1;
+    }
+
+    read_lock(r);
+
+    if (seek == CL_RADIX_EXACT)
+        l = find_leaf(r, (const unsigned char *)key, strlen(key) + 1);
+    else
+        l = find_longest_prefix(r, (const unsigned char *)key,
+                                strlen(key) + 1);
+
+    if (l != NULL)
+        foo(l->key, l->value, data);
+    else
+        cset_errno(CL_OBJECT_NOT_FOUND);
+
+    unlock(r);
+
+    return (NULL == l) ? -1 : 0;
+}
+
@@ -0,0 +1,465 @@
+
+/*
+ * Description: A ring shared between exactly one producer thread and one
+ *              consumer thread.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 17:05:12 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+
+#include <sys/eventfd.h>
+
+#include "collections.h"
+
+/*
+ * Each side owns one cursor and only reads the other one. The producer
+ * writes at @tail and the consumer reads at @head, both running positions
+ * masked to index the slots. To avoid touching the other side cache line on
+ * every call, each one keeps the last value it saw from the other and only
+ * reloads it when the ring looks full (or empty).
+ *
+ * Slots are @slot_size bytes long and the buffer is aligned to a cache line,
+ * so a slot is always aligned enough to hold an object of that size.
+ */
+
+#define SPSC_RING_CACHE_LINE            64
+
+struct spsc_producer {
+    unsigned long       tail;           /* published to the consumer */
+    unsigned long       reserved;       /* next slot to be reserved */
+    unsigned long       head_cache;
+} __attribute__((aligned(SPSC_RING_CACHE_LINE)));
+
+struct spsc_consumer {
+    unsigned long       head;
+    unsigned long       tail_cache;
+    unsigned int        waiting;        /* blocked inside wait() */
+} __attribute__((aligned(SPSC_RING_CACHE_LINE)));
+
+#define cl_spsc_ring_members                                    \
+    cl_struct_member(struct spsc_producer, producer)            \
+    cl_struct_member(struct spsc_consumer, consumer)            \
+    cl_struct_member(unsigned char *, slots)                    \
+    cl_struct_member(unsigned long, mask)                       \
+    cl_struct_member(unsigned int, slot_size)                   \
+    cl_struct_member(int, efd)                                  \
+    cl_struct_member(struct cl_ref_s, ref)
+
+cl_struct_declare(spsc_ring_s, cl_spsc_ring_members);
+
+#define spsc_ring_s         cl_struct(spsc_ring_s)
+
+static void destroy_spsc_ring_s(const struct cl_ref_s *ref)
+{
+    spsc_ring_s *r = cl_container_of(ref, spsc_ring_s, ref);
+
+    if (NULL == r)
+        return;
+
+    if (r->efd >= 0)
+        close(r->efd);
+
+    if (r->slots != NULL)
+        free(r->slots);
+
+    free(r);
+    r = NULL;
+}
+
+static spsc_ring_s *new_spsc_ring_s(unsigned int capacity,
+    unsigned int slot_size, unsigned int flags)
+{
+    spsc_ring_s *r = NULL;
+    unsigned long size = 2;
+
+    if (posix_memalign((void **)&r, SPSC_RING_CACHE_LINE,
+                       sizeof(spsc_ring_s)) != 0)
+    {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    memset(r, 0, sizeof(spsc_ring_s));
+    r->efd = -1;
+
+    while (size < capacity)
+        size <<= 1;
+
+    if (posix_memalign((void **)&r->slots, SPSC_RING_CACHE_LINE,
+                       size * slot_size) != 0)
+    {
+        free(r);
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    if (flags & CL_SPSC_RING_EVENTFD) {
+        r->efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+        if (r->efd < 0) {
+            free(r->slots);
+            free(r);
+            cset_errno(CL_INVALID_STATE);
+            return NULL;
+        }
+    }
+
+    r->mask = size - 1;
+    r->slot_size = slot_size;
+    typeof_set(CL_OBJ_SPSC_RING, r);
+
+    /* Reference count */
+    r->ref.count = 1;
+    r->ref.free = destroy_spsc_ring_s;
+
+    return r;
+}
+
+static inline void *slot_at(spsc_ring_s *r, unsigned long pos)
+{
+    return r->slots + (pos & r->mask) * r->slot_size;
+}
+
+/* Producer side: the number of slots still free to be reserved */
+static unsigned long writable(spsc_ring_s *r)
+{
+    struct spsc_producer *p = &r->producer;
+    unsigned long capacity = r->mask + 1;
+
+    if (p->reserved - p->head_cache == capacity)
+        p->head_cache = __atomic_load_n(&r->consumer.head, __ATOMIC_ACQUIRE);
+
+    return capacity - (p->reserved - p->head_cache);
+}
+
+/* Consumer side: the number of committed elements not consumed yet */
+static unsigned long readable(spsc_ring_s *r)
+{
+    struct spsc_consumer *c = &r->consumer;
+
+    if (c->tail_cache == c->head)
+        c->tail_cache = __atomic_load_n(&r->producer.tail, __ATOMIC_ACQUIRE);
+
+    return c->tail_cache - c->head;
+}
+
+static unsigned int commit(spsc_ring_s *r)
+{
+    struct spsc_producer *p = &r->producer;
+    unsigned long n = p->reserved - p->tail;
+
+    if (n == 0)
+        return 0;
+
+    __atomic_store_n(&p->tail, p->reserved, __ATOMIC_RELEASE);
+
+    if (r->efd >= 0) {
+        /* Pairs with the fence of cl_spsc_ring_wait() */
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        if (__atomic_load_n(&r->consumer.waiting, __ATOMIC_RELAXED) != 0)
+            eventfd_write(r->efd, 1);
+    }
+
+    return n;
+}
+
+static void consume(spsc_ring_s *r, unsigned long count)
+{
+    __atomic_store_n(&r->consumer.head, r->consumer.head + count,
+                     __ATOMIC_RELEASE);
+}
+
+/* Returns how many milliseconds are left until @deadline, at least 0 */
+static int time_left(const struct timespec *deadline)
+{
+    struct timespec now;
+    long ms;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    ms = (deadline->tv_sec - now.tv_sec) * 1000 +
+         (deadline->tv_nsec - now.tv_nsec) / 1000000;
+
+    return (ms < 0) ? 0 : (int)ms;
+}
+
+/*
+ *
+ * API
+ *
+ */
+
+__PUB_API__ cl_spsc_ring_t *cl_spsc_ring_ref(cl_spsc_ring_t *ring)
+{
+    spsc_ring_s *r = (spsc_ring_s *)ring;
+
+    __clib_function_init__(true, ring, CL_OBJ_SPSC_RING, NULL);
+    cl_ref_inc(&r->ref);
+
+    return ring;
+}
+
+__PUB_API__ int cl_spsc_ring_unref(cl_spsc_ring_t *ring)
+{
+    spsc_ring_s *r = (spsc_ring_s *)ring;
+
+    __clib_function_init__(true, ring, CL_OBJ_SPSC_RING, -1);
+    cl_ref_dec(&r->ref);
+
+    return 0;
+}
+
+__PUB_API__ cl_spsc_ring_t *cl_spsc_ring_create(unsigned int capacity,
+    unsigned int slot_size, unsigned int flags)
+{
+    __clib_function_init__(false, NULL, -1, NULL);
+
+    if ((capacity == 0) || (capacity > (1U << 31)) || (slot_size == 0)) {
+        cset_errno(CL_INVALID_VALUE);
+        return NULL;
+    }
+
+    return new_spsc_ring_s(capacity, slot_size, flags);
+}
+
+__PUB_API__ int cl_spsc_ring_destroy(cl_spsc_ring_t *ring)
+{
+    return cl_spsc_ring_unref(ring);
+}
+
+__PUB_API__ void *cl_spsc_ring_reserve(cl_spsc_ring_t *ring)
+{
+    spsc_ring_s *r = (spsc_ring_s *)ring;
+
+    __clib_function_init__(true, ring, CL_OBJ_SPSC_RING, NULL);
+
+    if (writable(r) == 0)
+        return NULL;
+
+    return slot_at(r, r->producer.reserved++);
+}
+
+__PUB_API__ int cl_spsc_ring_commit(cl_spsc_ring_t *ring)
+{
+    spsc_ring_s *r = (spsc_ring_s *)ring;
+
+    __clib_function_init__(true, ring, CL_OBJ_SPSC_RING, -1);
+
+    return commit(r);
+}
+
+__PUB_API__ bool cl_spsc_ring_push(cl_spsc_ring_t *ring, const void *data)
+{
+    spsc_ring_s *r = (spsc_ring_s *)ring;
+
+    __clib_function_init__(true, ring, CL_OBJ_SPSC_RING, false);
+
+    if (NULL == data) {
+        cset_errno(CL_NULL_ARG);
+        return false;
+    }
+
+    if (writable(r) == 0)
+        return false;
+
+    memcpy(slot_at(r, r->producer.reserved++), data, r->slot_size);
+    commit(r);
+
+    return true;
+}
+
+__PUB_API__ void *cl_spsc_ring_front(cl_spsc_ring_t *ring)
+{
+    spsc_ring_s *r = (spsc_ring_s *)ring;
+
+    __clib_function_init__(true, ring, CL_OBJ_SPSC_RING, NULL);
+
+    if (readable(r) == 0)
+        return NULL;
+
+    return slot_at(r, r->consumer.head);
+}
+
+__PUB_API__ int cl_spsc_ring_consume(cl_spsc_ring_t *ring)
+{
+    spsc_ring_s *r = (spsc_ring_s *)ring;
+
+    __clib_function_init__(true, ring, CL_OBJ_SPSC_RING, -1);
+
+    if (readable(r) == 0) {
+        cset_errno(CL_INVALID_STATE);
+        return -1;
+    }
+
+    consume(r, 1);
+
+    return 0;
+}
+
+__PUB_API__ bool cl_spsc_ring_pop(cl_spsc_ring_t *ring, void *data)
+{
+    spsc_ring_s *r = (spsc_ring_s *)ring;
+
+    __clib_function_init__(true, ring, CL_OBJ_SPSC_RING, false);
+
+    if (NULL == data) {
+        cset_errno(CL_NULL_ARG);
+        return false;
+    }
+
+    if (readable(r) == 0)
+        return false;
+
+    memcpy(data, slot_at(r, r->consumer.head), r->slot_size);
+    consume(r, 1);
+
+    return true;
+}
+
+__PUB_API__ int cl_spsc_ring_pop_batch(cl_spsc_ring_t *ring, void *data,
+    unsigned int count)
+{
+    spsc_ring_s *r = (spsc_ring_s *)ring;
+    unsigned long n, first;
+
+    __clib_function_init__(true, ring, CL_OBJ_SPSC_RING, -1);
+
+    if (NULL == data) {
+        cset_errno(CL_NULL_ARG);
+        return -1;
+    }
+
+    n = readable(r);
+
+    if (n > count)
+        n = count;
+
+    if (n == 0)
+        return 0;
+
+    /* At most two copies, when the elements wrap around the ring end */
+    first = (r->mask + 1) - (r->consumer.head & r->mask);
+
+    if (first > n)
+        first = n;
+
+    memcpy(data, slot_at(r, r->consumer.head), first * r->slot_size);
+
+    if (first < n) {
+        memcpy((unsigned char *)data + first * r->slot_size, r->slots,
+               (n - first) * r->slot_size);
+    }
+
+    consume(r, n);
+
+    return (int)n;
+}
+
+__PUB_API__ int cl_spsc_ring_wait(cl_spsc_ring_t *ring, int timeout)
+{
+    spsc_ring_s *r = (spsc_ring_s *)ring;
+    struct timespec deadline;
+    struct pollfd pfd;
+    eventfd_t value;
+    int ret = 0;
+
+    __clib_function_init__(true, ring, CL_OBJ_SPSC_RING, -1);
+
+    if (r->efd < 0) {
+        cset_errno(CL_INVALID_STATE);
+        return -1;
+    }
+
+    if (readable(r) > 0)
+        return 0;
+
+    if (timeout > 0) {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec += timeout / 1000;
+        deadline.tv_nsec += (long)(timeout % 1000) * 1000000;
+
+        if (deadline.tv_nsec >= 1000000000) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+    }
+
+    __atomic_store_n(&r->consumer.waiting, 1, __ATOMIC_RELAXED);
+
+    /* Pairs with the fence of commit() */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    /*
+     * The eventfd counter may hold wake ups from an earlier wait, so the
+     * ring is always checked again after reading it.
+     */
+    while (readable(r) == 0) {
+        pfd.fd = r->efd;
+        pfd.events = POLLIN;
+        ret = poll(&pfd, 1, (timeout > 0) ? time_left(&deadline) : timeout);
+
+        if (ret == 0)
+            break;
+
+        if ((ret < 0) && (errno != EINTR))
+            break;
+
+        eventfd_read(r->efd, &value);
+    }
+
+    __atomic_store_n(&r->consumer.waiting, 0, __ATOMIC_RELAXED);
+
+    if (readable(r) > 0)
+        return 0;
+
+    cset_errno((ret == 0) ? CL_ENDED_WITH_TIMEOUT : CL_INVALID_STATE);
+
+    return -1;
+}
+
+__PUB_API__ int cl_spsc_ring_size(cl_spsc_ring_t *ring)
+{
+    spsc_ring_s *r = (spsc_ring_s *)ring;
+    unsigned long head, tail;
+
+    __clib_function_init__(true, ring, CL_OBJ_SPSC_RING, -1);
+    head = __atomic_load_n(&r->consumer.head, __ATOMIC_RELAXED);
+    tail = __atomic_load_n(&r->producer.tail, __ATOMIC_RELAXED);
+
+    /* Both are read apart, so the head may be already ahead */
+    if ((long)(tail - head) < 0)
+        return 0;
+
+    return (int)(tail - head);
+}
+
+__PUB_API__ bool cl_spsc_ring_is_empty(cl_spsc_ring_t *ring)
+{
+    return (cl_spsc_ring_size(ring) == 0) ? true : false;
+}
+
@@ -57,7 +57,16 @@ __PUB_API__ cl_stack_t *cl_stack_create(void (*free_data)(void *),
     int (*equals)(cl_stack_node_t *, cl_stack_node_t *))
 {
     return (cl_stack_t *)cglist_create(CL_OBJ_STACK, free_data, compare_to,
-                                       filter, equals);
+                                       filter, equals, 0);
+}
+
+__PUB_API__ cl_stack_t *cl_stack_create_ex(void (*free_data)(void *),
+    int (*compare_to)(cl_stack_node_t *, cl_stack_node_t *),
+    int (*filter)(cl_stack_node_t *, void *),
+    int (*equals)(cl_stack_node_t *, cl_stack_node_t *), unsigned int flags)
+{
+    return (cl_stack_t *)cglist_create(CL_OBJ_STACK, free_data, compare_to,
+                                       filter, equals, flags);
 }
 
 __PUB_API__ int cl_stack_destroy(cl_stack_t *stack)
@@ -196,3 +205,9 @@ __PUB_API__ int cl_stack_set_equals(const cl_stack_t *stack,
     return cglist_set_equals((cl_stack_t *)stack, CL_OBJ_STACK, equals);
 }
 
+__PUB_API__ int cl_stack_pool_stats(const cl_stack_t *stack,
+    struct cl_list_pool_stats_s *stats)
+{
+    return cglist_pool_stats(stack, CL_OBJ_STACK, stats);
+}
+
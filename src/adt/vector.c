@@ -0,0 +1,754 @@
+
+/*
+ * Description: Growable arrays.
+ *
+ * Author: Rodrigo Freitas
+ * Created at: Sat Oct 17 19:02:48 2026
+ * Project: libcollections
+ *
+ * Copyright (C) 2026 Rodrigo Freitas All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ * USA
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <pthread.h>
+
+#include "collections.h"
+
+/* Room allocated by the first insertion */
+#define VECTOR_INITIAL_CAPACITY         16
+
+/* Partitions this small are sorted by insertion */
+#define VECTOR_INSERTION_SORT_SIZE      16
+
+/*
+ * The array holds pointers to list nodes, so the callbacks written for lists
+ * work unchanged and nodes handed out to the user may outlive their place in
+ * the vector.
+ */
+#define cl_vector_members                                   \
+    cl_struct_member(void **, nodes)                        \
+    cl_struct_member(unsigned int, size)                    \
+    cl_struct_member(unsigned int, capacity)                \
+    cl_struct_member(void, (*free_data)(void *))            \
+    cl_struct_member(int, (*compare_to)(void *, void *))    \
+    cl_struct_member(int, (*filter)(void *, void *))        \
+    cl_struct_member(int, (*equals)(void *, void *))        \
+    cl_struct_member(struct cl_ref_s, ref)                  \
+    cl_struct_member(pthread_mutex_t, lock)
+
+cl_struct_declare(vector_s, cl_vector_members);
+
+#define vector_s        cl_struct(vector_s)
+
+/*
+ * Checks if we're holding cobjects inside the vector. Returns true if does.
+ */
+static bool is_vector_of_cobjects(const vector_s *v)
+{
+    if (v->size == 0)
+        return false;
+
+    return cglist_node_holds_cobject(v->nodes[0]);
+}
+
+/* Makes sure the array has room for at least @capacity nodes */
+static int grow(vector_s *v, unsigned int capacity)
+{
+    void **nodes;
+    unsigned int n;
+
+    if (capacity <= v->capacity)
+        return 0;
+
+    n = (v->capacity == 0) ? VECTOR_INITIAL_CAPACITY : v->capacity;
+
+    while ((n < capacity) && (n < (1U << 31)))
+        n <<= 1;
+
+    if (n < capacity)
+        n = capacity;
+
+    nodes = realloc(v->nodes, (size_t)n * sizeof(void *));
+
+    if (NULL == nodes) {
+        cset_errno(CL_NO_MEM);
+        return -1;
+    }
+
+    v->nodes = nodes;
+    v->capacity = n;
+
+    return 0;
+}
+
+/*
+ * Room is made before the node is created, so a failure leaves the content
+ * with the caller.
+ */
+static int insert_node(vector_s *v, unsigned int index, const void *content,
+    unsigned int size)
+{
+    void *node;
+
+    if (grow(v, v->size + 1) < 0)
+        return -1;
+
+    node = cglist_node_create(content, size, v->free_data, CL_OBJ_LIST_NODE);
+
+    if (NULL == node)
+        return -1;
+
+    if (index < v->size) {
+        memmove(&v->nodes[index + 1], &v->nodes[index],
+                (v->size - index) * sizeof(void *));
+    }
+
+    v->nodes[index] = node;
+    v->size++;
+
+    return 0;
+}
+
+static void *remove_node(vector_s *v, unsigned int index)
+{
+    void *node = v->nodes[index];
+
+    v->size--;
+
+    if (index < v->size) {
+        memmove(&v->nodes[index], &v->nodes[index + 1],
+                (v->size - index) * sizeof(void *));
+    }
+
+    return node;
+}
+
+/*
+ *
+ * Sorting.
+ *
+ */
+
+static inline void swap_nodes(void **a, void **b)
+{
+    void *tmp = *a;
+
+    *a = *b;
+    *b = tmp;
+}
+
+static void insertion_sort(void **v, unsigned int n,
+    int (*cmp)(void *, void *))
+{
+    void *tmp;
+    unsigned int i, j;
+
+    for (i = 1; i < n; i++) {
+        tmp = v[i];
+
+        for (j = i; (j > 0) && (cmp(tmp, v[j - 1]) < 0); j--)
+            v[j] = v[j - 1];
+
+        v[j] = tmp;
+    }
+}
+
+static void sift_down(void **v, unsigned int root, unsigned int n,
+    int (*cmp)(void *, void *))
+{
+    unsigned int child;
+
+    while ((child = 2 * root + 1) < n) {
+        if ((child + 1 < n) && (cmp(v[child], v[child + 1]) < 0))
+            child++;
+
+        if (cmp(v[root], v[child]) >= 0)
+            return;
+
+        swap_nodes(&v[root], &v[child]);
+        root = child;
+    }
+}
+
+static void heap_sort(void **v, unsigned int n,
+    int (*cmp)(void *, void *))
+{
+    unsigned int i;
+
+    for (i = n / 2; i-- > 0; )
+        sift_down(v, i, n, cmp);
+
+    for (i = n - 1; i > 0; i--) {
+        swap_nodes(&v[0], &v[i]);
+        sift_down(v, 0, i, cmp);
+    }
+}
+
+/*
+ * Moves the median of the first, middle and last nodes to the first
+ * position and partitions the rest around it. Returns the pivot final
+ * position.
+ */
+static unsigned int partition(void **v, unsigned int n,
+    int (*cmp)(void *, void *))
+{
+    unsigned int i = 0, j = n, mid = n / 2;
+
+    if (cmp(v[mid], v[0]) < 0)
+        swap_nodes(&v[mid], &v[0]);
+
+    if (cmp(v[n - 1], v[mid]) < 0) {
+        swap_nodes(&v[n - 1], &v[mid]);
+
+        if (cmp(v[mid], v[0]) < 0)
+            swap_nodes(&v[mid], &v[0]);
+    }
+
+    swap_nodes(&v[0], &v[mid]);
+
+    /* Stopping on equal nodes keeps runs of them balanced */
+    while (1) {
+        do {
+            i++;
+        } while ((i < n) && (cmp(v[i], v[0]) < 0));
+
+        do {
+            j--;
+        } while (cmp(v[j], v[0]) > 0);
+
+        if (i >= j)
+            break;
+
+        swap_nodes(&v[i], &v[j]);
+    }
+
+    swap_nodes(&v[0], &v[j]);
+
+    return j;
+}
+
+/*
+ * Quicksort that gives up on partitions going too deep and sorts them with
+ * a heapsort, so it never goes quadratic.
+ */
+static void introsort(void **v, unsigned int n, unsigned int depth,
+    int (*cmp)(void *, void *))
+{
+    unsigned int p;
+
+    while (n > VECTOR_INSERTION_SORT_SIZE) {
+        if (depth == 0) {
+            heap_sort(v, n, cmp);
+            return;
+        }
+
+        depth--;
+        p = partition(v, n, cmp);
+
+        /* Recurses into the smaller side only, to bound the stack */
+        if (p < n - p - 1) {
+            introsort(v, p, depth, cmp);
+            v += p + 1;
+            n -= p + 1;
+        } else {
+            introsort(v + p + 1, n - p - 1, depth, cmp);
+            n = p;
+        }
+    }
+
+    insertion_sort(v, n, cmp);
+}
+
+static void destroy_vector(const struct cl_ref_s *ref)
+{
+    vector_s *v = cl_container_of(ref, vector_s, ref);
+    unsigned int i;
+
+    if (NULL == v)
+        return;
+
+    for (i = 0; i < v->size; i++)
+        cglist_node_unref(v->nodes[i], CL_OBJ_LIST_NODE);
+
+    if (v->nodes != NULL)
+        free(v->nodes);
+
+    pthread_mutex_destroy(&v->lock);
+    free(v);
+    v = NULL;
+}
+
+static vector_s *new_vector(void (*free_data)(void *),
+    int (*compare_to)(void *, void *), int (*filter)(void *, void *),
+    int (*equals)(void *, void *))
+{
+    vector_s *v = NULL;
+
+    v = calloc(1, sizeof(vector_s));
+
+    if (NULL == v) {
+        cset_errno(CL_NO_MEM);
+        return NULL;
+    }
+
+    v->free_data = free_data;
+    v->compare_to = compare_to;
+    v->filter = filter;
+    v->equals = equals;
+    pthread_mutex_init(&v->lock, NULL);
+    typeof_set(CL_OBJ_VECTOR, v);
+
+    v->ref.free = destroy_vector;
+    v->ref.count = 1;
+
+    return v;
+}
+
+/*
+ *
+ * API
+ *
+ */
+
+__PUB_API__ cl_vector_t *cl_vector_ref(cl_vector_t *vector)
+{
+    vector_s *v = (vector_s *)vector;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, NULL);
+    cl_ref_inc(&v->ref);
+
+    return vector;
+}
+
+__PUB_API__ int cl_vector_unref(cl_vector_t *vector)
+{
+    vector_s *v = (vector_s *)vector;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, -1);
+    cl_ref_dec(&v->ref);
+
+    return 0;
+}
+
+__PUB_API__ cl_vector_t *cl_vector_create(void (*free_data)(void *),
+    int (*compare_to)(cl_list_node_t *, cl_list_node_t *),
+    int (*filter)(cl_list_node_t *, void *),
+    int (*equals)(cl_list_node_t *, cl_list_node_t *))
+{
+    __clib_function_init__(false, NULL, -1, NULL);
+
+    return new_vector(free_data, compare_to, filter, equals);
+}
+
+__PUB_API__ int cl_vector_destroy(cl_vector_t *vector)
+{
+    return cl_vector_unref(vector);
+}
+
+__PUB_API__ int cl_vector_size(const cl_vector_t *vector)
+{
+    vector_s *v = (vector_s *)vector;
+    int size;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, -1);
+    pthread_mutex_lock(&v->lock);
+    size = (int)v->size;
+    pthread_mutex_unlock(&v->lock);
+
+    return size;
+}
+
+__PUB_API__ int cl_vector_reserve(cl_vector_t *vector, unsigned int capacity)
+{
+    vector_s *v = (vector_s *)vector;
+    int ret;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, -1);
+    pthread_mutex_lock(&v->lock);
+    ret = grow(v, capacity);
+    pthread_mutex_unlock(&v->lock);
+
+    return ret;
+}
+
+__PUB_API__ int cl_vector_push(cl_vector_t *vector, const void *node_content,
+    unsigned int size)
+{
+    vector_s *v = (vector_s *)vector;
+    int ret;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, -1);
+    pthread_mutex_lock(&v->lock);
+    ret = insert_node(v, v->size, node_content, size);
+    pthread_mutex_unlock(&v->lock);
+
+    return ret;
+}
+
+__PUB_API__ cl_list_node_t *cl_vector_pop(cl_vector_t *vector)
+{
+    vector_s *v = (vector_s *)vector;
+    void *node = NULL;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, NULL);
+    pthread_mutex_lock(&v->lock);
+
+    if (v->size > 0)
+        node = remove_node(v, v->size - 1);
+
+    pthread_mutex_unlock(&v->lock);
+
+    return node;
+}
+
+__PUB_API__ int cl_vector_insert(cl_vector_t *vector, unsigned int index,
+    const void *node_content, unsigned int size)
+{
+    vector_s *v = (vector_s *)vector;
+    int ret = -1;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, -1);
+    pthread_mutex_lock(&v->lock);
+
+    if (index <= v->size)
+        ret = insert_node(v, index, node_content, size);
+
+    pthread_mutex_unlock(&v->lock);
+
+    if ((ret < 0) && (cl_get_last_error() == CL_NO_ERROR))
+        cset_errno(CL_NUMBER_RANGE);
+
+    return ret;
+}
+
+__PUB_API__ int cl_vector_replace(cl_vector_t *vector, unsigned int index,
+    const void *node_content, unsigned int size)
+{
+    vector_s *v = (vector_s *)vector;
+    void *node, *old = NULL;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, -1);
+    node = cglist_node_create(node_content, size, v->free_data,
+                              CL_OBJ_LIST_NODE);
+
+    if (NULL == node)
+        return -1;
+
+    pthread_mutex_lock(&v->lock);
+
+    if (index < v->size) {
+        old = v->nodes[index];
+        v->nodes[index] = node;
+    }
+
+    pthread_mutex_unlock(&v->lock);
+
+    if (NULL == old) {
+        cglist_node_discard(node);
+        cset_errno(CL_NUMBER_RANGE);
+        return -1;
+    }
+
+    /* Released outside the lock, since it may call back into the user */
+    cglist_node_unref(old, CL_OBJ_LIST_NODE);
+
+    return 0;
+}
+
+__PUB_API__ cl_list_node_t *cl_vector_at(const cl_vector_t *vector,
+    unsigned int index)
+{
+    vector_s *v = (vector_s *)vector;
+    void *node = NULL;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, NULL);
+    pthread_mutex_lock(&v->lock);
+
+    if (index < v->size)
+        node = cglist_node_ref(v->nodes[index], CL_OBJ_LIST_NODE);
+
+    pthread_mutex_unlock(&v->lock);
+
+    if (NULL == node)
+        cset_errno(CL_NUMBER_RANGE);
+
+    return node;
+}
+
+__PUB_API__ int cl_vector_delete_indexed(cl_vector_t *vector,
+    unsigned int index)
+{
+    vector_s *v = (vector_s *)vector;
+    void *node = NULL;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, -1);
+    pthread_mutex_lock(&v->lock);
+
+    if (index < v->size)
+        node = remove_node(v, index);
+
+    pthread_mutex_unlock(&v->lock);
+
+    if (NULL == node) {
+        cset_errno(CL_NUMBER_RANGE);
+        return -1;
+    }
+
+    /* Released outside the lock, since it may call back into the user */
+    cglist_node_unref(node, CL_OBJ_LIST_NODE);
+
+    return 0;
+}
+
+__PUB_API__ cl_list_node_t *cl_vector_map(const cl_vector_t *vector,
+    int (*foo)(cl_list_node_t *, void *), void *data)
+{
+    vector_s *v = (vector_s *)vector;
+    void *node = NULL;
+    unsigned int i;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, NULL);
+
+    if (NULL == foo) {
+        cset_errno(CL_NULL_ARG);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&v->lock);
+
+    for (i = 0; i < v->size; i++) {
+        if (foo(v->nodes[i], data) != 0) {
+            node = cglist_node_ref(v->nodes[i], CL_OBJ_LIST_NODE);
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&v->lock);
+
+    return node;
+}
+
+__PUB_API__ cl_vector_t *cl_vector_filter(cl_vector_t *vector, void *data)
+{
+    vector_s *v = (vector_s *)vector, *f = NULL;
+    unsigned int i, kept = 0;
+    bool stop = false;
+    int ret;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, NULL);
+
+    if (NULL == v->filter) {
+        cset_errno(CL_NULL_DATA);
+        return NULL;
+    }
+
+    f = new_vector(v->free_data, v->compare_to, v->filter, v->equals);
+
+    if (NULL == f)
+        return NULL;
+
+    pthread_mutex_lock(&v->lock);
+
+    /* Room for every node up front, so extracting one can't fail */
+    if (grow(f, v->size) < 0) {
+        pthread_mutex_unlock(&v->lock);
+        cl_vector_destroy(f);
+        return NULL;
+    }
+
+    /* Extracted nodes move to the new vector and the others are compacted */
+    for (i = 0; i < v->size; i++) {
+        ret = (stop == true) ? 0 : v->filter(v->nodes[i], data);
+
+        if (ret == 0) {
+            v->nodes[kept++] = v->nodes[i];
+            continue;
+        }
+
+        f->nodes[f->size++] = v->nodes[i];
+
+        if (ret < 0)
+            stop = true;
+    }
+
+    v->size = kept;
+    pthread_mutex_unlock(&v->lock);
+
+    return f;
+}
+
+__PUB_API__ int cl_vector_sort(cl_vector_t *vector)
+{
+    vector_s *v = (vector_s *)vector;
+    unsigned int n, depth = 0;
+    bool vector_of_cobjects;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, -1);
+    pthread_mutex_lock(&v->lock);
+    vector_of_cobjects = is_vector_of_cobjects(v);
+
+    if ((vector_of_cobjects == false) && (NULL == v->compare_to)) {
+        pthread_mutex_unlock(&v->lock);
+        cset_errno(CL_NULL_DATA);
+        return -1;
+    }
+
+    for (n = v->size; n > 1; n >>= 1)
+        depth += 2;
+
+    introsort(v->nodes, v->size, depth,
+              (vector_of_cobjects == true) ? cglist_compare_cobjects
+                                           : v->compare_to);
+
+    pthread_mutex_unlock(&v->lock);
+
+    return 0;
+}
+
+__PUB_API__ int cl_vector_search(const cl_vector_t *vector, void *element,
+    unsigned int size)
+{
+    vector_s *v = (vector_s *)vector;
+    int (*cmp)(void *, void *);
+    unsigned int lo = 0, hi, mid;
+    void *key;
+    int idx = -1;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, -1);
+    key = cglist_node_create(element, size, NULL, CL_OBJ_LIST_NODE);
+
+    if (NULL == key)
+        return -1;
+
+    pthread_mutex_lock(&v->lock);
+    cmp = (is_vector_of_cobjects(v) == true) ? cglist_compare_cobjects
+                                             : v->compare_to;
+
+    if (NULL == cmp) {
+        pthread_mutex_unlock(&v->lock);
+        cglist_node_discard(key);
+        cset_errno(CL_NULL_DATA);
+        return -1;
+    }
+
+    /* Looks for the first node not less than the key */
+    hi = v->size;
+
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+
+        if (cmp(v->nodes[mid], key) < 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    if ((lo < v->size) && (cmp(v->nodes[lo], key) == 0))
+        idx = (int)lo;
+
+    pthread_mutex_unlock(&v->lock);
+    cglist_node_discard(key);
+
+    return idx;
+}
+
+__PUB_API__ int cl_vector_indexof(const cl_vector_t *vector, void *element,
+    unsigned int size)
+{
+    vector_s *v = (vector_s *)vector;
+    int (*equals)(void *, void *);
+    unsigned int i;
+    void *key;
+    int idx = -1;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, -1);
+    key = cglist_node_create(element, size, NULL, CL_OBJ_LIST_NODE);
+
+    if (NULL == key)
+        return -1;
+
+    pthread_mutex_lock(&v->lock);
+    equals = (is_vector_of_cobjects(v) == true) ? cglist_cobjects_are_equal
+                                                : v->equals;
+
+    if (NULL == equals) {
+        pthread_mutex_unlock(&v->lock);
+        cglist_node_discard(key);
+        cset_errno(CL_NULL_DATA);
+        return -1;
+    }
+
+    for (i = 0; i < v->size; i++) {
+        if (equals(v->nodes[i], key) > 0) {
+            idx = (int)i;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&v->lock);
+    cglist_node_discard(key);
+
+    return idx;
+}
+
+__PUB_API__ bool cl_vector_contains(const cl_vector_t *vector, void *element,
+    unsigned int size)
+{
+    return (cl_vector_indexof(vector, element, size) >= 0) ? true : false;
+}
+
+__PUB_API__ bool cl_vector_is_empty(const cl_vector_t *vector)
+{
+    return (cl_vector_size(vector) == 0) ? true : false;
+}
+
+__PUB_API__ int cl_vector_set_compare_to(const cl_vector_t *vector,
+    int (*compare_to)(cl_list_node_t *, cl_list_node_t *))
+{
+    vector_s *v = (vector_s *)vector;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, -1);
+    v->compare_to = compare_to;
+
+    return 0;
+}
+
+__PUB_API__ int cl_vector_set_filter(const cl_vector_t *vector,
+    int (*filter)(cl_list_node_t *, void *))
+{
+    vector_s *v = (vector_s *)vector;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, -1);
+    v->filter = filter;
+
+    return 0;
+}
+
+__PUB_API__ int cl_vector_set_equals(const cl_vector_t *vector,
+    int (*equals)(cl_list_node_t *, cl_list_node_t *))
+{
+    vector_s *v = (vector_s *)vector;
+
+    __clib_function_init__(true, vector, CL_OBJ_VECTOR, -1);
+    v->equals = equals;
+
+    return 0;
+}
+
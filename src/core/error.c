@@ -82,7 +82,7 @@ static const char *__cdescriptions[] = {
     cl_tr_noop("Data convertion failed"),
     cl_tr_noop("The library was not initialized"),
     cl_tr_noop("Failed creating directory"),
-    cl_tr_noop("A collision inside the hashtable just happened"),
+    cl_tr_noop("The key already exists inside the hashtable"),
     cl_tr_noop("Unsupported RAW image"),
     cl_tr_noop("Unable to load image"),
     cl_tr_noop("Unable to create temporary internal image"),
@@ -173,3 +173,32 @@ __PUB_API__ void cl_exit(void)
 #endif
 }
 
+/*
+ * FNV-1a over the key bytes followed by the murmur3 finalizer, so every bit
+ * of the key affects both the low and the high bits of the result.
+ */
+uint64_t bytes_hash(const void *key, size_t size)
+{
+    const unsigned char *p = key;
+    uint64_t h = 0xcbf29ce484222325ULL;
+    size_t i;
+
+    for (i = 0; i < size; i++) {
+        h ^= p[i];
+        h *= 0x100000001b3ULL;
+    }
+
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+
+    return h;
+}
+
+uint64_t string_hash(const char *key)
+{
+    return bytes_hash(key, strlen(key));
+}
+
@@ -44,7 +44,7 @@ typedef struct cl_json_s {
     enum cl_json_type       type;
     cl_string_t             *name;
     cl_string_t             *value;
-    void                    *child;
+    struct cdll_head        child;
 } cl_json_s;
 
 #define CL_JSON_OBJECT_OFFSET         \
@@ -94,7 +94,7 @@ static cl_json_s *cl_json_new(void)
         return NULL;
     }
 
-    j->child = NULL;
+    cdll_init(&j->child);
     typeof_set_with_offset(CL_OBJ_JSON, j, CL_JSON_OBJECT_OFFSET);
 
     return j;
@@ -120,10 +120,8 @@ static void __cl_json_delete(void *a)
 {
     cl_json_s *c = (cl_json_s *)a;
 
-    if (!(c->type & CL_JSON_IS_REFERENCE) && c->child) {
-        cl_dll_free(c->child, __cl_json_delete);
-        c->child = NULL;
-    }
+    if (!(c->type & CL_JSON_IS_REFERENCE))
+        cdll_free(&c->child, __cl_json_delete);
 
     if (!(c->type & CL_JSON_IS_REFERENCE) && c->value) {
         cl_string_destroy(c->value);
@@ -422,7 +420,7 @@ static const char *parse_array(cl_json_s *j, const char *s)
         return NULL;
     }
 
-    j->child = cl_dll_unshift(j->child, n);
+    cdll_unshift(&j->child, n);
 
     while (*s == ',') {
         n = cl_json_new();
@@ -438,7 +436,7 @@ static const char *parse_array(cl_json_s *j, const char *s)
             return NULL;
         }
 
-        j->child = cl_dll_unshift(j->child, n);
+        cdll_unshift(&j->child, n);
     }
 
     if (*s == ']')
@@ -493,7 +491,7 @@ static const char *parse_object(cl_json_s *j, const char *s)
         return NULL;
     }
 
-    j->child = cl_dll_unshift(j->child, n);
+    cdll_unshift(&j->child, n);
 
     while (*s == ',') {
         n = cl_json_new();
@@ -525,7 +523,7 @@ static const char *parse_object(cl_json_s *j, const char *s)
             return NULL;
         }
 
-        j->child = cl_dll_unshift(j->child, n);
+        cdll_unshift(&j->child, n);
     }
 
     if (*s == '}')
@@ -680,7 +678,7 @@ __PUB_API__ void cl_json_delete(cl_json_t *j)
         return;
     }
 
-    cl_dll_free(c->child, __cl_json_delete);
+    cdll_free(&c->child, __cl_json_delete);
 
     if (!(c->type & CL_JSON_IS_REFERENCE) && c->value) {
         cl_string_destroy(c->value);
@@ -705,7 +703,7 @@ __PUB_API__ int cl_json_get_array_size(const cl_json_t *array)
     if (p->type != CL_JSON_ARRAY)
         return -1;
 
-    return cl_dll_size(p->child);
+    return cdll_size(&p->child);
 }
 
 __PUB_API__ cl_json_t *cl_json_get_array_item(const cl_json_t *array,
@@ -722,7 +720,7 @@ __PUB_API__ cl_json_t *cl_json_get_array_item(const cl_json_t *array,
     if ((size < 0) || ((int)item >= size))
         return NULL;
 
-    n = cl_dll_at(p->child, item);
+    n = cdll_at(&p->child, item);
 
     return n;
 }
@@ -752,7 +750,7 @@ __PUB_API__ cl_json_t *cl_json_get_array_item_by_name(const cl_json_t *array,
     if (size <= 0)
         return NULL;
 
-    n = cl_dll_map(p->child, find_object, (char *)name);
+    n = cl_dll_map(p->child.first, find_object, (char *)name);
 
     return n;
 }
@@ -770,7 +768,7 @@ __PUB_API__ cl_json_t *cl_json_get_object_item(const cl_json_t *json,
         return NULL;
     }
 
-    p = cl_dll_map(root->child, find_object, (char *)name);
+    p = cl_dll_map(root->child.first, find_object, (char *)name);
 
     return p;
 }
@@ -813,10 +811,8 @@ static int __cl_json_dup(void *a, void *b)
     p = __dup(node);
     p->type = node->type & (~CL_JSON_IS_REFERENCE);
 
-    if (node->child != NULL)
-        cl_dll_map(node->child, __cl_json_dup, p);
-
-    list->child = cl_dll_unshift(list->child, p);
+    cl_dll_map(node->child.first, __cl_json_dup, p);
+    cdll_unshift(&list->child, p);
 
     return 0;
 }
@@ -831,7 +827,7 @@ __PUB_API__ cl_json_t *cl_json_dup(const cl_json_t *root)
 
     l = __dup(r);
     l->type = r->type & (~CL_JSON_IS_REFERENCE);
-    cl_dll_map(r->child, __cl_json_dup, l);
+    cl_dll_map(r->child.first, __cl_json_dup, l);
 
     return l;
 }
@@ -1008,7 +1004,7 @@ __PUB_API__ cl_json_t *cl_json_create_int_array(const int *values, int size)
         if (NULL == n)
             return NULL;
 
-        a->child = cl_dll_unshift(a->child, n);
+        cdll_unshift(&a->child, n);
     }
 
     return a;
@@ -1031,7 +1027,7 @@ __PUB_API__ cl_json_t *cl_json_create_float_array(const float *values, int size)
         if (NULL == n)
             return NULL;
 
-        a->child = cl_dll_unshift(a->child, n);
+        cdll_unshift(&a->child, n);
     }
 
     return a;
@@ -1057,7 +1053,7 @@ __PUB_API__ cl_json_t *cl_json_create_string_array(const cl_stringlist_t *values
         if (NULL == n)
             return NULL;
 
-        a->child = cl_dll_unshift(a->child, n);
+        cdll_unshift(&a->child, n);
     }
 
     return a;
@@ -1078,7 +1074,7 @@ __PUB_API__ int cl_json_add_item_to_array(cl_json_t *array, const cl_json_t *ite
         return -1;
     }
 
-    a->child = cl_dll_unshift(a->child, n);
+    cdll_unshift(&a->child, n);
 
     return 0;
 }
@@ -1108,7 +1104,7 @@ __PUB_API__ int cl_json_add_item_to_object(cl_json_t *root, const char *name,
         cl_string_destroy(n->name);
 
     n->name = cl_string_create("%s", name);
-    r->child = cl_dll_unshift(r->child, n);
+    cdll_unshift(&r->child, n);
 
     return 0;
 }
@@ -1177,7 +1173,7 @@ __PUB_API__ int cl_json_delete_item_from_array(cl_json_t *array,
     if ((size < 0) || ((int)index >= size))
         return -1;
 
-    p = cl_dll_delete_indexed(&root, index, NULL);
+    p = cdll_delete_indexed(&root->child, index);
 
     if (NULL == p)
         return -1;
@@ -1190,7 +1186,8 @@ __PUB_API__ int cl_json_delete_item_from_array(cl_json_t *array,
 __PUB_API__ int cl_json_delete_item_from_array_by_name(const cl_json_t *array,
     const char *name)
 {
-    cl_json_s *p = (cl_json_s *)array, *n;
+    cl_json_s *p = (cl_json_s *)array;
+    struct cdll_head extracted;
     int size;
 
     __clib_function_init_ex__(true, array, CL_OBJ_JSON, CL_JSON_OBJECT_OFFSET,
@@ -1201,20 +1198,22 @@ __PUB_API__ int cl_json_delete_item_from_array_by_name(const cl_json_t *array,
     if (size <= 0)
         return -1;
 
-    n = cl_dll_filter(p->child, find_object, (char *)name);
+    cdll_init(&extracted);
+    cdll_filter(&p->child, &extracted, find_object, (char *)name);
 
-    if (n != NULL) {
-        cl_json_delete(n);
-        return 0;
-    }
+    if (cdll_size(&extracted) == 0)
+        return -1;
+
+    cdll_free(&extracted, __cl_json_delete);
 
-    return -1;
+    return 0;
 }
 
 __PUB_API__ int cl_json_delete_item_from_object(cl_json_t *json,
     const char *name)
 {
-    cl_json_s *p = NULL, *root = (cl_json_s *)json;
+    cl_json_s *root = (cl_json_s *)json;
+    struct cdll_head extracted;
 
     __clib_function_init_ex__(true, json, CL_OBJ_JSON,
                               CL_JSON_OBJECT_OFFSET, -1);
@@ -1224,12 +1223,13 @@ __PUB_API__ int cl_json_delete_item_from_object(cl_json_t *json,
         return -1;
     }
 
-    p = cl_dll_filter(&root->child, find_object, (char *)name);
+    cdll_init(&extracted);
+    cdll_filter(&root->child, &extracted, find_object, (char *)name);
 
-    if (NULL == p)
+    if (cdll_size(&extracted) == 0)
         return -1;
 
-    cl_json_delete(p);
+    cdll_free(&extracted, __cl_json_delete);
 
     return 0;
 }
@@ -1238,7 +1238,8 @@ __PUB_API__ int cl_json_replace_item_in_array(cl_json_t *array,
     unsigned int index, cl_json_t *new_item)
 {
     cl_json_s *a = (cl_json_s *)array;
-    cl_json_s *p = NULL, *n;
+    cl_json_s *n;
+    struct cdll_head p;
     unsigned int i = 0;
 
     __clib_function_init__(false, NULL, -1, -1);
@@ -1251,24 +1252,23 @@ __PUB_API__ int cl_json_replace_item_in_array(cl_json_t *array,
         return -1;
     }
 
-    if (index >= (unsigned int)cl_dll_size(a->child)) {
+    if (index >= cdll_size(&a->child)) {
         return -1;
     }
 
-    while (a->child) {
-        n = cl_dll_pop(&a->child);
+    cdll_init(&p);
 
+    while ((n = cdll_pop(&a->child)) != NULL) {
         if (i == index) {
             cl_json_delete(n);
             n = new_item;
         }
 
-        p = cl_dll_unshift(p, n);
+        cdll_unshift(&p, n);
         i++;
     }
 
-    if (p != NULL)
-        a->child = p;
+    cdll_move(&p, &a->child);
 
     return 0;
 }
@@ -1278,7 +1278,8 @@ __PUB_API__ int cl_json_replace_item_in_object(cl_json_t *root,
 {
     cl_string_t *tmp = NULL;
     cl_json_s *a = (cl_json_s *)root;
-    cl_json_s *p = NULL, *n;
+    cl_json_s *n;
+    struct cdll_head p;
 
     __clib_function_init__(false, NULL, -1, -1);
 
@@ -1297,20 +1298,19 @@ __PUB_API__ int cl_json_replace_item_in_object(cl_json_t *root,
 
     tmp = cl_string_create("%s", name);
 
-    while (a->child) {
-        n = cl_dll_pop(&a->child);
+    cdll_init(&p);
 
+    while ((n = cdll_pop(&a->child)) != NULL) {
         if (cl_string_cmp(n->name, tmp) == 0) {
             cl_json_delete(n);
             n = new_item;
             n->name = tmp;
         }
 
-        p = cl_dll_unshift(p, n);
+        cdll_unshift(&p, n);
     }
 
-    if (p != NULL)
-        a->child = p;
+    cdll_move(&p, &a->child);
 
     return 0;
 }
@@ -1458,7 +1458,7 @@ static char *print_array(cl_json_s *item, int depth, bool fmt)
     char *ptr;
     cl_stringlist_t *sl = NULL;
     cl_string_t *v = NULL;
-    cl_json_s *child = item->child;
+    cl_json_s *child = item->child.first;
 
     sl = cl_stringlist_create();
 
@@ -1534,7 +1534,7 @@ static cl_string_t *output_object(cl_stringlist_t *sl_names,
 static char *print_object(cl_json_s *item, int depth, bool fmt)
 {
     char *ptr;
-    cl_json_s *child = item->child;
+    cl_json_s *child = item->child.first;
     cl_stringlist_t *sl_names = NULL, *sl_values = NULL;
     cl_string_t *v;
 
@@ -29,7 +29,8 @@
 #include "collections.h"
 
 #define cl_stringlist_members              \
-    cl_struct_member(cl_list_t *, data)
+    cl_struct_member(cl_vector_t *, data)   \
+    cl_struct_member(struct cbloom *, bloom)
 
 cl_struct_declare(cl_stringlist_s, cl_stringlist_members);
 
@@ -72,6 +73,37 @@ static int equals_node(cl_list_node_t *a, cl_list_node_t *b)
     return 0;
 }
 
+static uint64_t hash_string(const cl_string_t *s)
+{
+    return string_hash(cl_string_valueof(s));
+}
+
+/*
+ * Builds a new filter holding every string of the list, with room for as
+ * many more. On failure the list is left without a filter.
+ */
+static void bloom_rebuild(cl_stringlist_s *l)
+{
+    cl_list_node_t *node;
+    unsigned int i, size;
+
+    size = cl_vector_size(l->data);
+    cbloom_destroy(l->bloom);
+    l->bloom = cbloom_create((size < 64) ? 128 : size * 2);
+
+    if (NULL == l->bloom)
+        return;
+
+    for (i = 0; i < size; i++) {
+        node = cl_vector_at(l->data, i);
+
+        if (node != NULL) {
+            cbloom_add(l->bloom, hash_string(cl_list_node_content(node)));
+            cl_list_node_unref(node);
+        }
+    }
+}
+
 __PUB_API__ cl_stringlist_t *cl_stringlist_create(void)
 {
     cl_stringlist_s *l = NULL;
@@ -84,8 +116,8 @@ __PUB_API__ cl_stringlist_t *cl_stringlist_create(void)
         return NULL;
     }
 
-    l->data = cl_list_create(release_node, compare_node, filter_node,
-                             equals_node);
+    l->data = cl_vector_create(release_node, compare_node, filter_node,
+                               equals_node);
 
     if (NULL == l->data)
         return NULL;
@@ -101,7 +133,8 @@ __PUB_API__ int cl_stringlist_destroy(cl_stringlist_t *l)
 
     __clib_function_init__(true, l, CL_OBJ_STRINGLIST, -1);
 
-    cl_list_destroy(p->data);
+    cl_vector_destroy(p->data);
+    cbloom_destroy(p->bloom);
     free(l);
 
     return 0;
@@ -113,7 +146,7 @@ __PUB_API__ int cl_stringlist_size(const cl_stringlist_t *l)
 
     __clib_function_init__(true, l, CL_OBJ_STRINGLIST, -1);
 
-    return cl_list_size(p->data);
+    return cl_vector_size(p->data);
 }
 
 __PUB_API__ int cl_stringlist_add(cl_stringlist_t *l, cl_string_t *s)
@@ -128,7 +161,14 @@ __PUB_API__ int cl_stringlist_add(cl_stringlist_t *l, cl_string_t *s)
         return -1;
     }
 
-    cl_list_unshift(p->data, cl_string_ref(s), -1);
+    cl_vector_push(p->data, cl_string_ref(s), -1);
+
+    if (p->bloom != NULL) {
+        cbloom_add(p->bloom, hash_string(s));
+
+        if (cbloom_is_full(p->bloom) == true)
+            bloom_rebuild(p);
+    }
 
     return 0;
 }
@@ -145,7 +185,7 @@ __PUB_API__ cl_string_t *cl_stringlist_get(const cl_stringlist_t *l,
     if (index >= (unsigned int)cl_stringlist_size(p))
         return NULL;
 
-    node = cl_list_at(p->data, index);
+    node = cl_vector_at(p->data, index);
 
     if (NULL == node) {
         cset_errno(CL_OBJECT_NOT_FOUND);
@@ -171,7 +211,7 @@ __PUB_API__ cl_string_t *cl_stringlist_flat(const cl_stringlist_t *l,
     if (NULL == s)
         return NULL;
 
-    size = cl_list_size(p->data);
+    size = cl_vector_size(p->data);
 
     for (i = 0; i < size; i++) {
         node = cl_stringlist_get(l, i);
@@ -202,6 +242,9 @@ __PUB_API__ cl_stringlist_t *cl_stringlist_dup(const cl_stringlist_t *list)
     if (NULL == new)
         return NULL;
 
+    if (((cl_stringlist_s *)list)->bloom != NULL)
+        cl_stringlist_set_bloom_filter(new, true);
+
     for (i = 0; i < t; i++) {
         tmp = cl_stringlist_get(list, i);
         s = cl_string_dup(tmp);
@@ -217,10 +260,19 @@ __PUB_API__ cl_stringlist_t *cl_stringlist_dup(const cl_stringlist_t *list)
 __PUB_API__ bool cl_stringlist_contains(const cl_stringlist_t *list,
     const cl_string_t *needle)
 {
+    cl_stringlist_s *p = (cl_stringlist_s *)list;
     int i, t;
     cl_string_t *s = NULL;
 
     __clib_function_init__(true, list, CL_OBJ_STRINGLIST, false);
+
+    if ((p->bloom != NULL) &&
+        (typeof_validate_object(needle, CL_OBJ_STRING) == true) &&
+        (cbloom_may_contain(p->bloom, hash_string(needle)) == false))
+    {
+        return false;
+    }
+
     t = cl_stringlist_size(list);
 
     for (i = 0; i < t; i++) {
@@ -237,3 +289,25 @@ __PUB_API__ bool cl_stringlist_contains(const cl_stringlist_t *list,
     return false;
 }
 
+__PUB_API__ int cl_stringlist_set_bloom_filter(cl_stringlist_t *list,
+    bool enabled)
+{
+    cl_stringlist_s *p = (cl_stringlist_s *)list;
+
+    __clib_function_init__(true, list, CL_OBJ_STRINGLIST, -1);
+    cbloom_destroy(p->bloom);
+    p->bloom = NULL;
+
+    if (enabled == false)
+        return 0;
+
+    bloom_rebuild(p);
+
+    if (NULL == p->bloom) {
+        cset_errno(CL_NO_MEM);
+        return -1;
+    }
+
+    return 0;
+}
+
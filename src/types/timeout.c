@@ -141,10 +141,13 @@ __PUB_API__ bool cl_timeout_expired(const cl_timeout_t *t)
             break;
 
         case CL_TM_MSECONDS:
-            i = cl_dt_get_mseconds(ct->dt) + ct->interval;
+            l = cl_dt_get_mseconds(ct->dt) + ct->interval;
 
-            if ((unsigned int)((tv.tv_sec * 1000) + (tv.tv_usec / 1000)) > i)
+            if (((unsigned long long)tv.tv_sec * 1000) +
+                (tv.tv_usec / 1000) > l)
+            {
                 return true;
+            }
 
             break;
 